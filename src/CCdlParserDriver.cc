@@ -26,8 +26,67 @@
 
 
 #include "CFixedText.hh"
+#include "gzstream.h"
 
-void yyset_in(FILE * in_str);
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+void yyrestart(FILE * input_file);
+struct yy_buffer_state;
+yy_buffer_state * yy_scan_buffer(char * base, size_t size);
+void yy_delete_buffer(yy_buffer_state * b);
+
+ssize_t ReadGzipCookie(void * theCookie_p, char * theBuffer, size_t theSize) {
+	return ((igzstream *) theCookie_p)->rdbuf()->sgetn(theBuffer, theSize);
+}
+
+int CloseGzipCookie(void * theCookie_p) {
+	delete (igzstream *) theCookie_p;
+	return 0;
+}
+
+FILE * OpenGzipFile(const string theFilename) {
+	//! Read a gzipped netlist through igzstream, which inflates ahead of the scanner on a background thread.
+	igzstream * myGzipFile_p = new igzstream(theFilename);
+	if ( myGzipFile_p->fail() ) {
+		delete myGzipFile_p;
+		return NULL;
+	}
+	cookie_io_functions_t myFunctions = { ReadGzipCookie, NULL, NULL, CloseGzipCookie };
+	FILE * myFile_p = fopencookie(myGzipFile_p, "r", myFunctions);
+	if ( ! myFile_p ) delete myGzipFile_p;
+	return myFile_p;
+}
+
+char * MapCdlFile(const string theFilename, size_t & theSize) {
+	//! Map an uncompressed netlist followed by the 2 null bytes that flex requires at the end of a scan buffer.
+	/*!
+	 * The file is mapped private (copy-on-write) because flex writes null terminators into the buffer.
+	 * An anonymous zero filled region is reserved first so the trailing bytes exist even when the
+	 * file size is a multiple of the page size. Returns NULL if the file cannot be mapped.
+	 */
+	int myCdlFd = open(theFilename.c_str(), O_RDONLY);
+	if ( myCdlFd < 0 ) return NULL;
+	struct stat myCdlStat;
+	if ( fstat(myCdlFd, &myCdlStat) != 0 || ! S_ISREG(myCdlStat.st_mode) || myCdlStat.st_size == 0 ) {
+		close(myCdlFd);
+		return NULL;
+	}
+	theSize = myCdlStat.st_size;
+	void * myBuffer_p = mmap(NULL, theSize + 2, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if ( myBuffer_p != MAP_FAILED
+			&& mmap(myBuffer_p, theSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, myCdlFd, 0) == MAP_FAILED ) {
+		munmap(myBuffer_p, theSize + 2);
+		myBuffer_p = MAP_FAILED;
+	}
+	close(myCdlFd);
+	if ( myBuffer_p == MAP_FAILED ) return NULL;
+	madvise(myBuffer_p, theSize, MADV_SEQUENTIAL);
+	return (char *) myBuffer_p;
+}
 
 
 CCdlParserDriver::CCdlParserDriver() :
@@ -38,15 +97,32 @@ CCdlParserDriver::CCdlParserDriver() :
 CCdlParserDriver::~CCdlParserDriver() {
 }
 
-int CCdlParserDriver::parse(const string &theCdlFilename, CCircuitPtrList& theCircuitPtrList, bool theCvcSOI) {
+int CCdlParserDriver::parse(const string &theCdlFilename, CCircuitPtrList& theCircuitPtrList, bool theCvcSOI, size_t theJobCount) {
 	filename = theCdlFilename;
 	ifstream myTestFile;
+	if ( theJobCount > 1 && filename.substr(filename.length()-3, 3) != ".gz" ) {
+		return ParseParallel(theCircuitPtrList, theCvcSOI, theJobCount);
+	}
 //	scan_begin();
+	if ( filename.substr(filename.length()-3, 3) != ".gz" ) {
+		// scan uncompressed netlists directly from a memory map, without stdio buffering
+		size_t myCdlSize;
+		char * myCdl_p = MapCdlFile(filename, myCdlSize);
+		if ( myCdl_p ) {
+			yy_buffer_state * myScanBuffer_p = yy_scan_buffer(myCdl_p, myCdlSize + 2);
+			yy::CCdlParser parser(*this, theCircuitPtrList, theCvcSOI);
+			cout << endl;  // Clear progress output
+			parser.set_debug_level(trace_parsing);
+			int myParser_result = parser.parse();
+			yy_delete_buffer(myScanBuffer_p);
+			munmap(myCdl_p, myCdlSize + 2);
+			return myParser_result;
+		}
+	}
 	FILE * myCdlFile;
 	if ( filename.substr(filename.length()-3, 3) == ".gz" && (myTestFile.open(filename), myTestFile.good()) ) {
 		myTestFile.close();
-		string myZcat = "zcat " + filename;
-		myCdlFile = popen(myZcat.c_str(), "r");
+		myCdlFile = OpenGzipFile(filename);
 	} else {
 		myCdlFile = fopen(const_cast<const text_t>(filename.c_str()), "r");
 	}
@@ -55,16 +131,126 @@ int CCdlParserDriver::parse(const string &theCdlFilename, CCircuitPtrList& theCi
 		cout << "Could not open file " << filename << "\n";
 		myParser_result = 1;
 	} else {
-		yyset_in(myCdlFile);
+		yyrestart(myCdlFile);
 		yy::CCdlParser parser(*this, theCircuitPtrList, theCvcSOI);
 		cout << endl;  // Clear progress output
 		parser.set_debug_level(trace_parsing);
 		myParser_result = parser.parse();
+		fclose(myCdlFile);
 //	scan_end();
 	}
 	return myParser_result;
 }
 
+size_t NextSubcircuitOffset(const char * theCdl_p, size_t theOffset, size_t theSize) {
+	//! Offset of the first line at or after theOffset that starts with .SUBCKT, or theSize if none.
+	while ( theOffset < theSize ) {
+		if ( theOffset == 0 || theCdl_p[theOffset-1] == '\n' ) {
+			if ( theOffset + 8 <= theSize && strncasecmp(theCdl_p + theOffset, ".SUBCKT", 7) == 0 && isspace(theCdl_p[theOffset+7]) ) return theOffset;
+		}
+		const char * myNextLine_p = (const char *) memchr(theCdl_p + theOffset, '\n', theSize - theOffset);
+		if ( ! myNextLine_p ) break;
+		theOffset = myNextLine_p - theCdl_p + 1;
+	}
+	return theSize;
+}
+
+int CCdlParserDriver::ParseParallel(CCircuitPtrList& theCircuitPtrList, bool theCvcSOI, size_t theJobCount) {
+	/// Split the netlist at .SUBCKT lines, parse each section in a child process and merge the results.
+	///
+	/// The scanner and parser keep global state, so each section is parsed in a forked child
+	/// that saves its circuits as a netlist cache file. The parent appends the files in netlist order,
+	/// so duplicate subcircuit definitions resolve the same as in a serial parse.
+	/// Line numbers in syntax errors are relative to the start of the section.
+	int myCdlFd = open(filename.c_str(), O_RDONLY);
+	if ( myCdlFd < 0 ) {
+		cout << "Could not open file " << filename << "\n";
+		return 1;
+	}
+	struct stat myCdlStat;
+	if ( fstat(myCdlFd, &myCdlStat) != 0 || myCdlStat.st_size == 0 ) {
+		close(myCdlFd);
+		cout << "Could not read file " << filename << "\n";
+		return 1;
+	}
+	size_t myCdlSize = myCdlStat.st_size;
+	char * myCdl_p = (char *) mmap(NULL, myCdlSize, PROT_READ, MAP_PRIVATE, myCdlFd, 0);
+	close(myCdlFd);
+	if ( myCdl_p == MAP_FAILED ) {
+		cout << "Could not map file " << filename << "\n";
+		return 1;
+	}
+	vector<size_t> mySectionStart_v;
+	mySectionStart_v.push_back(0);
+	for ( size_t job_it = 1; job_it < theJobCount; job_it++ ) {
+		size_t myOffset = NextSubcircuitOffset(myCdl_p, max(myCdlSize / theJobCount * job_it, mySectionStart_v.back() + 1), myCdlSize);
+		if ( myOffset >= myCdlSize ) break;
+		mySectionStart_v.push_back(myOffset);
+	}
+	mySectionStart_v.push_back(myCdlSize);
+	size_t mySectionCount = mySectionStart_v.size() - 1;
+	cout << "Parsing " << filename << " in " << mySectionCount << " sections" << endl;
+	const char * myTempDirectory = getenv("TMPDIR");
+	string myTempTemplate = string(myTempDirectory && myTempDirectory[0] ? myTempDirectory : "/tmp") + "/cvcsectionXXXXXX";
+	vector<string> mySectionFilename_v;
+	vector<pid_t> myChild_v;
+	int myParser_result = 0;
+	for ( size_t section_it = 0; section_it < mySectionCount; section_it++ ) {
+		// mkstemp creates the file exclusively, so concurrent runs and forked children never share a name.
+		string mySectionFilename = myTempTemplate;
+		int mySectionFd = mkstemp(&mySectionFilename[0]);
+		if ( mySectionFd < 0 ) {
+			cout << "Could not create temporary file " << myTempTemplate << "\n";
+			myParser_result = 1;
+			break;
+		}
+		close(mySectionFd);
+		mySectionFilename_v.push_back(mySectionFilename);
+		cout << std::flush;
+		pid_t myChild = fork();
+		if ( myChild == 0 ) {
+			int myResult = 1;
+			CCircuitPtrList mySectionList;
+			FILE * mySection_p = fmemopen(myCdl_p + mySectionStart_v[section_it], mySectionStart_v[section_it+1] - mySectionStart_v[section_it], "r");
+			if ( mySection_p ) {
+				try {
+					yyrestart(mySection_p);
+					yy::CCdlParser parser(*this, mySectionList, theCvcSOI);
+					parser.set_debug_level(trace_parsing);
+					myResult = parser.parse();
+					if ( myResult == 0 ) {
+						mySectionList.SaveNetlistCache(mySectionFilename_v.back(), filename, theCvcSOI);
+					}
+				}
+				catch (const exception& myException) {
+					cerr << myException.what() << endl;
+					myResult = 1;
+				}
+			}
+			cout << std::flush;
+			cerr << std::flush;
+			_exit(myResult);
+		}
+		myChild_v.push_back(myChild);
+	}
+	for ( size_t section_it = 0; section_it < myChild_v.size(); section_it++ ) {
+		int myStatus;
+		if ( myChild_v[section_it] < 0 || waitpid(myChild_v[section_it], &myStatus, 0) < 0
+				|| ! WIFEXITED(myStatus) || WEXITSTATUS(myStatus) != 0 ) {
+			myParser_result = 1;
+		}
+	}
+	cout << endl;  // Clear progress output
+	for ( size_t section_it = 0; section_it < mySectionFilename_v.size(); section_it++ ) {
+		if ( myParser_result == 0 && ! theCircuitPtrList.LoadNetlistCache(mySectionFilename_v[section_it], filename, theCvcSOI) ) {
+			myParser_result = 1;
+		}
+		remove(mySectionFilename_v[section_it].c_str());
+	}
+	munmap(myCdl_p, myCdlSize);
+	return myParser_result;
+}
+
 void CCdlParserDriver::error(const yy::location_type& theLocation, const string& theMessage) {
 	cerr << theLocation << ": " << theMessage << endl;
 }
@@ -51,7 +51,9 @@ public:
 
 	// Run the parser on file F.
 	// Return 0 on success.
-	int parse (const string& theCdlFileName, CCircuitPtrList& theCircuitPtrList, bool theCvcSOI);
+	int parse (const string& theCdlFileName, CCircuitPtrList& theCircuitPtrList, bool theCvcSOI, size_t theJobCount = 1);
+	// Parse .SUBCKT aligned sections of an uncompressed file in separate processes.
+	int ParseParallel (CCircuitPtrList& theCircuitPtrList, bool theCvcSOI, size_t theJobCount);
 
 	// The name of the file being parsed.
 	// Used later to pass the file name to the location tracker.
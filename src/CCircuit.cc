@@ -28,10 +28,9 @@ class CCvcDb;
 #include "CFixedText.hh"
 #include "CCvcDb.hh"
 
-text_t CCircuit::lastDeviceMap = NULL;
-CTextDeviceIdMap CCircuit::localDeviceIdMap;
-text_t CCircuit::lastSubcircuitMap = NULL;
-CTextDeviceIdMap CCircuit::localSubcircuitIdMap;
+#include <mutex>
+
+static mutex gLocalIdMapMutex;  // serializes building the name to id maps
 
 void CCircuit::AddPortSignalIds(CTextList * thePortList_p) {
 	for (CTextList::iterator text_pit = thePortList_p->begin(); text_pit != thePortList_p->end(); ++text_pit) {
@@ -62,44 +61,40 @@ void CCircuit::SetSignalIds(CTextList * signalList_p, CNetIdVector& signalId_v )
 }
 
 deviceId_t CCircuit::GetLocalDeviceId(text_t theName) {
-	if ( CCircuit::lastDeviceMap != name ) {
-		CCircuit::localDeviceIdMap.clear();
+	lock_guard<mutex> myLock(gLocalIdMapMutex);
+	if ( ! localDeviceIdMap_p ) {
+		localDeviceIdMap_p.reset(new CTextDeviceIdMap);
 		for ( deviceId_t device_it = 0; device_it < devicePtr_v.size(); device_it++ ) {
-			CCircuit::localDeviceIdMap[devicePtr_v[device_it]->name] = device_it;
+			(*localDeviceIdMap_p)[devicePtr_v[device_it]->name] = device_it;
 		}
-		CCircuit::lastDeviceMap = name;
 	}
-	return (CCircuit::localDeviceIdMap.at(theName));
+	return (localDeviceIdMap_p->at(theName));
 }
 
 deviceId_t CCircuit::GetLocalSubcircuitId(text_t theName) {
-	if ( CCircuit::lastSubcircuitMap != name ) {
-		CCircuit::localSubcircuitIdMap.clear();
+	lock_guard<mutex> myLock(gLocalIdMapMutex);
+	if ( ! localSubcircuitIdMap_p ) {
+		localSubcircuitIdMap_p.reset(new CTextDeviceIdMap);
 		for ( deviceId_t device_it = 0; device_it < subcircuitPtr_v.size(); device_it++ ) {
-			CCircuit::localSubcircuitIdMap[subcircuitPtr_v[device_it]->name] = device_it;
+			(*localSubcircuitIdMap_p)[subcircuitPtr_v[device_it]->name] = device_it;
 		}
-		CCircuit::lastSubcircuitMap = name;
 	}
-	return (CCircuit::localSubcircuitIdMap.at(theName));
+	return (localSubcircuitIdMap_p->at(theName));
 }
 
-void CCircuit::LoadDevices(CDevicePtrList * theDevicePtrList_p) {
+void CCircuit::LoadDevices(CDevicePtrList * theDevicePtrList_p, CLoadProgress & theProgress) {
 	CDevice *	myDevice_p;
 	deviceId_t  myDeviceIndex = 0;
 	deviceId_t  myInstanceIndex = 0;
-	static int myDeviceCount = 0;
-	static int myCircuitCount = 0;
-	static int myInstanceCount = 0;
-	static int myPrintCount = 0;
 
 	devicePtr_v.reserve(theDevicePtrList_p->DeviceCount());
 	deviceErrorCount_v.resize(theDevicePtrList_p->DeviceCount());
 	devicePrintCount_v.resize(theDevicePtrList_p->DeviceCount());
 	subcircuitPtr_v.reserve(theDevicePtrList_p->SubcircuitCount());
-	myCircuitCount++;
-	if ( ++myPrintCount >= 100000 ) {
-		cout << "Read " << myCircuitCount << " circuits, " << myInstanceCount << " instances, " << myDeviceCount << " devices\r" << std::flush;
-		myPrintCount = 0;
+	theProgress.circuitCount++;
+	if ( ++theProgress.printCount >= 100000 ) {
+		cout << "Read " << theProgress.circuitCount << " circuits, " << theProgress.instanceCount << " instances, " << theProgress.deviceCount << " devices\r" << std::flush;
+		theProgress.printCount = 0;
 	}
 	CTextDeviceIdMap myDeviceIdMap;  // temporary map to check for duplicate device/instance names
 	for (CDevicePtrList::iterator device_ppit = theDevicePtrList_p->begin(); device_ppit != theDevicePtrList_p->end(); device_ppit++) {
@@ -114,14 +109,14 @@ void CCircuit::LoadDevices(CDevicePtrList * theDevicePtrList_p) {
 			myDevice_p->offset = myInstanceIndex++;
 			myDeviceIdMap[myDevice_p->name] = subcircuitPtr_v.size();
 			subcircuitPtr_v.push_back(myDevice_p);
-			myInstanceCount++;
-			myPrintCount++;
+			theProgress.instanceCount++;
+			theProgress.printCount++;
 		} else {
 			myDevice_p->offset = myDeviceIndex++;
 			myDeviceIdMap[myDevice_p->name] = devicePtr_v.size();
 			devicePtr_v.push_back(myDevice_p);
-			myDeviceCount++;
-			myPrintCount++;
+			theProgress.deviceCount++;
+			theProgress.printCount++;
 		}
 	}
 	// list to vector conversion (top circuit must be redone to include top ports)
@@ -223,7 +218,10 @@ void CCircuitPtrList::Clear() {
 	for ( auto circuit_ppit = begin(); circuit_ppit != end(); circuit_ppit++ ) {
 		delete (*circuit_ppit);
 	}
+	clear();
+	loadProgress = CLoadProgress();
 	errorCount = 0;
+	warningCount = 0;
 }
 
 void CCircuitPtrList::Print (const string theIndentation, const string theHeading) {
@@ -281,5 +279,6 @@ void CCircuitPtrList::PrintAndResetCircuitErrors(CCvcDb * theCvcDb_p, deviceId_t
  
 void CCircuit::AllocateInstances(CCvcDb * theCvcDb_p, instanceId_t theFirstInstanceId) {
 	instanceId_v.reserve(instanceCount);
-	instanceHashId_v.resize(instanceCount, UNKNOWN_DEVICE);
+	parallelInstanceTable.slot_v.clear();
+	parallelInstanceTable.entries = 0;
 }
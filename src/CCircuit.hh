@@ -32,14 +32,37 @@ class CCvcDb;
 #include "CFixedText.hh"
 #include "gzstream.h"
 
+class CParallelInstanceSlot {
+public:
+	uint32_t	tag = 0;  // upper bits of port signature
+	instanceId_t	instanceId = UNKNOWN_INSTANCE;
+};
+
+class CParallelInstanceTable {
+	// Open addressing table of the instances with unique port nets. Allocated on first use.
+public:
+	vector<CParallelInstanceSlot>	slot_v;
+	size_t	entries = 0;
+};
+
+class CLoadProgress {
+	// running totals for netlist load progress messages
+public:
+	int circuitCount = 0;
+	int instanceCount = 0;
+	int deviceCount = 0;
+	int printCount = 0;
+};
+
 class CCircuit {
-	// subcircuit instance/device name to deviceID map
-	static text_t lastDeviceMap;
-	static CTextDeviceIdMap localDeviceIdMap;
-	static text_t lastSubcircuitMap;
-	static CTextDeviceIdMap localSubcircuitIdMap;
+	// subcircuit instance/device name to deviceID maps. Built on first lookup.
+	unique_ptr<CTextDeviceIdMap> localDeviceIdMap_p;
+	unique_ptr<CTextDeviceIdMap> localSubcircuitIdMap_p;
 public:
 	deviceId_t errorLimit = UNKNOWN_DEVICE;
+	// position in the circuit list and first id of this circuit's devices among the devices of all circuits
+	instanceId_t circuitId = 0;
+	deviceId_t firstCircuitDeviceId = 0;
 	text_t name;
 	// local signal to local netID Map
 	CTextNetIdMap localSignalIdMap;
@@ -52,7 +75,7 @@ public:
 	vector<array<deviceId_t, 5>>	deviceErrorCount_v;
 	vector<array<deviceId_t, 5>>	devicePrintCount_v;
 	CInstanceIdVector instanceId_v;
-	CInstanceIdVector instanceHashId_v;
+	CParallelInstanceTable parallelInstanceTable;
 
 	netId_t	portCount = 0;
 	// total items for this circuit and all subcircuits
@@ -74,7 +97,7 @@ public:
 	void SetSignalIds(CTextList * theSignalList_p, CNetIdVector & theSignalId_v);
 	deviceId_t GetLocalDeviceId(text_t theName);
 	deviceId_t GetLocalSubcircuitId(text_t theName);
-	void LoadDevices(CDevicePtrList * theDeviceList_p);
+	void LoadDevices(CDevicePtrList * theDeviceList_p, CLoadProgress & theProgress);
 
 	void CountObjectsAndLinkSubcircuits(unordered_map<text_t, CCircuit *> & theCircuitNameMap);
 	void CountInstantiations();
@@ -99,9 +122,12 @@ public:
 	CFixedText	parameterText;
 	int			errorCount = 0;
 	int			warningCount = 0;
+	CLoadProgress	loadProgress;
 //	CCircuitPtrList();
 //	CCircuitPtrList(int count, CDevice new_instance);
 	void Clear();
+	bool LoadNetlistCache(const string theCacheFilename, const string theNetlistFilename, bool theCvcSOI);
+	void SaveNetlistCache(const string theCacheFilename, const string theNetlistFilename, bool theCvcSOI);
 
 	void Print(const string theIndentation = "", const string theHeading = "CircuitList>");
 //	void CreateDatabase(const string theTopBlockName);
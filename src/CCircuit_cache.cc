@@ -0,0 +1,283 @@
+/*
+ * CCircuit_cache.cc
+ *
+ * Copyright 2014-2026 D. Mitch Bailey  cvc at shuharisystem dot com
+ *
+ * This file is part of cvc.
+ *
+ * cvc is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cvc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with cvc.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * You can download cvc from https://github.com/d-m-bailey/cvc.git
+ */
+
+#include "CCircuit.hh"
+
+#include "CDevice.hh"
+#include "CFixedText.hh"
+#include "CCvcExceptions.hh"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+/// \file
+/// Binary netlist cache: saves the parsed circuit list so later runs can skip CDL parsing.
+/// The cache is only used when the netlist path, size, modification time, SOI setting and cvc version match.
+
+#define NETLIST_CACHE_MAGIC "CVCNETLISTCACHE"
+#define NETLIST_CACHE_FORMAT 2
+#define NO_TEXT UINT32_MAX
+#define BLANK_TEXT 0
+
+typedef unordered_map<text_t, uint32_t> CTextIndexMap;
+
+template <typename T> void WriteCacheValue(ofstream & theCacheFile, T theValue) {
+	theCacheFile.write((const char *) &theValue, sizeof(T));
+}
+
+void WriteCacheString(ofstream & theCacheFile, const string theString) {
+	WriteCacheValue<uint32_t>(theCacheFile, theString.length());
+	theCacheFile.write(theString.c_str(), theString.length());
+}
+
+template <typename T> T ReadCacheValue(const char * & theCache_p, const char * theCacheEnd_p) {
+	T myValue;
+	if ( theCache_p + sizeof(T) > theCacheEnd_p ) throw EDatabaseError("netlist cache truncated");
+	memcpy(&myValue, theCache_p, sizeof(T));
+	theCache_p += sizeof(T);
+	return myValue;
+}
+
+string ReadCacheString(const char * & theCache_p, const char * theCacheEnd_p) {
+	uint32_t myLength = ReadCacheValue<uint32_t>(theCache_p, theCacheEnd_p);
+	if ( theCache_p + myLength > theCacheEnd_p ) throw EDatabaseError("netlist cache truncated");
+	string myString(theCache_p, myLength);
+	theCache_p += myLength;
+	return myString;
+}
+
+void WriteCacheText(ofstream & theCacheFile, CFixedText & theText, CTextIndexMap & theIndexMap) {
+	//! Write the text pool and record the index of each address. Index 0 is the blank text.
+	theIndexMap.clear();
+	theIndexMap.reserve(theText.Entries() + 1);
+	theIndexMap[theText.BlankTextAddress()] = BLANK_TEXT;
+	WriteCacheValue<uint32_t>(theCacheFile, theText.Entries());
+	uint32_t myIndex = BLANK_TEXT + 1;
+	for ( auto entry_pit = theText.TextIndex().begin(); entry_pit != theText.TextIndex().end(); entry_pit++ ) {
+		if ( ! entry_pit->text ) continue;
+		WriteCacheValue<uint32_t>(theCacheFile, entry_pit->length);
+		theCacheFile.write(entry_pit->text, entry_pit->length);
+		theIndexMap[entry_pit->text] = myIndex++;
+	}
+}
+
+void ReadCacheText(const char * & theCache_p, const char * theCacheEnd_p, CFixedText & theText, CTextVector & theAddress_v) {
+	uint32_t myCount = ReadCacheValue<uint32_t>(theCache_p, theCacheEnd_p);
+	theAddress_v.clear();
+	theAddress_v.reserve(myCount + 1);
+	theAddress_v.push_back(theText.BlankTextAddress());
+	for ( uint32_t text_it = 0; text_it < myCount; text_it++ ) {
+		uint32_t myLength = ReadCacheValue<uint32_t>(theCache_p, theCacheEnd_p);
+		if ( theCache_p + myLength > theCacheEnd_p ) throw EDatabaseError("netlist cache truncated");
+		theAddress_v.push_back(theText.SetTextAddress(theCache_p, myLength));
+		theCache_p += myLength;
+	}
+}
+
+uint32_t TextIndex(CTextIndexMap & theIndexMap, text_t theText) {
+	if ( theText == NULL ) return NO_TEXT;
+	try {
+		return theIndexMap.at(theText);
+	}
+	catch (const out_of_range& oor_exception) {
+		throw EDatabaseError("text not in cache pool: " + string(theText));
+	}
+}
+
+text_t TextAddress(CTextVector & theAddress_v, uint32_t theIndex) {
+	if ( theIndex == NO_TEXT ) return NULL;
+	if ( theIndex >= theAddress_v.size() ) throw EDatabaseError("invalid text index in netlist cache");
+	return theAddress_v[theIndex];
+}
+
+bool NetlistStatus(const string theNetlistFilename, int64_t & theModifiedTime, int64_t & theSize) {
+	struct stat myStat;
+	if ( stat(theNetlistFilename.c_str(), &myStat) != 0 ) return false;
+	theModifiedTime = myStat.st_mtime;
+	theSize = myStat.st_size;
+	return true;
+}
+
+bool CCircuitPtrList::LoadNetlistCache(const string theCacheFilename, const string theNetlistFilename, bool theCvcSOI) {
+	//! Append circuits from a netlist cache. Returns false if the cache is missing, stale or unreadable.
+	int64_t myModifiedTime, mySize;
+	if ( ! NetlistStatus(theNetlistFilename, myModifiedTime, mySize) ) return false;
+	int myCacheFd = open(theCacheFilename.c_str(), O_RDONLY);
+	if ( myCacheFd < 0 ) return false;
+	struct stat myCacheStat;
+	if ( fstat(myCacheFd, &myCacheStat) != 0 || myCacheStat.st_size == 0 ) {
+		close(myCacheFd);
+		return false;
+	}
+	size_t myCacheSize = myCacheStat.st_size;
+	void * myMap_p = mmap(NULL, myCacheSize, PROT_READ, MAP_PRIVATE, myCacheFd, 0);
+	close(myCacheFd);
+	if ( myMap_p == MAP_FAILED ) return false;
+	madvise(myMap_p, myCacheSize, MADV_SEQUENTIAL);
+	const char * myCache_p = (const char *) myMap_p;
+	const char * myCacheEnd_p = myCache_p + myCacheSize;
+	bool myLoaded = false;
+	try {
+		if ( ReadCacheString(myCache_p, myCacheEnd_p) != NETLIST_CACHE_MAGIC
+				|| ReadCacheValue<uint32_t>(myCache_p, myCacheEnd_p) != NETLIST_CACHE_FORMAT
+				|| ReadCacheString(myCache_p, myCacheEnd_p) != CVC_VERSION
+				|| ReadCacheString(myCache_p, myCacheEnd_p) != theNetlistFilename
+				|| ReadCacheValue<int64_t>(myCache_p, myCacheEnd_p) != myModifiedTime
+				|| ReadCacheValue<int64_t>(myCache_p, myCacheEnd_p) != mySize
+				|| ReadCacheValue<uint8_t>(myCache_p, myCacheEnd_p) != theCvcSOI ) {
+			throw EDatabaseError("stale netlist cache");
+		}
+		CTextVector myCdlAddress_v, myParameterAddress_v;
+		ReadCacheText(myCache_p, myCacheEnd_p, cdlText, myCdlAddress_v);
+		ReadCacheText(myCache_p, myCacheEnd_p, parameterText, myParameterAddress_v);
+		errorCount += ReadCacheValue<int32_t>(myCache_p, myCacheEnd_p);
+		warningCount += ReadCacheValue<int32_t>(myCache_p, myCacheEnd_p);
+		uint32_t myCircuitCount = ReadCacheValue<uint32_t>(myCache_p, myCacheEnd_p);
+		for ( uint32_t circuit_it = 0; circuit_it < myCircuitCount; circuit_it++ ) {
+			CCircuit * myCircuit_p = new CCircuit();
+			push_back(myCircuit_p);
+			myCircuit_p->name = TextAddress(myCdlAddress_v, ReadCacheValue<uint32_t>(myCache_p, myCacheEnd_p));
+			circuitNameMap[myCircuit_p->name] = myCircuit_p;
+			myCircuit_p->portCount = ReadCacheValue<netId_t>(myCache_p, myCacheEnd_p);
+			netId_t mySignalCount = ReadCacheValue<netId_t>(myCache_p, myCacheEnd_p);
+			myCircuit_p->localSignalIdMap.reserve(mySignalCount);
+			for ( netId_t net_it = 0; net_it < mySignalCount; net_it++ ) {
+				myCircuit_p->localSignalIdMap[TextAddress(myCdlAddress_v, ReadCacheValue<uint32_t>(myCache_p, myCacheEnd_p))] = net_it;
+			}
+			netId_t myInternalCount = ReadCacheValue<netId_t>(myCache_p, myCacheEnd_p);
+			myCircuit_p->internalSignal_v.reserve(myInternalCount);
+			for ( netId_t net_it = 0; net_it < myInternalCount; net_it++ ) {
+				myCircuit_p->internalSignal_v.push_back(TextAddress(myCdlAddress_v, ReadCacheValue<uint32_t>(myCache_p, myCacheEnd_p)));
+			}
+			deviceId_t myDeviceCount = ReadCacheValue<deviceId_t>(myCache_p, myCacheEnd_p);
+			deviceId_t mySubcircuitCount = ReadCacheValue<deviceId_t>(myCache_p, myCacheEnd_p);
+			myCircuit_p->devicePtr_v.reserve(myDeviceCount);
+			myCircuit_p->deviceErrorCount_v.resize(myDeviceCount);
+			myCircuit_p->devicePrintCount_v.resize(myDeviceCount);
+			myCircuit_p->subcircuitPtr_v.reserve(mySubcircuitCount);
+			for ( deviceId_t device_it = 0; device_it < myDeviceCount + mySubcircuitCount; device_it++ ) {
+				CDevice * myDevice_p = new CDevice();
+				bool myIsSubcircuit = ( device_it >= myDeviceCount );
+				myDevice_p->parent_p = myCircuit_p;
+				myDevice_p->name = TextAddress(myCdlAddress_v, ReadCacheValue<uint32_t>(myCache_p, myCacheEnd_p));
+				myDevice_p->parameters = TextAddress(myParameterAddress_v, ReadCacheValue<uint32_t>(myCache_p, myCacheEnd_p));
+				if ( myIsSubcircuit ) {
+					myDevice_p->masterName = TextAddress(myCdlAddress_v, ReadCacheValue<uint32_t>(myCache_p, myCacheEnd_p));
+					myDevice_p->offset = myCircuit_p->subcircuitPtr_v.size();
+					myCircuit_p->subcircuitPtr_v.push_back(myDevice_p);
+				} else {
+					myDevice_p->sourceDrainSet = ReadCacheValue<uint8_t>(myCache_p, myCacheEnd_p);
+					myDevice_p->sourceDrainSwapOk = ReadCacheValue<uint8_t>(myCache_p, myCacheEnd_p);
+					myDevice_p->offset = myCircuit_p->devicePtr_v.size();
+					myCircuit_p->devicePtr_v.push_back(myDevice_p);
+				}
+				netId_t myTerminalCount = ReadCacheValue<netId_t>(myCache_p, myCacheEnd_p);
+				if ( myCache_p + myTerminalCount * sizeof(netId_t) > myCacheEnd_p ) throw EDatabaseError("netlist cache truncated");
+				myDevice_p->signalId_v.resize(myTerminalCount);
+				memcpy(myDevice_p->signalId_v.data(), myCache_p, myTerminalCount * sizeof(netId_t));
+				myCache_p += myTerminalCount * sizeof(netId_t);
+			}
+		}
+		if ( myCache_p != myCacheEnd_p ) throw EDatabaseError("extra data in netlist cache");
+		myLoaded = true;
+	}
+	catch (const EDatabaseError& myException) {
+		cout << "INFO: Ignoring netlist cache " << theCacheFilename << ": " << myException.errorMessage << endl;
+		Clear();
+	}
+	munmap(myMap_p, myCacheSize);
+	return myLoaded;
+}
+
+void CCircuitPtrList::SaveNetlistCache(const string theCacheFilename, const string theNetlistFilename, bool theCvcSOI) {
+	//! Save parsed circuits to a netlist cache. Errors are reported but not fatal.
+	int64_t myModifiedTime, mySize;
+	if ( ! NetlistStatus(theNetlistFilename, myModifiedTime, mySize) ) return;
+	string myTemporaryFilename = theCacheFilename + ".tmp";
+	ofstream myCacheFile(myTemporaryFilename, ios::binary | ios::trunc);
+	if ( myCacheFile.fail() ) {
+		cout << "WARNING: Could not open netlist cache " << theCacheFilename << endl;
+		return;
+	}
+	try {
+		WriteCacheString(myCacheFile, NETLIST_CACHE_MAGIC);
+		WriteCacheValue<uint32_t>(myCacheFile, NETLIST_CACHE_FORMAT);
+		WriteCacheString(myCacheFile, CVC_VERSION);
+		WriteCacheString(myCacheFile, theNetlistFilename);
+		WriteCacheValue<int64_t>(myCacheFile, myModifiedTime);
+		WriteCacheValue<int64_t>(myCacheFile, mySize);
+		WriteCacheValue<uint8_t>(myCacheFile, theCvcSOI);
+		CTextIndexMap myCdlIndexMap, myParameterIndexMap;
+		WriteCacheText(myCacheFile, cdlText, myCdlIndexMap);
+		WriteCacheText(myCacheFile, parameterText, myParameterIndexMap);
+		WriteCacheValue<int32_t>(myCacheFile, errorCount);
+		WriteCacheValue<int32_t>(myCacheFile, warningCount);
+		WriteCacheValue<uint32_t>(myCacheFile, size());
+		CTextVector mySignal_v;
+		for ( auto circuit_ppit = begin(); circuit_ppit != end(); circuit_ppit++ ) {
+			CCircuit * myCircuit_p = *circuit_ppit;
+			WriteCacheValue<uint32_t>(myCacheFile, TextIndex(myCdlIndexMap, myCircuit_p->name));
+			WriteCacheValue<netId_t>(myCacheFile, myCircuit_p->portCount);
+			mySignal_v.clear();
+			mySignal_v.resize(myCircuit_p->localSignalIdMap.size());
+			for ( auto textNetIdPair_pit = myCircuit_p->localSignalIdMap.begin(); textNetIdPair_pit != myCircuit_p->localSignalIdMap.end(); textNetIdPair_pit++ ) {
+				mySignal_v[textNetIdPair_pit->second] = textNetIdPair_pit->first;
+			}
+			WriteCacheValue<netId_t>(myCacheFile, mySignal_v.size());
+			for ( auto signal_pit = mySignal_v.begin(); signal_pit != mySignal_v.end(); signal_pit++ ) {
+				WriteCacheValue<uint32_t>(myCacheFile, TextIndex(myCdlIndexMap, *signal_pit));
+			}
+			WriteCacheValue<netId_t>(myCacheFile, myCircuit_p->internalSignal_v.size());
+			for ( auto signal_pit = myCircuit_p->internalSignal_v.begin(); signal_pit != myCircuit_p->internalSignal_v.end(); signal_pit++ ) {
+				WriteCacheValue<uint32_t>(myCacheFile, TextIndex(myCdlIndexMap, *signal_pit));
+			}
+			WriteCacheValue<deviceId_t>(myCacheFile, myCircuit_p->devicePtr_v.size());
+			WriteCacheValue<deviceId_t>(myCacheFile, myCircuit_p->subcircuitPtr_v.size());
+			for ( auto device_ppit = myCircuit_p->devicePtr_v.begin(); device_ppit != myCircuit_p->devicePtr_v.end(); device_ppit++ ) {
+				WriteCacheValue<uint32_t>(myCacheFile, TextIndex(myCdlIndexMap, (*device_ppit)->name));
+				WriteCacheValue<uint32_t>(myCacheFile, TextIndex(myParameterIndexMap, (*device_ppit)->parameters));
+				WriteCacheValue<uint8_t>(myCacheFile, (*device_ppit)->sourceDrainSet);
+				WriteCacheValue<uint8_t>(myCacheFile, (*device_ppit)->sourceDrainSwapOk);
+				WriteCacheValue<netId_t>(myCacheFile, (*device_ppit)->signalId_v.size());
+				myCacheFile.write((const char *) (*device_ppit)->signalId_v.data(), (*device_ppit)->signalId_v.size() * sizeof(netId_t));
+			}
+			for ( auto subcircuit_ppit = myCircuit_p->subcircuitPtr_v.begin(); subcircuit_ppit != myCircuit_p->subcircuitPtr_v.end(); subcircuit_ppit++ ) {
+				WriteCacheValue<uint32_t>(myCacheFile, TextIndex(myCdlIndexMap, (*subcircuit_ppit)->name));
+				WriteCacheValue<uint32_t>(myCacheFile, TextIndex(myParameterIndexMap, (*subcircuit_ppit)->parameters));
+				WriteCacheValue<uint32_t>(myCacheFile, TextIndex(myCdlIndexMap, (*subcircuit_ppit)->masterName));
+				WriteCacheValue<netId_t>(myCacheFile, (*subcircuit_ppit)->signalId_v.size());
+				myCacheFile.write((const char *) (*subcircuit_ppit)->signalId_v.data(), (*subcircuit_ppit)->signalId_v.size() * sizeof(netId_t));
+			}
+		}
+		myCacheFile.close();
+		if ( myCacheFile.fail() ) throw EDatabaseError("write failed");
+		if ( rename(myTemporaryFilename.c_str(), theCacheFilename.c_str()) != 0 ) throw EDatabaseError("could not rename " + myTemporaryFilename);
+	}
+	catch (const EDatabaseError& myException) {
+		cout << "WARNING: Could not save netlist cache " << theCacheFilename << ": " << myException.errorMessage << endl;
+		myCacheFile.close();
+		::remove(myTemporaryFilename.c_str());
+	}
+}
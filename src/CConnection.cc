@@ -353,8 +353,9 @@ void CFullConnection::SetMinMaxLeakVoltagesAndFlags(CCvcDb * theCvcDb) {
 }
 
 void AddConnectedDevices(netId_t theNetId, list<deviceId_t>& myPmosToCheck,	list<deviceId_t>& myNmosToCheck,
-		list<deviceId_t>& myResistorToCheck, CDeviceIdVector& theFirstDevice_v, CDeviceIdVector& theNextDevice_v, vector<modelType_t>& theDeviceType_v ) {
-		for ( deviceId_t device_it = theFirstDevice_v[theNetId]; device_it != UNKNOWN_DEVICE; device_it = theNextDevice_v[device_it] ) {
+		list<deviceId_t>& myResistorToCheck, CDeviceIdAdjacency& theAdjacency, vector<modelType_t>& theDeviceType_v ) {
+		for ( auto device_pit = theAdjacency.begin(theNetId); device_pit != theAdjacency.end(theNetId); device_pit++ ) {
+			deviceId_t device_it = *device_pit;
 //			if ( theCheckedDevices.count(device_it) == 0 ) {
 //				theCheckedDevices.insert(device_it);
 				switch (theDeviceType_v[device_it]) {
@@ -385,24 +386,24 @@ bool CFullConnection::IsPossibleHiZ(CCvcDb * theCvcDb) {
 	if ( theCvcDb->connectionCount_v[this->gateId].SourceDrainCount() > myCheckLimit ) return(false);
 	if ( theCvcDb->netVoltagePtr_v[gateId].full && theCvcDb->netVoltagePtr_v[gateId].full->type[INPUT_BIT] ) return(false);  // input ports not possible Hi-Z
 	myNetsToCheck.push_back(this->gateId);
-	AddConnectedDevices(this->gateId, myPmosToCheck, myNmosToCheck, myResistorToCheck, theCvcDb->firstSource_v, theCvcDb->nextSource_v, theCvcDb->deviceType_v);
-	AddConnectedDevices(this->gateId, myPmosToCheck, myNmosToCheck, myResistorToCheck, theCvcDb->firstDrain_v, theCvcDb->nextDrain_v, theCvcDb->deviceType_v);
+	AddConnectedDevices(this->gateId, myPmosToCheck, myNmosToCheck, myResistorToCheck, theCvcDb->sourceAdjacency, theCvcDb->deviceType_v);
+	AddConnectedDevices(this->gateId, myPmosToCheck, myNmosToCheck, myResistorToCheck, theCvcDb->drainAdjacency, theCvcDb->deviceType_v);
 	if ( myResistorToCheck.size() > 0 || myNmosToCheck.size() != 1 || myPmosToCheck.size() != 1 ) return(false);
 	if ( theCvcDb->minNet_v[gateId].nextNetId == theCvcDb->maxNet_v[gateId].nextNetId ) {  // transfer gates
 		return IsTransferGate(myNmosToCheck.front(), myPmosToCheck.front(), theCvcDb);
 	} 
 	// check clocked inverters
-	for ( netId_t net_it = theCvcDb->maxNet_v[this->gateId].nextNetId; net_it != theCvcDb->maxNet_v[this->gateId].finalNetId; net_it = theCvcDb->maxNet_v[net_it].nextNetId ) {
+	for ( netId_t net_it = theCvcDb->maxNet_v[this->gateId].nextNetId; net_it != theCvcDb->maxNet_v.FinalNetId(this->gateId); net_it = theCvcDb->maxNet_v[net_it].nextNetId ) {
 		CConnectionCount myCounts = theCvcDb->connectionCount_v[net_it];
 		if ( myCounts.SourceDrainCount() != 2 || myCounts.sourceDrainType != PMOS_ONLY ) return false;
-		AddConnectedDevices(net_it, myPmosToCheck, myNmosToCheck, myResistorToCheck, theCvcDb->firstSource_v, theCvcDb->nextSource_v, theCvcDb->deviceType_v);
-		AddConnectedDevices(net_it, myPmosToCheck, myNmosToCheck, myResistorToCheck, theCvcDb->firstDrain_v, theCvcDb->nextDrain_v, theCvcDb->deviceType_v);
+		AddConnectedDevices(net_it, myPmosToCheck, myNmosToCheck, myResistorToCheck, theCvcDb->sourceAdjacency, theCvcDb->deviceType_v);
+		AddConnectedDevices(net_it, myPmosToCheck, myNmosToCheck, myResistorToCheck, theCvcDb->drainAdjacency, theCvcDb->deviceType_v);
 	}
-	for ( netId_t net_it = theCvcDb->minNet_v[this->gateId].nextNetId; net_it != theCvcDb->minNet_v[this->gateId].finalNetId; net_it = theCvcDb->minNet_v[net_it].nextNetId ) {
+	for ( netId_t net_it = theCvcDb->minNet_v[this->gateId].nextNetId; net_it != theCvcDb->minNet_v.FinalNetId(this->gateId); net_it = theCvcDb->minNet_v[net_it].nextNetId ) {
 		CConnectionCount myCounts = theCvcDb->connectionCount_v[net_it];
 		if ( myCounts.SourceDrainCount() != 2 || myCounts.sourceDrainType != NMOS_ONLY ) return false;
-		AddConnectedDevices(net_it, myPmosToCheck, myNmosToCheck, myResistorToCheck, theCvcDb->firstSource_v, theCvcDb->nextSource_v, theCvcDb->deviceType_v);
-		AddConnectedDevices(net_it, myPmosToCheck, myNmosToCheck, myResistorToCheck, theCvcDb->firstDrain_v, theCvcDb->nextDrain_v, theCvcDb->deviceType_v);
+		AddConnectedDevices(net_it, myPmosToCheck, myNmosToCheck, myResistorToCheck, theCvcDb->sourceAdjacency, theCvcDb->deviceType_v);
+		AddConnectedDevices(net_it, myPmosToCheck, myNmosToCheck, myResistorToCheck, theCvcDb->drainAdjacency, theCvcDb->deviceType_v);
 	}
 	netId_t myGateNet;
 	if ( myDebug ) {
@@ -459,7 +460,8 @@ bool CFullConnection::HasParallelShort(CCvcDb * theCvcDb) {
 	modelType_t myModelType = device_p->model_p->type;
 	assert( IsMos_(myModelType) );
 	myModelType = IsNmos_(myModelType) ? NMOS : PMOS;
-	for ( auto device_it = theCvcDb->firstSource_v[myDrainId]; device_it != UNKNOWN_DEVICE; device_it = theCvcDb->nextSource_v[device_it] ) {
+	for ( auto device_pit = theCvcDb->sourceAdjacency.begin(myDrainId); device_pit != theCvcDb->sourceAdjacency.end(myDrainId); device_pit++ ) {
+		deviceId_t device_it = *device_pit;
 		if ( device_it == deviceId ) continue;  // same device
 		if ( myModelType == NMOS && ! IsNmos_(theCvcDb->deviceType_v[device_it] )) continue;  // skip non-matching device types
 		if ( myModelType == PMOS && ! IsPmos_(theCvcDb->deviceType_v[device_it] )) continue;  // skip non-matching device types
@@ -473,7 +475,8 @@ bool CFullConnection::HasParallelShort(CCvcDb * theCvcDb) {
 			return true;
 		}
 	}
-	for ( auto device_it = theCvcDb->firstDrain_v[myDrainId]; device_it != UNKNOWN_DEVICE; device_it = theCvcDb->nextDrain_v[device_it] ) {
+	for ( auto device_pit = theCvcDb->drainAdjacency.begin(myDrainId); device_pit != theCvcDb->drainAdjacency.end(myDrainId); device_pit++ ) {
+		deviceId_t device_it = *device_pit;
 		if ( device_it == deviceId ) continue;  // same device
 		if ( myModelType == NMOS && ! IsNmos_(theCvcDb->deviceType_v[device_it] )) continue;  // skip non-matching device types
 		if ( myModelType == PMOS && ! IsPmos_(theCvcDb->deviceType_v[device_it] )) continue;  // skip non-matching device types
@@ -29,6 +29,7 @@
 #include "CVirtualNet.hh"
 #include "CPower.hh"
 #include "CDevice.hh"
+#include "CDeviceIdAdjacency.hh"
 
 class CConnection {
 public:
@@ -61,7 +62,7 @@ public:
 };
 
 void AddConnectedDevices(netId_t theNetId, list<deviceId_t>& myPmosToCheck,	list<deviceId_t>& myNmosToCheck,
-		list<deviceId_t>& myResistorToCheck, CDeviceIdVector& theFirstDevice_v, CDeviceIdVector& theNextDevice_v, vector<modelType_t>& theDeviceType_v );
+		list<deviceId_t>& myResistorToCheck, CDeviceIdAdjacency& theAdjacency, vector<modelType_t>& theDeviceType_v );
 
 class CFullConnection {
 public:
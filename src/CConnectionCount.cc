@@ -28,7 +28,8 @@
 CDeviceCount::CDeviceCount(netId_t theNetId, CCvcDb * theCvcDb_p, instanceId_t theInstanceId) {
 // count devices attached to theNet
 	netId = theNetId;
-	for ( auto device_it = theCvcDb_p->firstSource_v[theNetId]; device_it != UNKNOWN_DEVICE; device_it = theCvcDb_p->nextSource_v[device_it] ) {
+	for ( auto device_pit = theCvcDb_p->sourceAdjacency.begin(theNetId); device_pit != theCvcDb_p->sourceAdjacency.end(theNetId); device_pit++ ) {
+		deviceId_t device_it = *device_pit;
 		if ( theCvcDb_p->IsSubcircuitOf(theCvcDb_p->deviceParent_v[device_it], theInstanceId) ) {
 			switch( theCvcDb_p->deviceType_v[device_it] ) {
 			case NMOS:
@@ -54,7 +55,8 @@ CDeviceCount::CDeviceCount(netId_t theNetId, CCvcDb * theCvcDb_p, instanceId_t t
 			}
 		}
 	}
-	for ( auto device_it = theCvcDb_p->firstDrain_v[theNetId]; device_it != UNKNOWN_DEVICE; device_it = theCvcDb_p->nextDrain_v[device_it] ) {
+	for ( auto device_pit = theCvcDb_p->drainAdjacency.begin(theNetId); device_pit != theCvcDb_p->drainAdjacency.end(theNetId); device_pit++ ) {
+		deviceId_t device_it = *device_pit;
 		if ( theCvcDb_p->IsSubcircuitOf(theCvcDb_p->deviceParent_v[device_it], theInstanceId) ) {
 			if ( theCvcDb_p->equivalentNet_v[theCvcDb_p->sourceNet_v[device_it]] != theCvcDb_p->equivalentNet_v[theCvcDb_p->drainNet_v[device_it]] ) {
 				// only count devices with source != drain (avoid double count)
@@ -83,7 +85,8 @@ CDeviceCount::CDeviceCount(netId_t theNetId, CCvcDb * theCvcDb_p, instanceId_t t
 			}
 		}
 	}
-	for ( auto device_it = theCvcDb_p->firstGate_v[theNetId]; device_it != UNKNOWN_DEVICE; device_it = theCvcDb_p->nextGate_v[device_it] ) {
+	for ( auto device_pit = theCvcDb_p->gateAdjacency.begin(theNetId); device_pit != theCvcDb_p->gateAdjacency.end(theNetId); device_pit++ ) {
+		deviceId_t device_it = *device_pit;
 		if ( theCvcDb_p->IsSubcircuitOf(theCvcDb_p->deviceParent_v[device_it], theInstanceId) ) {
 			if ( theCvcDb_p->equivalentNet_v[theCvcDb_p->sourceNet_v[device_it]] != theCvcDb_p->equivalentNet_v[theCvcDb_p->drainNet_v[device_it]] ) {
 				// does not count mos capacitors
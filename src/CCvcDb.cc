@@ -43,7 +43,7 @@ char RESISTOR_TEXT[] = " resistor";  // leading space to differentiate from norm
  * Note: if the propagated voltage and limited voltage differ by exactly Vth, the short is ignored. This is the expected result of mos diodes.
  */
 void CCvcDb::ReportSimShort(deviceId_t theDeviceId, voltage_t theMainVoltage, voltage_t theShortVoltage, string theCalculation) {
-	static CFullConnection myConnections;
+	CFullConnection myConnections;
 	MapDeviceNets(theDeviceId, myConnections);
 	voltage_t myMaxVoltage = max(theMainVoltage, theShortVoltage);
 	voltage_t myMinVoltage = min(theMainVoltage, theShortVoltage);
@@ -51,6 +51,7 @@ void CCvcDb::ReportSimShort(deviceId_t theDeviceId, voltage_t theMainVoltage, vo
 			abs(theMainVoltage - theShortVoltage) > cvcParameters.cvcShortErrorThreshold ) {
 		if ( IncrementDeviceError(theDeviceId, LEAK) < cvcParameters.cvcCircuitErrorLimit || cvcParameters.cvcCircuitErrorLimit == 0 ) {
 			errorFile << "! Short Detected: " << PrintVoltage(myMaxVoltage) << " to " << PrintVoltage(myMinVoltage) << theCalculation << endl;
+			RecordError(LEAK, deviceParent_v[theDeviceId], myConnections);
 			PrintDeviceWithAllConnections(deviceParent_v[theDeviceId], myConnections, errorFile);
 			errorFile << endl;
 		}
@@ -69,7 +70,7 @@ void CCvcDb::ReportSimShort(deviceId_t theDeviceId, voltage_t theMainVoltage, vo
  * Note: leaks between external power are always errors if threshold = 0.
  */
 void CCvcDb::ReportShort(deviceId_t theDeviceId) {
-	static CFullConnection myConnections;
+	CFullConnection myConnections;
 	MapDeviceNets(theDeviceId, myConnections);
 	voltage_t myMaxVoltage = max(myConnections.simSourceVoltage, myConnections.simDrainVoltage);
 	voltage_t myMinVoltage = min(myConnections.simSourceVoltage, myConnections.simDrainVoltage);
@@ -105,6 +106,7 @@ void CCvcDb::ReportShort(deviceId_t theDeviceId) {
 			if ( myUnrelatedFlag ) {
 				errorFile << "Unrelated power error" << endl;
 			}
+			RecordError(LEAK, deviceParent_v[theDeviceId], myConnections);
 			PrintDeviceWithAllConnections(deviceParent_v[theDeviceId], myConnections, errorFile);
 			errorFile << endl;
 		}
@@ -160,7 +162,7 @@ bool CCvcDb::IsPriorityDevice(CEventQueue& theEventQueue, modelType_t theModel)
 
 void CCvcDb::AlreadyShorted(CEventQueue& theEventQueue, deviceId_t theDeviceId, CConnection& theConnections) {
 	// add logic for equivalent voltage shorts.
-	static CVirtualNet myLastVirtualNet;
+	CVirtualNet myLastVirtualNet;
 	if ( theConnections.masterSourceNet.finalNetId == theConnections.masterDrainNet.finalNetId ) {
 		// no shifting on second pass causes looping. Only reroute direct connections.
 		if ( IsPriorityDevice(theEventQueue, deviceType_v[theConnections.deviceId]) ) {
@@ -238,7 +240,7 @@ void CCvcDb::AlreadyShorted(CEventQueue& theEventQueue, deviceId_t theDeviceId,
 						if ( ! myPower_p->extraData ) myPower_p->extraData = new CExtraPowerData;
 						myPower_p->extraData->pullDownVoltage = theConnections.drainVoltage;
 						theEventQueue.virtualNet_v.Set(theConnections.sourceId, theConnections.drainId, theConnections.resistance, ++theEventQueue.virtualNet_v.lastUpdate);
-						CheckResistorOverflow_(theEventQueue.virtualNet_v[theConnections.sourceId].finalResistance, theConnections.sourceId, logFile);
+						CheckResistorOverflow_(theEventQueue.virtualNet_v.FinalResistance(theConnections.sourceId), theConnections.sourceId, logFile);
 						if ( theConnections.sourceVoltage > theConnections.drainVoltage ) {
 							netStatus_v[theConnections.sourceId][NEEDS_MIN_CONNECTION] = false;
 							if ( gDebug_cvc ) cout << "DEBUG: rerouted min connection check for net: " <<  theConnections.sourceId << endl;
@@ -272,7 +274,7 @@ void CCvcDb::AlreadyShorted(CEventQueue& theEventQueue, deviceId_t theDeviceId,
 						if ( ! myPower_p->extraData ) myPower_p->extraData = new CExtraPowerData;
 						myPower_p->extraData->pullDownVoltage = theConnections.sourceVoltage;
 						theEventQueue.virtualNet_v.Set(theConnections.drainId, theConnections.sourceId, theConnections.resistance, ++theEventQueue.virtualNet_v.lastUpdate);
-						CheckResistorOverflow_(theEventQueue.virtualNet_v[theConnections.drainId].finalResistance, theConnections.drainId, logFile);
+						CheckResistorOverflow_(theEventQueue.virtualNet_v.FinalResistance(theConnections.drainId), theConnections.drainId, logFile);
 						if ( theConnections.drainVoltage > theConnections.sourceVoltage ) {
 							netStatus_v[theConnections.drainId][NEEDS_MIN_CONNECTION] = false;
 							if ( gDebug_cvc ) cout << "DEBUG: rerouted min connection check for net: " <<  theConnections.drainId << endl;
@@ -309,7 +311,7 @@ void CCvcDb::AlreadyShorted(CEventQueue& theEventQueue, deviceId_t theDeviceId,
 						if ( ! myPower_p->extraData ) myPower_p->extraData = new CExtraPowerData;
 						myPower_p->extraData->pullUpVoltage = theConnections.drainVoltage;
 						theEventQueue.virtualNet_v.Set(theConnections.sourceId, theConnections.drainId, theConnections.resistance, ++theEventQueue.virtualNet_v.lastUpdate);
-						CheckResistorOverflow_(theEventQueue.virtualNet_v[theConnections.sourceId].finalResistance, theConnections.sourceId, logFile);
+						CheckResistorOverflow_(theEventQueue.virtualNet_v.FinalResistance(theConnections.sourceId), theConnections.sourceId, logFile);
 						if ( theConnections.sourceVoltage < theConnections.drainVoltage ) {
 							netStatus_v[theConnections.sourceId][NEEDS_MAX_CONNECTION] = false;
 							if ( gDebug_cvc ) cout << "DEBUG: rerouted max connection check for net: " <<  theConnections.sourceId << endl;
@@ -343,7 +345,7 @@ void CCvcDb::AlreadyShorted(CEventQueue& theEventQueue, deviceId_t theDeviceId,
 						if ( ! myPower_p->extraData ) myPower_p->extraData = new CExtraPowerData;
 						myPower_p->extraData->pullUpVoltage = theConnections.sourceVoltage;
 						theEventQueue.virtualNet_v.Set(theConnections.drainId, theConnections.sourceId, theConnections.resistance, ++theEventQueue.virtualNet_v.lastUpdate);
-						CheckResistorOverflow_(theEventQueue.virtualNet_v[theConnections.drainId].finalResistance, theConnections.drainId, logFile);
+						CheckResistorOverflow_(theEventQueue.virtualNet_v.FinalResistance(theConnections.drainId), theConnections.drainId, logFile);
 						if ( theConnections.drainVoltage < theConnections.sourceVoltage ) {
 							netStatus_v[theConnections.drainId][NEEDS_MAX_CONNECTION] = false;
 							if ( gDebug_cvc ) cout << "DEBUG: rerouted max connection check for net: " <<  theConnections.drainId << endl;
@@ -607,12 +609,14 @@ bool CCvcDb::IsOffMos(eventQueue_t theQueueType, deviceId_t theDeviceId, CConnec
 
 bool CCvcDb::LastNmosConnection(deviceStatus_t thePendingBit, netId_t theNetId) {
 	int myConnectionCount = 0;
-	for ( deviceId_t device_it = firstSource_v[theNetId]; device_it != UNKNOWN_DEVICE; device_it = nextSource_v[device_it] ) {
+	for ( auto device_pit = sourceAdjacency.begin(theNetId); device_pit != sourceAdjacency.end(theNetId); device_pit++ ) {
+		deviceId_t device_it = *device_pit;
 		if ( IsNmos_(deviceType_v[device_it]) && deviceStatus_v[device_it][thePendingBit] ) {
 			if ( ++myConnectionCount > 1 ) return false;
 		}
 	}
-	for ( deviceId_t device_it = firstDrain_v[theNetId]; device_it != UNKNOWN_DEVICE; device_it = nextDrain_v[device_it] ) {
+	for ( auto device_pit = drainAdjacency.begin(theNetId); device_pit != drainAdjacency.end(theNetId); device_pit++ ) {
+		deviceId_t device_it = *device_pit;
 		if ( IsNmos_(deviceType_v[device_it]) && deviceStatus_v[device_it][thePendingBit] ) {
 			if ( ++myConnectionCount > 1 ) return false;
 		}
@@ -622,12 +626,14 @@ bool CCvcDb::LastNmosConnection(deviceStatus_t thePendingBit, netId_t theNetId)
 
 bool CCvcDb::LastPmosConnection(deviceStatus_t thePendingBit, netId_t theNetId) {
 	int myConnectionCount = 0;
-	for ( deviceId_t device_it = firstSource_v[theNetId]; device_it != UNKNOWN_DEVICE; device_it = nextSource_v[device_it] ) {
+	for ( auto device_pit = sourceAdjacency.begin(theNetId); device_pit != sourceAdjacency.end(theNetId); device_pit++ ) {
+		deviceId_t device_it = *device_pit;
 		if ( IsPmos_(deviceType_v[device_it]) && deviceStatus_v[device_it][thePendingBit] ) {
 			if ( ++myConnectionCount > 1 ) return false;
 		}
 	}
-	for ( deviceId_t device_it = firstDrain_v[theNetId]; device_it != UNKNOWN_DEVICE; device_it = nextDrain_v[device_it] ) {
+	for ( auto device_pit = drainAdjacency.begin(theNetId); device_pit != drainAdjacency.end(theNetId); device_pit++ ) {
+		deviceId_t device_it = *device_pit;
 		if ( IsPmos_(deviceType_v[device_it]) && deviceStatus_v[device_it][thePendingBit] ) {
 			if ( ++myConnectionCount > 1 ) return false;
 		}
@@ -972,16 +978,17 @@ string CCvcDb::AdjustSimVoltage(CEventQueue& theEventQueue, deviceId_t theDevice
 	return(myCalculation);
 }
 
-void CCvcDb::EnqueueAttachedDevicesByTerminal(CEventQueue& theEventQueue, netId_t theNetId, CDeviceIdVector& theFirstDevice_v, CDeviceIdVector& theNextDevice_v, eventKey_t theEventKey) {
+void CCvcDb::EnqueueAttachedDevicesByTerminal(CEventQueue& theEventQueue, netId_t theNetId, CDeviceIdAdjacency& theAdjacency, eventKey_t theEventKey) {
 	// TODO: possibly remove inactive devices from connection lists
-	if ( theFirstDevice_v[theNetId] == UNKNOWN_DEVICE ) return;
-	static CConnection myConnections;
+	if ( theAdjacency.Count(theNetId) == 0 ) return;
+	CConnection myConnections;
 	queuePosition_t myQueuePosition;
 	eventKey_t myEventKey;
 	string myAdjustedCalculation;
 	int myGateBiasCount = 0;
 	calculationType_t myCalculationType = UNKNOWN_CALCULATION;
-	for (deviceId_t device_it = theFirstDevice_v[theNetId]; device_it != UNKNOWN_DEVICE; device_it = theNextDevice_v[device_it]) {
+	for ( auto device_pit = theAdjacency.begin(theNetId); device_pit != theAdjacency.end(theNetId); device_pit++ ) {
+		deviceId_t device_it = *device_pit;
 		if ( deviceStatus_v[device_it][theEventQueue.inactiveBit] || deviceStatus_v[device_it][theEventQueue.pendingBit] ) {
 			continue; // skip inactive and pending devices
 		} else {
@@ -1052,7 +1059,7 @@ void CCvcDb::EnqueueAttachedDevicesByTerminal(CEventQueue& theEventQueue, netId_
 							if ( gDebug_cvc ) cout << "DEBUG: Calculated power at net: " << myDrainNetId << " MIN " << myEventKey << endl;
 							// do not increment lastUpdate
 							minNet_v.Set(myDrainNetId, myDrainNetId, parameterResistanceMap[myConnections.device_p->parameters] * 100, minNet_v.lastUpdate);
-							CheckResistorOverflow_(minNet_v[myDrainNetId].finalResistance, myDrainNetId, logFile);
+							CheckResistorOverflow_(minNet_v.FinalResistance(myDrainNetId), myDrainNetId, logFile);
 							if ( leakVoltageSet && myMinLeakVoltage != UNKNOWN_VOLTAGE && myMinLeakVoltage <= myEventKey ) continue;
 							assert(netVoltagePtr_v[myDrainNetId].full);
 							if ( netVoltagePtr_v[myDrainNetId].full->pullDownVoltage() != UNKNOWN_VOLTAGE && netVoltagePtr_v[myDrainNetId].full->pullDownVoltage() <= myEventKey ) continue;
@@ -1080,7 +1087,7 @@ void CCvcDb::EnqueueAttachedDevicesByTerminal(CEventQueue& theEventQueue, netId_
 							if ( gDebug_cvc ) cout << "DEBUG: Calculated power at net: " << myDrainNetId << " MAX " << myEventKey << endl;
 							// do not increment lastUpdate
 							maxNet_v.Set(myDrainNetId, myDrainNetId, parameterResistanceMap[myConnections.device_p->parameters] * 100, maxNet_v.lastUpdate);
-							CheckResistorOverflow_(maxNet_v[myDrainNetId].finalResistance, myDrainNetId, logFile);
+							CheckResistorOverflow_(maxNet_v.FinalResistance(myDrainNetId), myDrainNetId, logFile);
 							if ( leakVoltageSet && myMaxLeakVoltage != UNKNOWN_VOLTAGE && myMaxLeakVoltage >= myEventKey ) continue;
 							assert(netVoltagePtr_v[myDrainNetId].full);
 							if ( netVoltagePtr_v[myDrainNetId].full->pullUpVoltage() != UNKNOWN_VOLTAGE && netVoltagePtr_v[myDrainNetId].full->pullUpVoltage() >= myEventKey ) continue;
@@ -1106,20 +1113,21 @@ void CCvcDb::EnqueueAttachedDevicesByTerminal(CEventQueue& theEventQueue, netId_
 		}
 	}
 	if ( myGateBiasCount > 10000 && theEventQueue.queueType != SIM_QUEUE ) {
-		reportFile << "WARNING: large non-power gate/bias net " << NetName(theNetId) << " at " << DeviceName(theFirstDevice_v[theNetId]) << endl;
+		reportFile << "WARNING: large non-power gate/bias net " << NetName(theNetId) << " at " << DeviceName(theAdjacency.First(theNetId)) << endl;
 	}
 }
 
 void CCvcDb::EnqueueAttachedDevices(CEventQueue& theEventQueue, netId_t theNetId, eventKey_t theEventKey) {
-	EnqueueAttachedDevicesByTerminal(theEventQueue, theNetId, firstSource_v, nextSource_v, theEventKey);
-	EnqueueAttachedDevicesByTerminal(theEventQueue, theNetId, firstDrain_v, nextDrain_v, theEventKey);
+	EnqueueAttachedDevicesByTerminal(theEventQueue, theNetId, sourceAdjacency, theEventKey);
+	EnqueueAttachedDevicesByTerminal(theEventQueue, theNetId, drainAdjacency, theEventKey);
 //	EnqueueAttachedDevicesByTerminal(theEventQueue, theNetId, firstBulk_v, nextBulk_v, theEventKey);
-	EnqueueAttachedDevicesByTerminal(theEventQueue, theNetId, firstGate_v, nextGate_v, theEventKey);
+	EnqueueAttachedDevicesByTerminal(theEventQueue, theNetId, gateAdjacency, theEventKey);
 }
 
-void CCvcDb::EnqueueAttachedResistorsByTerminal(CEventQueue& theEventQueue, netId_t theNetId, CDeviceIdVector& theFirstDevice_v, CDeviceIdVector& theNextDevice_v, eventKey_t theEventKey, queuePosition_t theQueuePosition) {
+void CCvcDb::EnqueueAttachedResistorsByTerminal(CEventQueue& theEventQueue, netId_t theNetId, CDeviceIdAdjacency& theAdjacency, eventKey_t theEventKey, queuePosition_t theQueuePosition) {
 	// TODO: possibly remove inactive devices from connection lists
-	for (deviceId_t device_it = theFirstDevice_v[theNetId]; device_it != UNKNOWN_DEVICE; device_it = theNextDevice_v[device_it]) {
+	for ( auto device_pit = theAdjacency.begin(theNetId); device_pit != theAdjacency.end(theNetId); device_pit++ ) {
+		deviceId_t device_it = *device_pit;
 		if ( deviceType_v[device_it] == RESISTOR ) {
 			if ( deviceStatus_v[device_it][theEventQueue.inactiveBit] || deviceStatus_v[device_it][theEventQueue.pendingBit] ) {
 				continue; // skip inactive and pending devices
@@ -1132,8 +1140,8 @@ void CCvcDb::EnqueueAttachedResistorsByTerminal(CEventQueue& theEventQueue, netI
 }
 
 void CCvcDb::EnqueueAttachedResistors(CEventQueue& theEventQueue, netId_t theNetId, eventKey_t theEventKey, queuePosition_t theQueuePosition) {
-	EnqueueAttachedResistorsByTerminal(theEventQueue, theNetId, firstSource_v, nextSource_v, theEventKey, theQueuePosition);
-	EnqueueAttachedResistorsByTerminal(theEventQueue, theNetId, firstDrain_v, nextDrain_v, theEventKey, theQueuePosition);
+	EnqueueAttachedResistorsByTerminal(theEventQueue, theNetId, sourceAdjacency, theEventKey, theQueuePosition);
+	EnqueueAttachedResistorsByTerminal(theEventQueue, theNetId, drainAdjacency, theEventKey, theQueuePosition);
 }
 
 void CCvcDb::ShiftVirtualNets(CEventQueue& theEventQueue, netId_t theNewNetId, CVirtualNet& theLastVirtualNet, resistance_t theSourceResistance, resistance_t theDrainResistance) {
@@ -1155,53 +1163,50 @@ void CCvcDb::ShiftVirtualNets(CEventQueue& theEventQueue, netId_t theNewNetId, C
 		myNetId = theLastVirtualNet.nextNetId;
 		myNewResistance = theLastVirtualNet.resistance;
 		theLastVirtualNet(theEventQueue.virtualNet_v, myNetId);
-		if ( theEventQueue.virtualNet_v[myNetId].finalResistance != theDrainResistance ) {
+		if ( theEventQueue.virtualNet_v.FinalResistance(myNetId) != theDrainResistance ) {
 			cout << "Shift: unexpected drain resistance at net " << myNetId
-					<< " found " << theEventQueue.virtualNet_v[myNetId].finalResistance << " expected " << theDrainResistance << endl;
+					<< " found " << theEventQueue.virtualNet_v.FinalResistance(myNetId) << " expected " << theDrainResistance << endl;
 		}
 		theEventQueue.virtualNet_v.Set(myNetId, theNewNetId, myNewResistance, ++theEventQueue.virtualNet_v.lastUpdate);
-		if ( theEventQueue.virtualNet_v[myNetId].finalResistance != theSourceResistance ) {
+		if ( theEventQueue.virtualNet_v.FinalResistance(myNetId) != theSourceResistance ) {
 			cout << "Shift: unexpected source resistance at net " << myNetId
-					<< " found " << theEventQueue.virtualNet_v[myNetId].finalResistance << " expected " << theSourceResistance << endl;
+					<< " found " << theEventQueue.virtualNet_v.FinalResistance(myNetId) << " expected " << theSourceResistance << endl;
 		}
-		CheckResistorOverflow_(theEventQueue.virtualNet_v[myNetId].finalResistance, myNetId, logFile);
+		CheckResistorOverflow_(theEventQueue.virtualNet_v.FinalResistance(myNetId), myNetId, logFile);
 		theNewNetId = myNetId;
 	}
 }
 
-void CCvcDb::RecalculateFinalResistance(CEventQueue& theEventQueue, netId_t theNetId, bool theRecursingFlag) {
+void CCvcDb::RecalculateFinalResistance(CEventQueue& theEventQueue, netId_t theNetId) {
 	netId_t mySourceId, myDrainId;
 	CConnection myConnections;
 	CDevice myDevice;
-	static unordered_set<netId_t> myProccessedNets;
-	if ( ! theRecursingFlag ) {
-		myProccessedNets.clear();
-	}
-	myProccessedNets.insert(theNetId);
 	netId_t mySearchNetId = theNetId;
 	while ( theEventQueue.virtualNet_v[mySearchNetId].nextNetId != mySearchNetId && theEventQueue.virtualNet_v[mySearchNetId].resistance == 0 ) {
 		// find the master net for non-conducting resistors
 		mySearchNetId = theEventQueue.virtualNet_v[mySearchNetId].nextNetId;
 	}
-	for (deviceId_t device_it = firstSource_v[mySearchNetId]; device_it != UNKNOWN_DEVICE; device_it = nextSource_v[device_it]) {
+	for ( auto device_pit = sourceAdjacency.begin(mySearchNetId); device_pit != sourceAdjacency.end(mySearchNetId); device_pit++ ) {
+		deviceId_t device_it = *device_pit;
 		if ( deviceStatus_v[device_it][theEventQueue.inactiveBit] ) { // only process shorted nets
 			SetDeviceNets(device_it, &myDevice, myConnections.sourceId, myConnections.gateId, myConnections.drainId, myConnections.bulkId);
 			if ( myConnections.sourceId != theNetId ) continue; // skip devices that aren't connected to the net we want
 			myDrainId = myConnections.drainId;
 			if ( theNetId == theEventQueue.virtualNet_v[myDrainId].nextNetId ) { // only process nets that need to be recalculated
 				theEventQueue.virtualNet_v.Set(myDrainId, theNetId, theEventQueue.virtualNet_v[myDrainId].resistance, ++theEventQueue.virtualNet_v.lastUpdate);
-				CheckResistorOverflow_(theEventQueue.virtualNet_v[myDrainId].finalResistance, myDrainId, logFile);
+				CheckResistorOverflow_(theEventQueue.virtualNet_v.FinalResistance(myDrainId), myDrainId, logFile);
 			}
 		}
 	}
-	for (deviceId_t device_it = firstDrain_v[mySearchNetId]; device_it != UNKNOWN_DEVICE; device_it = nextDrain_v[device_it]) {
+	for ( auto device_pit = drainAdjacency.begin(mySearchNetId); device_pit != drainAdjacency.end(mySearchNetId); device_pit++ ) {
+		deviceId_t device_it = *device_pit;
 		if ( deviceStatus_v[device_it][theEventQueue.inactiveBit] ) { // only process shorted nets (process source but not drain)
 			SetDeviceNets(device_it, &myDevice, myConnections.sourceId, myConnections.gateId, myConnections.drainId, myConnections.bulkId);
 			if ( myConnections.drainId != theNetId ) continue; // skip devices that aren't connected to the net we want
 			mySourceId = myConnections.sourceId;
 			if ( theNetId == theEventQueue.virtualNet_v[mySourceId].nextNetId ) { // only process nets that need to be recalculated
 				theEventQueue.virtualNet_v.Set(mySourceId, theNetId, theEventQueue.virtualNet_v[mySourceId].resistance, ++theEventQueue.virtualNet_v.lastUpdate);
-				CheckResistorOverflow_(theEventQueue.virtualNet_v[mySourceId].finalResistance, mySourceId, logFile);
+				CheckResistorOverflow_(theEventQueue.virtualNet_v.FinalResistance(mySourceId), mySourceId, logFile);
 			}
 		}
 	}
@@ -1211,14 +1216,14 @@ void CCvcDb::ShortNets(CEventQueue& theEventQueue, deviceId_t theDeviceId, CConn
 	if ( theDirection == DRAIN_TO_MASTER_SOURCE ) {
 		// do not increment lastUpdate (increment in calling routine if necessary)
 		theEventQueue.virtualNet_v.Set(theConnections.drainId, theConnections.sourceId, parameterResistanceMap[theConnections.device_p->parameters], theEventQueue.virtualNet_v.lastUpdate);
-		CheckResistorOverflow_(theEventQueue.virtualNet_v[theConnections.drainId].finalResistance, theConnections.drainId, logFile);
+		CheckResistorOverflow_(theEventQueue.virtualNet_v.FinalResistance(theConnections.drainId), theConnections.drainId, logFile);
 		if ( deviceType_v[theDeviceId] == RESISTOR ) {
 			PropagateConnectionType(theEventQueue.virtualNet_v, connectionCount_v[theConnections.drainId].sourceDrainType, theConnections.sourceId);
 		}
 	} else if ( theDirection == SOURCE_TO_MASTER_DRAIN ) {
 		// do not increment lastUpdate (increment in calling routine if necessary)
 		theEventQueue.virtualNet_v.Set(theConnections.sourceId, theConnections.drainId, parameterResistanceMap[theConnections.device_p->parameters], theEventQueue.virtualNet_v.lastUpdate);
-		CheckResistorOverflow_(theEventQueue.virtualNet_v[theConnections.sourceId].finalResistance, theConnections.sourceId, logFile);
+		CheckResistorOverflow_(theEventQueue.virtualNet_v.FinalResistance(theConnections.sourceId), theConnections.sourceId, logFile);
 		if ( deviceType_v[theDeviceId] == RESISTOR ) {
 			PropagateConnectionType(theEventQueue.virtualNet_v, connectionCount_v[theConnections.sourceId].sourceDrainType, theConnections.drainId);
 		}
@@ -1263,13 +1268,13 @@ void CCvcDb::ShortNets(CEventQueue& theEventQueue, deviceId_t theDeviceId, CConn
 	if ( theShortVoltage == myMasterVoltage ) {
 		// do not increment lastUpdate (increment in calling routine if necessary)
 		theEventQueue.virtualNet_v.Set(mySlaveNet, myMasterNet, parameterResistanceMap[theConnections.device_p->parameters], theEventQueue.virtualNet_v.lastUpdate);
-		CheckResistorOverflow_(theEventQueue.virtualNet_v[mySlaveNet].finalResistance, mySlaveNet, logFile);
+		CheckResistorOverflow_(theEventQueue.virtualNet_v.FinalResistance(mySlaveNet), mySlaveNet, logFile);
 	} else {
 		netVoltagePtr_v.CalculatePower(theEventQueue, theShortVoltage, mySlaveNet, myMasterNet, this, theCalculation);
 		if ( gDebug_cvc ) cout << "DEBUG: Calculated power at net: " << mySlaveNet << " " << gEventQueueTypeMap[theEventQueue.queueType] << " " << theShortVoltage << endl;
 		// do not increment lastUpdate (increment in calling routine if necessary)
-		theEventQueue.virtualNet_v.Set(mySlaveNet, mySlaveNet, parameterResistanceMap[theConnections.device_p->parameters] + theEventQueue.virtualNet_v[myMasterNet].finalResistance, theEventQueue.virtualNet_v.lastUpdate);
-		CheckResistorOverflow_(theEventQueue.virtualNet_v[mySlaveNet].finalResistance, mySlaveNet, logFile);
+		theEventQueue.virtualNet_v.Set(mySlaveNet, mySlaveNet, parameterResistanceMap[theConnections.device_p->parameters] + theEventQueue.virtualNet_v.FinalResistance(myMasterNet), theEventQueue.virtualNet_v.lastUpdate);
+		CheckResistorOverflow_(theEventQueue.virtualNet_v.FinalResistance(mySlaveNet), mySlaveNet, logFile);
 	}
 	if ( deviceType_v[theDeviceId] == RESISTOR ) {
 		PropagateConnectionType(theEventQueue.virtualNet_v, connectionCount_v[mySlaveNet].sourceDrainType, myMasterNet);
@@ -1319,7 +1324,7 @@ void CCvcDb::ShortSimNets(CEventQueue& theEventQueue, deviceId_t theDeviceId, CC
 	}
 	if ( theShortVoltage == myMasterVoltage ) {
 		if ( IsSCRCPower(myMasterPower_p) && connectionCount_v[mySlaveNet].sourceDrainType[NMOS] && connectionCount_v[mySlaveNet].sourceDrainType[PMOS] && IsMos_(deviceType_v[theDeviceId]) ) {
-			static CFullConnection myConnections;
+			CFullConnection myConnections;
 			MapDeviceNets(theDeviceId, myConnections);
 			CPower * myOppositePower_p;
 			if ( IsNmos_(deviceType_v[theDeviceId]) ) {
@@ -1331,6 +1336,7 @@ void CCvcDb::ShortSimNets(CEventQueue& theEventQueue, deviceId_t theDeviceId, CC
 					&& ( IncrementDeviceError(theDeviceId, LEAK) < cvcParameters.cvcCircuitErrorLimit
 						|| cvcParameters.cvcCircuitErrorLimit == 0 ) ) {
 				errorFile << "! Short Detected: SCRC " << PrintVoltage(myMasterVoltage) << " to output" << endl;
+				RecordError(LEAK, deviceParent_v[theDeviceId], myConnections);
 				PrintDeviceWithAllConnections(deviceParent_v[theDeviceId], myConnections, errorFile);
 				errorFile << endl;
 			}
@@ -1342,13 +1348,13 @@ void CCvcDb::ShortSimNets(CEventQueue& theEventQueue, deviceId_t theDeviceId, CC
 		if ( gDebug_cvc ) cout << "DEBUG: Calculated power at net: " << mySlaveNet << " " << gEventQueueTypeMap[theEventQueue.queueType] << " " << theShortVoltage << endl;
 		if ( IsMos_(deviceType_v[theDeviceId]) && theConnections.gateId == mySlaveNet ) { // gate/drain connections increase effective resistance (trace is broken so add master final resistance)
 			// do not increment lastUpdate
-			theEventQueue.virtualNet_v.Set(mySlaveNet, mySlaveNet, parameterResistanceMap[theConnections.device_p->parameters] * 100 + theEventQueue.virtualNet_v[myMasterNet].finalResistance, theEventQueue.virtualNet_v.lastUpdate);
+			theEventQueue.virtualNet_v.Set(mySlaveNet, mySlaveNet, parameterResistanceMap[theConnections.device_p->parameters] * 100 + theEventQueue.virtualNet_v.FinalResistance(myMasterNet), theEventQueue.virtualNet_v.lastUpdate);
 		} else {
 			// do not increment lastUpdate
-			theEventQueue.virtualNet_v.Set(mySlaveNet, mySlaveNet, parameterResistanceMap[theConnections.device_p->parameters] + theEventQueue.virtualNet_v[myMasterNet].finalResistance, theEventQueue.virtualNet_v.lastUpdate);
+			theEventQueue.virtualNet_v.Set(mySlaveNet, mySlaveNet, parameterResistanceMap[theConnections.device_p->parameters] + theEventQueue.virtualNet_v.FinalResistance(myMasterNet), theEventQueue.virtualNet_v.lastUpdate);
 		}
 	}
-	CheckResistorOverflow_(theEventQueue.virtualNet_v[mySlaveNet].finalResistance, mySlaveNet, logFile);
+	CheckResistorOverflow_(theEventQueue.virtualNet_v.FinalResistance(mySlaveNet), mySlaveNet, logFile);
 	if ( deviceType_v[theDeviceId] == RESISTOR ) {
 		PropagateConnectionType(theEventQueue.virtualNet_v, connectionCount_v[mySlaveNet].sourceDrainType, myMasterNet);
 	}
@@ -1379,7 +1385,7 @@ void CCvcDb::PropagateResistorVoltages(CEventQueue& theEventQueue) {
 	deviceStatus_v[myDeviceId][theEventQueue.pendingBit] = false;
 	queuePosition_t myQueuePosition;
 	if ( deviceStatus_v[myDeviceId][theEventQueue.inactiveBit] ) return;
-	static CConnection myConnections;
+	CConnection myConnections;
 	MapDeviceNets(myDeviceId, theEventQueue, myConnections);
 	if ( myConnections.IsUnknownSourceVoltage() ) {
 		assert (myConnections.drainVoltage != UNKNOWN_VOLTAGE);
@@ -1411,7 +1417,7 @@ void CCvcDb::PropagateMinMaxVoltages(CEventQueue& theEventQueue) {
 	queuePosition_t myQueuePosition;
 	netId_t myDrainId, mySourceId;
 	shortDirection_t myDirection;
-	static CConnection myConnections;
+	CConnection myConnections;
 	MapDeviceNets(myDeviceId, theEventQueue, myConnections);
 	// BUG: 20140307 if both nets are known, need highest for max, lowest for min.
 	if ( myConnections.sourceVoltage != UNKNOWN_VOLTAGE ) {
@@ -1511,7 +1517,7 @@ void CCvcDb::PropagateSimVoltages(CEventQueue& theEventQueue, propagation_t theP
 	voltage_t mySimVoltage;
 	netId_t myNextNetId;
 	shortDirection_t myDirection;
-	static CConnection myConnections;
+	CConnection myConnections;
 	MapDeviceNets(myDeviceId, theEventQueue, myConnections);
 	// 20140522A: when both source and drain are known, choose high for pmos, low for nmos
 	if ( myConnections.IsUnknownSourceVoltage() ) {
@@ -1583,8 +1589,8 @@ void CCvcDb::CalculateResistorVoltage(netId_t theNetId, voltage_t theMinVoltage,
 			voltage_t theMaxVoltage, resistance_t theMaxResistance ) {
 	if ( theMinVoltage == UNKNOWN_VOLTAGE || theMaxVoltage == UNKNOWN_VOLTAGE ) return; // myIgnoreResistorFlag = true; // can't propagate unknown voltage
 	if ( theMinResistance == 0 || theMaxResistance == 0 ) return; //myIgnoreResistorFlag = true; // don't recalculate 0 resistance
-	netId_t myMinNet = minNet_v[theNetId].finalNetId;
-	netId_t myMaxNet = maxNet_v[theNetId].finalNetId;
+	netId_t myMinNet = minNet_v.FinalNetId(theNetId);
+	netId_t myMaxNet = maxNet_v.FinalNetId(theNetId);
 	if ( ! netVoltagePtr_v[myMinNet].full || netVoltagePtr_v[myMinNet].full->type[HIZ_BIT] ) return;  // don't calculate non-power or open
 	if ( ! netVoltagePtr_v[myMaxNet].full || netVoltagePtr_v[myMaxNet].full->type[HIZ_BIT] ) return;  // don't calculate non-power or open
 	if (  // myIgnoreResistorFlag == false &&
@@ -1613,8 +1619,8 @@ void CCvcDb::CalculateResistorVoltage(netId_t theNetId, voltage_t theMinVoltage,
 		myPower_p->maxCalculationType = RESISTOR_CALCULATION;
 		myPower_p->minVoltage = myNewVoltage;
 		myPower_p->minCalculationType = RESISTOR_CALCULATION;
-		myPower_p->defaultMinNet = minNet_v[theNetId].finalNetId;
-		myPower_p->defaultMaxNet = maxNet_v[theNetId].finalNetId;
+		myPower_p->defaultMinNet = minNet_v.FinalNetId(theNetId);
+		myPower_p->defaultMaxNet = maxNet_v.FinalNetId(theNetId);
 		myPower_p->netId = theNetId;
 		myPower_p->type[MIN_CALCULATED_BIT] = true;
 	//	myPower_p->type[SIM_CALCULATED_BIT] = true;
@@ -1629,9 +1635,10 @@ void CCvcDb::CalculateResistorVoltage(netId_t theNetId, voltage_t theMinVoltage,
 	}
 }
 
-void CCvcDb::PropagateResistorCalculations(netId_t theNetId, CDeviceIdVector& theFirstDevice_v, CDeviceIdVector& theNextDevice_v) {
+void CCvcDb::PropagateResistorCalculations(netId_t theNetId, CDeviceIdAdjacency& theAdjacency) {
 	CFullConnection myConnections;
-	for ( deviceId_t device_it = theFirstDevice_v[theNetId]; device_it != UNKNOWN_DEVICE; device_it = theNextDevice_v[device_it] ) {
+	for ( auto device_pit = theAdjacency.begin(theNetId); device_pit != theAdjacency.end(theNetId); device_pit++ ) {
+		deviceId_t device_it = *device_pit;
 		if ( deviceType_v[device_it] == RESISTOR ) {
 			MapDeviceNets(device_it, myConnections);
 			if ( netVoltagePtr_v[myConnections.drainId].full == NULL ) {
@@ -1660,8 +1667,8 @@ void CCvcDb::CalculateResistorVoltages() {
 		if ( (*power_ppit)->type[RESISTOR_BIT] ) { // && (*power_ppit)->simVoltage == UNKNOWN_VOLTAGE ) {
 			netId_t myPowerNet = (*power_ppit)->netId;
 			if ( myPowerNet != UNKNOWN_NET && netVoltagePtr_v[myPowerNet].full == *power_ppit ) { // process only used power nodes (ununsed power kept in powerPtrList)
-				PropagateResistorCalculations(myPowerNet, firstSource_v, nextSource_v);
-				PropagateResistorCalculations(myPowerNet, firstDrain_v, nextDrain_v);
+				PropagateResistorCalculations(myPowerNet, sourceAdjacency);
+				PropagateResistorCalculations(myPowerNet, drainAdjacency);
 			}
 		}
 	}
@@ -1708,8 +1715,11 @@ void CCvcDb::CalculateResistorVoltages() {
 					myLastPowerNet = myPowerNet;
 					myPowerNet = maxNet_v[myPowerNet].nextNetId;
 					minNet_v[myLastPowerNet].nextNetId = maxNet_v[myLastPowerNet].nextNetId = myLastPowerNet;
-					minNet_v[myLastPowerNet].finalNetId = maxNet_v[myLastPowerNet].finalNetId = myLastPowerNet;
+					minNet_v.SetFinalNetId(myLastPowerNet, myLastPowerNet);
+					maxNet_v.SetFinalNetId(myLastPowerNet, myLastPowerNet);
 				} while ( netVoltagePtr_v[myPowerNet].full && netVoltagePtr_v[myPowerNet].full->simVoltage != UNKNOWN_VOLTAGE && ! maxNet_v.IsTerminal(myPowerNet));
+				minNet_v.InvalidateRoutes();
+				maxNet_v.InvalidateRoutes();
 				debugFile << endl;
 			}
 		}
@@ -1799,7 +1809,8 @@ void CCvcDb::SetTrivialMinMaxPower() {
 			if ( connectionCount_v[net_it].sourceDrainType[NMOS] && connectionCount_v[net_it].sourceDrainType[PMOS] ) {
 				myNmos = UNKNOWN_DEVICE;
 				myPmos = UNKNOWN_DEVICE;
-				for ( deviceId_t device_it = firstDrain_v[net_it]; device_it != UNKNOWN_DEVICE; device_it = nextDrain_v[device_it] ) {
+				for ( auto device_pit = drainAdjacency.begin(net_it); device_pit != drainAdjacency.end(net_it); device_pit++ ) {
+					deviceId_t device_it = *device_pit;
 					//if ( sourceNet_v[device_it] == gateNet_v[device_it] ) continue; // skip mos diodes  (need this for tied inverters)
 					if ( sourceNet_v[device_it] == drainNet_v[device_it] ) continue; // skip mos capacitors
 
@@ -1814,7 +1825,8 @@ void CCvcDb::SetTrivialMinMaxPower() {
 						}
 					}
 				}
-				for ( deviceId_t device_it = firstSource_v[net_it]; device_it != UNKNOWN_DEVICE; device_it = nextSource_v[device_it] ) {
+				for ( auto device_pit = sourceAdjacency.begin(net_it); device_pit != sourceAdjacency.end(net_it); device_pit++ ) {
+					deviceId_t device_it = *device_pit;
 					if ( sourceNet_v[device_it] == drainNet_v[device_it] ) continue; // skip mos capacitors
 
 					if ( IsNmos_(deviceType_v[device_it]) ) {
@@ -1878,7 +1890,8 @@ void CCvcDb::SetTrivialMinMaxPower() {
 					}
 				} else if ( gSetup_cvc ) {
 					CStatus myGateTypes;
-					for ( deviceId_t device_it = firstGate_v[net_it]; device_it != UNKNOWN_DEVICE; device_it = nextGate_v[device_it] ) {
+					for ( auto device_pit = gateAdjacency.begin(net_it); device_pit != gateAdjacency.end(net_it); device_pit++ ) {
+						deviceId_t device_it = *device_pit;
 						if ( IsNmos_(deviceType_v[device_it]) ) {
 							myGateTypes[NMOS] = true;
 						} else if ( IsPmos_(deviceType_v[device_it]) ) {
@@ -1939,16 +1952,16 @@ void CCvcDb::SetInitialMinMaxPower() {
 		if ( myPower_p && myPower_p->active[MIN_ACTIVE] ) {
 			voltage_t myMinVoltage = ( isFixedSimNet && myPower_p->simVoltage != UNKNOWN_VOLTAGE ) ? myPower_p->simVoltage : myPower_p->minVoltage;
 			if ( myMinVoltage != UNKNOWN_VOLTAGE ) {
-				EnqueueAttachedDevicesByTerminal(minEventQueue, net_it, firstSource_v, nextSource_v, myMinVoltage);
-				EnqueueAttachedDevicesByTerminal(minEventQueue, net_it, firstDrain_v, nextDrain_v, myMinVoltage);
+				EnqueueAttachedDevicesByTerminal(minEventQueue, net_it, sourceAdjacency, myMinVoltage);
+				EnqueueAttachedDevicesByTerminal(minEventQueue, net_it, drainAdjacency, myMinVoltage);
 			}
 		}
 		myPower_p = netVoltagePtr_v[myMaxMasterNet.finalNetId].full;
 		if ( myPower_p && myPower_p->active[MAX_ACTIVE] ) {
 			voltage_t myMaxVoltage = ( isFixedSimNet && myPower_p->simVoltage != UNKNOWN_VOLTAGE ) ? myPower_p->simVoltage : myPower_p->maxVoltage;
 			if ( myMaxVoltage != UNKNOWN_VOLTAGE ) {
-				EnqueueAttachedDevicesByTerminal(maxEventQueue, net_it, firstSource_v, nextSource_v, myMaxVoltage);
-				EnqueueAttachedDevicesByTerminal(maxEventQueue, net_it, firstDrain_v, nextDrain_v, myMaxVoltage);
+				EnqueueAttachedDevicesByTerminal(maxEventQueue, net_it, sourceAdjacency, myMaxVoltage);
+				EnqueueAttachedDevicesByTerminal(maxEventQueue, net_it, drainAdjacency, myMaxVoltage);
 			}
 		}
 	}
@@ -1967,13 +1980,13 @@ void CCvcDb::SetInitialMinMaxPower() {
 					|| (minEventQueue.IsNextMainQueue() && ! maxEventQueue.IsNextMainQueue()) ) {
 				myProcessingMinQueue = true;
 				myDequeueCount = ( minEventQueue.IsNextMainQueue() ) ?
-					minEventQueue.mainQueue.begin()->second.eventListSize :
-					minEventQueue.delayQueue.begin()->second.eventListSize;
+					minEventQueue.mainQueue.Front().eventListSize :
+					minEventQueue.delayQueue.Front().eventListSize;
 			} else {
 				myProcessingMinQueue = false;
 				myDequeueCount = ( maxEventQueue.IsNextMainQueue() ) ?
-					maxEventQueue.mainQueue.begin()->second.eventListSize :
-					maxEventQueue.delayQueue.begin()->second.eventListSize;
+					maxEventQueue.mainQueue.Front().eventListSize :
+					maxEventQueue.delayQueue.Front().eventListSize;
 			}
 		}
 		assert(myDequeueCount);
@@ -2001,13 +2014,14 @@ void CCvcDb::SetInitialMinMaxPower() {
 	reportFile << "CVC:   Removed " << myRemovedCount << " calculations" << endl;
 	int	myProgressCount = 0;
 	reportFile << "Copying master nets"; cout.flush();
+	CVirtualNet myVirtualNet;
 	for ( netId_t net_it = 0; net_it < netCount; net_it++ ) {
 		if ( ++myProgressCount == 1000000 ) {
 			cout << "."; cout.flush();
 			myProgressCount = 0;
 		}
-		minNet_v[net_it](minNet_v, net_it); // recalculate final values
-		maxNet_v[net_it](maxNet_v, net_it); // recalculate final values
+		myVirtualNet(minNet_v, net_it); // recalculate final values
+		myVirtualNet(maxNet_v, net_it); // recalculate final values
 	}
 	reportFile << endl;
 	isFixedMinNet = isFixedMaxNet = true;
@@ -2015,11 +2029,11 @@ void CCvcDb::SetInitialMinMaxPower() {
 		set<string> myUndefinedPowerNets;
 		for ( netId_t net_it = 0; net_it < netCount; net_it++ ) {
 			if ( ! netVoltagePtr_v[net_it].full || netVoltagePtr_v[net_it].full->type[POWER_BIT] ) continue;
-			if ( minNet_v[net_it].finalNetId != UNKNOWN_NET && maxNet_v[net_it].finalNetId != UNKNOWN_NET
-					&& netVoltagePtr_v[minNet_v[net_it].finalNetId].full && netVoltagePtr_v[maxNet_v[net_it].finalNetId].full
-					&& netVoltagePtr_v[minNet_v[net_it].finalNetId].full->minVoltage != UNKNOWN_VOLTAGE
-					&& netVoltagePtr_v[maxNet_v[net_it].finalNetId].full->maxVoltage != UNKNOWN_VOLTAGE
-					&& netVoltagePtr_v[minNet_v[net_it].finalNetId].full->minVoltage <= netVoltagePtr_v[maxNet_v[net_it].finalNetId].full->maxVoltage ) continue;
+			if ( minNet_v.FinalNetId(net_it) != UNKNOWN_NET && maxNet_v.FinalNetId(net_it) != UNKNOWN_NET
+					&& netVoltagePtr_v[minNet_v.FinalNetId(net_it)].full && netVoltagePtr_v[maxNet_v.FinalNetId(net_it)].full
+					&& netVoltagePtr_v[minNet_v.FinalNetId(net_it)].full->minVoltage != UNKNOWN_VOLTAGE
+					&& netVoltagePtr_v[maxNet_v.FinalNetId(net_it)].full->maxVoltage != UNKNOWN_VOLTAGE
+					&& netVoltagePtr_v[minNet_v.FinalNetId(net_it)].full->minVoltage <= netVoltagePtr_v[maxNet_v.FinalNetId(net_it)].full->maxVoltage ) continue;
 			if ( connectionCount_v[net_it].SourceDrainCount() > 9 ) {
 				myUndefinedPowerNets.insert(NetName(net_it, PRINT_CIRCUIT_ON) + " " + to_string<size_t>(connectionCount_v[net_it].SourceDrainCount()));
 			}
@@ -2070,40 +2084,44 @@ void CCvcDb::ResetMinMaxPower() {
 	maxEventQueue.ResetQueue(deviceCount);
 	minNet_v.InitializeUpdateArray();
 	maxNet_v.InitializeUpdateArray();
+	simNet_v.ClearUpdateArray();  // sim links are only read until the next sim propagation
 	for (deviceId_t device_it = 0; device_it < deviceCount; device_it++) {
 		deviceStatus_v[device_it][MIN_INACTIVE] = deviceStatus_v[device_it][MAX_INACTIVE] = deviceStatus_v[device_it][SIM_INACTIVE];
 	}
 	CPower * myVoltage_p;
+	// links are rewritten from sim below, so memoized routes are stale until the loop ends
+	minNet_v.InvalidateRoutes();
+	maxNet_v.InvalidateRoutes();
 	for (netId_t net_it = 0; net_it < netCount; net_it++) {
 		if ( isFixedSimNet ) { // after first sim pass
-			if ( simNet_v[net_it].finalNetId == UNKNOWN_NET
-					|| ! netVoltagePtr_v[simNet_v[net_it].finalNetId].full
-					|| netVoltagePtr_v[simNet_v[net_it].finalNetId].full->simVoltage == UNKNOWN_VOLTAGE ) {
-				minNet_v[net_it].Copy(simNet_v[net_it]);
-				maxNet_v[net_it].Copy(simNet_v[net_it]);
+			if ( simNet_v.FinalNetId(net_it) == UNKNOWN_NET
+					|| ! netVoltagePtr_v[simNet_v.FinalNetId(net_it)].full
+					|| netVoltagePtr_v[simNet_v.FinalNetId(net_it)].full->simVoltage == UNKNOWN_VOLTAGE ) {
+				minNet_v.Copy(net_it, simNet_v);
+				maxNet_v.Copy(net_it, simNet_v);
 			} else {
-				if ( minNet_v[net_it].finalNetId == UNKNOWN_NET
-						|| ! netVoltagePtr_v[minNet_v[net_it].finalNetId].full
-						|| netVoltagePtr_v[minNet_v[net_it].finalNetId].full->minVoltage == UNKNOWN_VOLTAGE
-						|| ( netVoltagePtr_v[simNet_v[net_it].finalNetId].full->minVoltage != UNKNOWN_VOLTAGE
-								&& netVoltagePtr_v[minNet_v[net_it].finalNetId].full->minVoltage <= netVoltagePtr_v[simNet_v[net_it].finalNetId].full->minVoltage ) ) {
-					minNet_v[net_it].Copy(simNet_v[net_it]);
+				if ( minNet_v.FinalNetId(net_it) == UNKNOWN_NET
+						|| ! netVoltagePtr_v[minNet_v.FinalNetId(net_it)].full
+						|| netVoltagePtr_v[minNet_v.FinalNetId(net_it)].full->minVoltage == UNKNOWN_VOLTAGE
+						|| ( netVoltagePtr_v[simNet_v.FinalNetId(net_it)].full->minVoltage != UNKNOWN_VOLTAGE
+								&& netVoltagePtr_v[minNet_v.FinalNetId(net_it)].full->minVoltage <= netVoltagePtr_v[simNet_v.FinalNetId(net_it)].full->minVoltage ) ) {
+					minNet_v.Copy(net_it, simNet_v);
 				} else {
-					minNet_v.Set(net_it, net_it, 0, 0);
+					minNet_v.Relink(net_it, net_it, 0, 0);
 				}
-				if ( maxNet_v[net_it].finalNetId == UNKNOWN_NET
-					|| ! netVoltagePtr_v[maxNet_v[net_it].finalNetId].full
-					|| netVoltagePtr_v[maxNet_v[net_it].finalNetId].full->maxVoltage == UNKNOWN_VOLTAGE
-					|| ( netVoltagePtr_v[maxNet_v[net_it].finalNetId].full->maxVoltage != UNKNOWN_VOLTAGE
-							&& netVoltagePtr_v[maxNet_v[net_it].finalNetId].full->maxVoltage >= netVoltagePtr_v[simNet_v[net_it].finalNetId].full->maxVoltage ) ) {
-					maxNet_v[net_it].Copy(simNet_v[net_it]);
+				if ( maxNet_v.FinalNetId(net_it) == UNKNOWN_NET
+					|| ! netVoltagePtr_v[maxNet_v.FinalNetId(net_it)].full
+					|| netVoltagePtr_v[maxNet_v.FinalNetId(net_it)].full->maxVoltage == UNKNOWN_VOLTAGE
+					|| ( netVoltagePtr_v[maxNet_v.FinalNetId(net_it)].full->maxVoltage != UNKNOWN_VOLTAGE
+							&& netVoltagePtr_v[maxNet_v.FinalNetId(net_it)].full->maxVoltage >= netVoltagePtr_v[simNet_v.FinalNetId(net_it)].full->maxVoltage ) ) {
+					maxNet_v.Copy(net_it, simNet_v);
 				} else {
-					maxNet_v.Set(net_it, net_it, 0, 0);
+					maxNet_v.Relink(net_it, net_it, 0, 0);
 				}
 			}
 			if ( netVoltagePtr_v[net_it].full &&
-					simNet_v[net_it].finalNetId != UNKNOWN_NET &&
-					netVoltagePtr_v[simNet_v[net_it].finalNetId].full->simVoltage == UNKNOWN_VOLTAGE ) {
+					simNet_v.FinalNetId(net_it) != UNKNOWN_NET &&
+					netVoltagePtr_v[simNet_v.FinalNetId(net_it)].full->simVoltage == UNKNOWN_VOLTAGE ) {
 				// remove min/max calculations if not equal to sim
 				if ( netVoltagePtr_v[net_it].full->type[MIN_CALCULATED_BIT] ) {
 					if ( netVoltagePtr_v[net_it].full == leakVoltagePtr_v[net_it].full ) {  // Save old copy before erasing.
@@ -2132,20 +2150,20 @@ void CCvcDb::ResetMinMaxPower() {
 			}
 		} else { // first min max. reset from resistance propagation.
 			if ( minNet_v[net_it].nextNetId == simNet_v[net_it].nextNetId ) {
-				minNet_v[net_it].finalNetId = simNet_v[net_it].finalNetId;
+				minNet_v.SetFinalNetId(net_it, simNet_v.FinalNetId(net_it));
 				if ( minNet_v.IsTerminal(net_it) ) { // save resistances for calculated power
-					minNet_v[net_it].resistance = minNet_v[net_it].finalResistance;
+					minNet_v[net_it].resistance = minNet_v.FinalResistance(net_it);
 				}
 			} else {
-				minNet_v.Set(net_it, net_it, 0, 0);
+				minNet_v.Relink(net_it, net_it, 0, 0);
 			}
 			if ( maxNet_v[net_it].nextNetId == simNet_v[net_it].nextNetId ) {
-				maxNet_v[net_it].finalNetId = simNet_v[net_it].finalNetId;
+				maxNet_v.SetFinalNetId(net_it, simNet_v.FinalNetId(net_it));
 				if ( maxNet_v.IsTerminal(net_it) ) { // save resistances for calculated power
-					maxNet_v[net_it].resistance = maxNet_v[net_it].finalResistance;
+					maxNet_v[net_it].resistance = maxNet_v.FinalResistance(net_it);
 				}
 			} else {
-				maxNet_v.Set(net_it, net_it, 0, 0);
+				maxNet_v.Relink(net_it, net_it, 0, 0);
 			}
 		}
 		myVoltage_p = netVoltagePtr_v[net_it].full;
@@ -2197,6 +2215,8 @@ void CCvcDb::ResetMinMaxPower() {
 		}
 
 	}
+	minNet_v.InvalidateRoutes();  // copied from sim
+	maxNet_v.InvalidateRoutes();
 	SetInitialMinMaxPower();
 	minNet_v.ClearUpdateArray();
 	maxNet_v.ClearUpdateArray();
@@ -2207,8 +2227,8 @@ void CCvcDb::SetAnalogNets() {
 		if ( net_it != GetEquivalentNet(net_it) ) continue;  // skip subordinate nets
 		if ( netVoltagePtr_v[net_it].full && netVoltagePtr_v[net_it].full->type[POWER_BIT] ) continue;  // skip power
 		bool myIsAnalogNet = false;
-		deviceId_t device_it = firstSource_v[net_it];
-		while ( ! myIsAnalogNet && device_it != UNKNOWN_DEVICE ) {
+		for ( auto device_pit = sourceAdjacency.begin(net_it); ! myIsAnalogNet && device_pit != sourceAdjacency.end(net_it); device_pit++ ) {
+			deviceId_t device_it = *device_pit;
 			if ( GetEquivalentNet(drainNet_v[device_it]) != net_it ) {
 				switch( deviceType_v[device_it] ) {
 				case NMOS: case LDDN: case PMOS: case LDDP: {
@@ -2219,10 +2239,9 @@ void CCvcDb::SetAnalogNets() {
 				default: break;
 				}
 			}
-			device_it = nextSource_v[device_it];
 		}
-		device_it = firstDrain_v[net_it];
-		while ( ! myIsAnalogNet && device_it != UNKNOWN_DEVICE ) {
+		for ( auto device_pit = drainAdjacency.begin(net_it); ! myIsAnalogNet && device_pit != drainAdjacency.end(net_it); device_pit++ ) {
+			deviceId_t device_it = *device_pit;
 			if ( GetEquivalentNet(sourceNet_v[device_it]) != net_it ) {
 				switch( deviceType_v[device_it] ) {
 				case NMOS: case LDDN: case PMOS: case LDDP: {
@@ -2233,7 +2252,6 @@ void CCvcDb::SetAnalogNets() {
 				default: break;
 				}
 			}
-			device_it = nextDrain_v[device_it];
 		}
 		if ( myIsAnalogNet ) {
 			PropagateAnalogNetType(net_it, 0);
@@ -2251,16 +2269,17 @@ void CCvcDb::PropagateAnalogNetType(netId_t theNetId, int theGateCount) {
 	bool myIsAlreadyAnalog = netStatus_v[theNetId][ANALOG];
 	netStatus_v[theNetId][ANALOG] = true;
 	if ( theGateCount < 1 ) {
-		PropagateAnalogNetTypeByTerminal(theNetId, firstGate_v, nextGate_v, theGateCount + 1);
+		PropagateAnalogNetTypeByTerminal(theNetId, gateAdjacency, theGateCount + 1);
 	}
 	if ( ! myIsAlreadyAnalog ) {
-		PropagateAnalogNetTypeByTerminal(theNetId, firstSource_v, nextSource_v, theGateCount);
-		PropagateAnalogNetTypeByTerminal(theNetId, firstDrain_v, nextDrain_v, theGateCount);
+		PropagateAnalogNetTypeByTerminal(theNetId, sourceAdjacency, theGateCount);
+		PropagateAnalogNetTypeByTerminal(theNetId, drainAdjacency, theGateCount);
 	}
 }
  
-void CCvcDb::PropagateAnalogNetTypeByTerminal(netId_t theNetId, CDeviceIdVector& theFirstDevice_v, CDeviceIdVector& theNextDevice_v, int theGateCount) {
-	for (deviceId_t device_it = theFirstDevice_v[theNetId]; device_it != UNKNOWN_DEVICE; device_it = theNextDevice_v[device_it]) {
+void CCvcDb::PropagateAnalogNetTypeByTerminal(netId_t theNetId, CDeviceIdAdjacency& theAdjacency, int theGateCount) {
+	for ( auto device_pit = theAdjacency.begin(theNetId); device_pit != theAdjacency.end(theNetId); device_pit++ ) {
+		deviceId_t device_it = *device_pit;
 		netId_t mySourceId = GetEquivalentNet(sourceNet_v[device_it]);
 		netId_t myDrainId = GetEquivalentNet(drainNet_v[device_it]);
 		if ( mySourceId != myDrainId ) {
@@ -2289,25 +2308,26 @@ void CCvcDb::SetSimPower(propagation_t thePropagationType, CNetIdSet & theNewNet
 		CPower * myPower_p = netVoltagePtr_v[mySimMasterNet.finalNetId].full;
 		if ( myPower_p->simVoltage == UNKNOWN_VOLTAGE && ! IsSCRCPower(myPower_p) ) continue;
 		if ( thePropagationType == POWER_NETS_ONLY && ! IsPriorityPower_(myPower_p) ) continue;
-		EnqueueAttachedDevicesByTerminal(simEventQueue, net_it, firstSource_v, nextSource_v, myPower_p->simVoltage);
-		EnqueueAttachedDevicesByTerminal(simEventQueue, net_it, firstDrain_v, nextDrain_v, myPower_p->simVoltage);
-		EnqueueAttachedDevicesByTerminal(simEventQueue, net_it, firstGate_v, nextGate_v, myPower_p->simVoltage);
+		EnqueueAttachedDevicesByTerminal(simEventQueue, net_it, sourceAdjacency, myPower_p->simVoltage);
+		EnqueueAttachedDevicesByTerminal(simEventQueue, net_it, drainAdjacency, myPower_p->simVoltage);
+		EnqueueAttachedDevicesByTerminal(simEventQueue, net_it, gateAdjacency, myPower_p->simVoltage);
 	}
 	simEventQueue.queueStart = true;
 	while (simEventQueue.QueueSize() > 0) {
 		PropagateSimVoltages(simEventQueue, thePropagationType);
 	}
+	CVirtualNet myVirtualNet;
 	for ( netId_t net_it = 0; net_it < netCount; net_it++ ) {
-		simNet_v[net_it](simNet_v, net_it); // recalculate final values
+		myVirtualNet(simNet_v, net_it); // recalculate final values
 	}
 	isFixedSimNet = true;
 	simNet_v.ClearUpdateArray();
 }
 
 void CCvcDb::CheckConnections() {
-	static CVirtualNet myVirtualNet;
-	static CVirtualNet myMinNet;
-	static CVirtualNet myMaxNet;
+	CVirtualNet myVirtualNet;
+	CVirtualNet myMinNet;
+	CVirtualNet myMaxNet;
 	unordered_map<netId_t, pair<deviceId_t, deviceId_t>> myBulkCount;
 	for (deviceId_t device_it = 0; device_it < deviceCount; device_it++) {
 		if ( bulkNet_v[device_it] == UNKNOWN_NET ) continue;
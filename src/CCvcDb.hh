@@ -36,8 +36,12 @@ class CCvcDb;
 #include "CCvcParameters.hh"
 #include "CConnectionCount.hh"
 #include "CConnection.hh"
+#include "CDeviceIdAdjacency.hh"
 #include "CDependencyMap.hh"
+#include "CErrorBuffer.hh"
+#include "CErrorDatabase.hh"
 #include "gzstream.h"
+#include <atomic>
 
 extern char RESISTOR_TEXT[];
 extern CNetIdSet EmptySet;
@@ -46,11 +50,24 @@ class CShortVector : public vector<pair<netId_t, string> > {
 public:
 };
 
-class CNetMap : public unordered_map<netId_t, forward_list<netId_t>> {
+class CDeviceError {
+	// device check result. errorIndex is a cvcError_t, flags are deviceCheck_t.
 public:
-	CNetMap(float theLoadFactor = DEFAULT_LOAD_FACTOR) {max_load_factor(theLoadFactor);}
+	deviceId_t	deviceId;
+	unsigned char	errorIndex;
+	unsigned char	flags;
+
+	CDeviceError(deviceId_t theDeviceId, cvcError_t theErrorIndex, int theFlags) : deviceId(theDeviceId), errorIndex(theErrorIndex), flags(theFlags) {};
 };
 
+typedef vector<CDeviceError> CDeviceErrorVector;
+
+// cell error count key: 29 bit circuit id of the limit cell, 32 bit circuit device id, 3 bit error sub index
+#define CellErrorKey_(theCircuitId, theCircuitDeviceId, theSubIndex) \
+	((uint64_t(theCircuitId) << 35) | (uint64_t(theCircuitDeviceId) << 3) | uint64_t(theSubIndex))
+
+typedef unordered_map<uint64_t, deviceId_t> CCellErrorCountMap;  // errors per device in cells with error limits
+
 class CCvcDb {
 public:
 	int	cvcArgIndex = 1;
@@ -64,7 +81,7 @@ public:
 	CCircuit *	topCircuit_p;
 	//CShortVector	short_v;
 
-	CInstancePtrVector instancePtr_v;
+	CInstanceVector instancePtr_v;
 
 	// parent instance.	 Use offset from first in instance to find name, etc.
 	// [*] = instance
@@ -83,6 +100,11 @@ public:
 	CDeviceIdVector	firstDrain_v;
 //	CDeviceIdVector	firstBulk_v;
 
+	// [net] = devices, rebuilt from first/next lists after merges
+	CDeviceIdAdjacency	sourceAdjacency;
+	CDeviceIdAdjacency	gateAdjacency;
+	CDeviceIdAdjacency	drainAdjacency;
+
 	// [device] = net
 	CNetIdVector	sourceNet_v;
 	CNetIdVector	gateNet_v;
@@ -100,6 +122,8 @@ public:
 	CVirtualNetVector	minNet_v;
 	CVirtualNetVector	simNet_v;
 	CVirtualNetVector	maxNet_v;
+	// [net] = power definition after SetModePower. only set when using CVC_POWER_STATE_FILE.
+	map<netId_t, string>	powerState;
 
 	bool isDeviceModelSet = false;
 	bool isFixedMinNet, isFixedSimNet, isFixedMaxNet;
@@ -117,7 +141,9 @@ public:
 //	CPowerPtrVector	logicVoltagePtr_v;
 
 	bool	isFixedEquivalentNet;
-	CNetIdVector	equivalentNet_v;
+	CNetIdVector	equivalentNet_v;  // union-find parent until fixed, then final equivalent net
+	CNetIdVector	leastEquivalentNet_v;  // [root] = least net in equivalence class
+	vector<unsigned char>	equivalentNetRank_v;
 	CNetIdVector	inverterNet_v; // inverterNet_v[1] = 2 means 2 -|>o- 1
 	vector<bool>	highLow_v;
 
@@ -140,13 +166,15 @@ public:
 	voltage_t	maxPower = MIN_VOLTAGE;
 
 	size_t	errorCount[ERROR_TYPE_COUNT];
+	CDeviceErrorVector	deviceError_v;  // from the last ScanDeviceErrors in device order
 
 	CDependencyMap minConnectionDependencyMap;
 	CDependencyMap maxConnectionDependencyMap;
 
 	map<netId_t, string> calculatedResistanceInfo_v;
 
-	unordered_map<string, deviceId_t> cellErrorCountMap;
+	CCellErrorCountMap cellErrorCountMap;
+	CInstanceIdVector errorLimitAncestor_v;  // nearest instance with a cell error limit, 0 if none. Empty without a limit file.
 
 	forward_list<string> inverterInputOutputCheckList;  // list of nets to check for matched input/output
 	forward_list<pair<string, string>> oppositeLogicList;  // list of nets to check for opposite logic
@@ -155,10 +183,14 @@ public:
 	ofstream logFile;
 	teestream reportFile;  // simultaneous output to stdout and logFile
 	ogzstream debugFile;
+	CErrorDatabase errorDatabase;  // binary copy of device errors when CVC_ERROR_DATABASE is set
 
 	string lockFile;
 	string reportPrefix;
 
+	int	checkpointStage = 0;  // save database after this stage (--checkpoint)
+	int	resumeStage = 0;  // restore database saved after this stage (--resume-from)
+
 	typedef struct mos_data {
 		netId_t gate;
 		netId_t source;
@@ -178,11 +210,14 @@ public:
 	void ResetMinSimMaxAndQueues();
 	CPower * SetMasterPower(netId_t theFirstNet, netId_t theSecondNet, bool & theSamePowerFlag);
 	netId_t MasterPowerNet(netId_t theFirstNetId, netId_t theSecondNetId);
-	void MakeEquivalentNets(CNetMap & theNetMap, netId_t theFirstNetId, netId_t theSecondNetId, deviceId_t theDeviceId);
+	void MakeEquivalentNets(netId_t theFirstNetId, netId_t theSecondNetId, deviceId_t theDeviceId);
+	void UnionSwitchNets(vector<CDevice *> & theSwitch_v, vector<atomic<netId_t>> & theComponent_v);
+	void FixEquivalentNets();
 	void SetEquivalentNets();
 	void LinkDevices();
 	returnCode_t SetDeviceModels();
-	void DumpConnectionList(string theHeading, CDeviceIdVector& theFirstDevice_v, CDeviceIdVector& theNextDevice_v);
+	void BuildConnectionAdjacency(bool theReleaseLists);
+	void DumpConnectionList(string theHeading, CDeviceIdAdjacency& theAdjacency);
 
 	void DumpConnectionLists(string theHeading);
 
@@ -206,7 +241,7 @@ public:
 	bool LockReport(bool theInteractiveFlag);
 	void RemoveLock();
 	void SetSCRCPower();
-	size_t SetSCRCGatePower(netId_t theNetId, CDeviceIdVector & theFirstSource_v, CDeviceIdVector & theNextSource_v, CNetIdVector & theDrain_v,
+	size_t SetSCRCGatePower(netId_t theNetId, CDeviceIdAdjacency & theSourceAdjacency, CNetIdVector & theDrain_v,
 			size_t & theSCRCSignalCount, size_t & theSCRCIgnoreCount, bool theNoCheckFlag);
 	void SetSCRCParentPower(netId_t theNetId, deviceId_t theDeviceId, bool theExpectedHighInput, size_t & theSCRCSignalCount, size_t & theSCRCIgnoreCount);
 	bool IsSCRCLogicNet(netId_t theNetId);
@@ -214,7 +249,7 @@ public:
 	bool SetLatchPower(int thePassCount, vector<bool> & theIgnoreNet_v, CNetIdSet & theNewNetSet);
 	void FindLatchDevices(netId_t theNetId, mosData_t theNmosData_v[], mosData_t thePmosData_v[], int & theNmosCount, int & thePmosCount,
 		voltage_t theMinVoltage, voltage_t theMaxVoltage,
-		CDeviceIdVector & theFirstDrain_v, CDeviceIdVector & theNextDrain_v, CNetIdVector & theSourceNet_v);
+		CDeviceIdAdjacency & theDrainAdjacency, CNetIdVector & theSourceNet_v);
 	bool IsOppositeLogic(netId_t theFirstNet, netId_t theSecondNet);
 	void PrintInputNetsWithMinMaxSuggestions(netId_t theNetId);
 	void PrintNetSuggestions();
@@ -223,19 +258,41 @@ public:
 	void LoadNetChecks();
 	void LoadModelChecks();
 
+	// powerstate
+	string PowerStateFilename();
+	string PowerStateHeader();
+	void SetPowerState();
+	void ReportPowerChanges();
+	void SavePowerState();
+
+	// checkpoint
+	string CheckpointFilename(int theStage);
+	string CheckpointHeader(int theStage);
+	void SaveCheckpoint(int theStage);
+	void LoadCheckpoint(int theStage);
+
 	// error
 	void PrintFuseError(netId_t theTargetNetId, CConnection & theConnections);
 	void PrintMinVoltageConflict(netId_t theTargetNetId, CConnection & theMinConnections, voltage_t theExpectedVoltage, float theLeakCurrent);
 	void PrintMaxVoltageConflict(netId_t theTargetNetId, CConnection & theMaxConnections, voltage_t theExpectedVoltage, float theLeakCurrent);
-	void FindVbgError(ogzstream & theErrorFile, voltage_t theParameter, CFullConnection & theConnections, instanceId_t theInstance_p, string theDisplayParameter);
-	void FindVbsError(ogzstream & theErrorFile, voltage_t theParameter, CFullConnection & theConnections, instanceId_t theInstance_p, string theDisplayParameter);
-	void FindVdsError(ogzstream & theErrorFile, voltage_t theParameter, CFullConnection & theConnections, instanceId_t theInstance_p, string theDisplayParameter);
-	void FindVgsError(ogzstream & theErrorFile, voltage_t theParameter, CFullConnection & theConnections, instanceId_t theInstance_p, string theDisplayParameter);
-	void FindModelError(ogzstream & theErrorFile, CModelCheck &theCheck, CFullConnection & theConnections, instanceId_t theInstanceId);
-	void PrintOverVoltageError(ogzstream & theErrorFile, CFullConnection & theConnections, cvcError_t theErrorIndex, string theExplanation, instanceId_t theInstance_p);
-	void PrintModelError(ogzstream & theErrorFile, CFullConnection & theConnections, CModelCheck & theCheck, instanceId_t theInstanceId);
+	void FindVbgError(ostream & theErrorFile, voltage_t theParameter, CFullConnection & theConnections, instanceId_t theInstance_p, string theDisplayParameter);
+	void FindVbsError(ostream & theErrorFile, voltage_t theParameter, CFullConnection & theConnections, instanceId_t theInstance_p, string theDisplayParameter);
+	void FindVdsError(ostream & theErrorFile, voltage_t theParameter, CFullConnection & theConnections, instanceId_t theInstance_p, string theDisplayParameter);
+	void FindVgsError(ostream & theErrorFile, voltage_t theParameter, CFullConnection & theConnections, instanceId_t theInstance_p, string theDisplayParameter);
+	void FindModelError(ostream & theErrorFile, CModelCheck &theCheck, CFullConnection & theConnections, instanceId_t theInstanceId);
+	void PrintOverVoltageError(ostream & theErrorFile, CFullConnection & theConnections, cvcError_t theErrorIndex, string theExplanation, instanceId_t theInstance_p);
+	void PrintModelError(ostream & theErrorFile, CFullConnection & theConnections, CModelCheck & theCheck, instanceId_t theInstanceId);
 	void FindAllOverVoltageErrors();
-	void AppendErrorFile(string theTempFileName, string theHeading, int theErrorSubIndex);
+	void AppendErrorFile(CErrorStream & theErrors, string theHeading, int theErrorSubIndex);
+	void RecordError(int theErrorIndex, instanceId_t theParentId, CFullConnection & theConnections);
+	void ScanDeviceErrors(stage_t theStage);
+	int CheckNmosGateVsSource(CFullConnection & theConnections);
+	int CheckPmosGateVsSource(CFullConnection & theConnections);
+	int CheckNmosSourceVsBulk(CFullConnection & theConnections);
+	int CheckPmosSourceVsBulk(CFullConnection & theConnections);
+	int CheckForwardBiasDiode(CFullConnection & theConnections, bool theLogFlag);
+	int CheckNmosPossibleLeak(CFullConnection & theConnections);
+	int CheckPmosPossibleLeak(CFullConnection & theConnections);
 	void FindNmosGateVsSourceErrors();
 	void FindPmosGateVsSourceErrors();
 	void FindNmosSourceVsBulkErrors();
@@ -270,7 +327,7 @@ public:
 	bool TopologicallyOffMos(eventQueue_t theQueueType, modelType_t theModelType, CConnection& theConnections);
 
 	bool IsOffMos(eventQueue_t theQueueType, deviceId_t theDeviceId, CConnection& theConnections, voltage_t theVoltage);
-	void EnqueueAttachedDevicesByTerminal(CEventQueue& theEventQueue, netId_t theNetId, CDeviceIdVector& theFirstDevice_v, CDeviceIdVector& theNextDevice_v, eventKey_t theEventKey);
+	void EnqueueAttachedDevicesByTerminal(CEventQueue& theEventQueue, netId_t theNetId, CDeviceIdAdjacency& theAdjacency, eventKey_t theEventKey);
 	void EnqueueAttachedDevices(CEventQueue& theEventQueue, netId_t theNetId, eventKey_t theEventKey);
 	void PropagateMinMaxVoltages(CEventQueue& theEventQueue);
 	bool CheckEstimateDependency(CDependencyMap& theDependencyMap, size_t theEstimateType, list<netId_t>& theDependencyList);
@@ -279,10 +336,10 @@ public:
 	void ResetMinMaxActiveStatus();
 	void SetInitialMinMaxPower();
 	void ShiftVirtualNets(CEventQueue& theEventQueue, netId_t theNetId, CVirtualNet& theLastVirtualNet, resistance_t theNewResistance, resistance_t theOldResistance);
-	void RecalculateFinalResistance(CEventQueue& theEventQueue, netId_t theNewNetId, bool theRecursingFlag = false);
+	void RecalculateFinalResistance(CEventQueue& theEventQueue, netId_t theNewNetId);
 
 
-	void EnqueueAttachedResistorsByTerminal(CEventQueue& theEventQueue, netId_t theNetId, CDeviceIdVector& theFirstDevice_v, CDeviceIdVector& theNextDevice_v, eventKey_t theEventKey, queuePosition_t theQueuePosition);
+	void EnqueueAttachedResistorsByTerminal(CEventQueue& theEventQueue, netId_t theNetId, CDeviceIdAdjacency& theAdjacency, eventKey_t theEventKey, queuePosition_t theQueuePosition);
 	void EnqueueAttachedResistors(CEventQueue& theEventQueue, netId_t theNetId, eventKey_t theEventKey, queuePosition_t theQueuePosition);
 	bool CheckConnectionReroute(CEventQueue& theEventQueue, CConnection& theConnections, shortDirection_t theDirection);
 	bool IsPriorityDevice(CEventQueue& theEventQueue, modelType_t theModel);
@@ -295,13 +352,13 @@ public:
 	void PropagateSimVoltages(CEventQueue& theEventQueue, propagation_t thePropagationType);
 	void CalculateResistorVoltage(netId_t theNetId, voltage_t theMinVoltage, resistance_t theMinResistance,
 			voltage_t theMaxVoltage, resistance_t theMaxResistance );
-	void PropagateResistorCalculations(netId_t theNetId, CDeviceIdVector& theFirstDevice_v, CDeviceIdVector& theNextDevice_v);
+	void PropagateResistorCalculations(netId_t theNetId, CDeviceIdAdjacency& theAdjacency);
 	void CalculateResistorVoltages();
 	void SetResistorVoltagesByPower();
 	void ResetMinMaxPower();
 	void SetAnalogNets();
 	void PropagateAnalogNetType(netId_t theNetId, int theGateCount);
-	void PropagateAnalogNetTypeByTerminal(netId_t theNetId, CDeviceIdVector& theFirstDevice_v, CDeviceIdVector& theNextDevice_v, int theGateCount);
+	void PropagateAnalogNetTypeByTerminal(netId_t theNetId, CDeviceIdAdjacency& theAdjacency, int theGateCount);
 	void IgnoreUnusedDevices();
 	void SetSimPower(propagation_t thePropagationType, CNetIdSet & theNewNetSet = EmptySet);
 
@@ -321,7 +378,7 @@ public:
 	voltage_t MaxSimVoltage(netId_t theNetId);
 	resistance_t MaxResistance(netId_t theNetId);
 	voltage_t MaxLeakVoltage(netId_t theNetId);
-	netId_t GetGreatestEquivalentNet(netId_t theNetId);
+	netId_t FindEquivalentRoot(netId_t theNetId);
 	netId_t GetLeastEquivalentNet(netId_t theNetId);
 	netId_t GetEquivalentNet(netId_t theNetId);
 	list<string> * SplitHierarchy(string theFullPath);
@@ -336,7 +393,7 @@ public:
 	void MapDeviceNets(deviceId_t theDeviceId, CEventQueue& theEventQueue, CConnection& theConnections);
 	void MapDeviceNets(deviceId_t theDeviceId, CFullConnection& theConnections);
 	void MapDeviceSourceDrainNets(deviceId_t theDeviceId, CFullConnection& theConnections);
-	void MapDeviceNets(CInstance * theInstance_p, CDevice * theDevice_p, CFullConnection& theConnections);
+	void MapDeviceNets(CInstance * theInstance_p, CDevice * theDevice_p, CFullConnection& theConnections, long * theAccessCount_p = NULL);
 
 	void IgnoreDevice(deviceId_t theDeviceId);
 	bool EqualMasterNets(CVirtualNetVector& theVirtualNet_v, netId_t theFirstNetId, netId_t theSecondNetId);
@@ -372,7 +429,7 @@ public:
 	deviceId_t GetAttachedDevice(netId_t theNetId, modelType_t theType, terminal_t theTerminal);
 	deviceId_t FindInverterDevice(netId_t theInputNet, netId_t theOutputNet, modelType_t theType);
 	returnCode_t FindUniqueMosInputs(netId_t theOutputNet, netId_t theGroundNet, netId_t thePowerNet,
-		CDeviceIdVector &theFirst_v, CDeviceIdVector &theNext_v, CNetIdVector &theSourceNet_v, CNetIdVector &theDrainNet_v,
+		CDeviceIdAdjacency &theAdjacency, CNetIdVector &theSourceNet_v, CNetIdVector &theDrainNet_v,
 		netId_t &theNmosInput, netId_t &thePmosInput);
 	deviceId_t FindInverterInput(netId_t theOutputNet);
 	bool IsOnGate(deviceId_t theDevice, CPower * thePower_p);
@@ -395,12 +452,13 @@ public:
 	void PrintEquivalentNets(string theIndentation);
 	void PrintInverterNets(string theIndentation);
 	void PrintFlatCdl();
+	void PrintCellContexts();
 	void PrintHierarchicalCdl(CCircuit *theCircuit, unordered_set<text_t> & thePrintedList, ostream & theCdlFile);
 	void PrintNewCdlLine(const string theData, ostream & theOutput = cout);
 	void PrintNewCdlLine(const text_t theData, ostream & theOutput = cout);
 	void PrintNewCdlLine(const char theData, ostream & theOutput = cout);
 	void PrintSourceDrainConnections(CStatus& theConnectionStatus, string theIndentation);
-	void PrintConnections(deviceId_t theDeviceCount, deviceId_t theDeviceId, CDeviceIdVector& theNextDeviceId_v, string theIndentation = "", string theHeading = "Connections>");
+	void PrintConnections(deviceId_t theDeviceCount, netId_t theNetId, CDeviceIdAdjacency& theAdjacency, string theIndentation = "", string theHeading = "Connections>");
 	void PrintBulkConnections(netId_t theNetId, string theIndentation, string theHeading);
 
 	void PrintCdlLine(const string theData, ostream & theOutput = cout, const unsigned int theMaxLength = 80);
@@ -415,11 +473,11 @@ public:
 	string PrintVoltage(voltage_t theVoltage);
 	string PrintVoltage(voltage_t theVoltage, CPower * thePower_p);
 
-	void PrintDeviceWithAllConnections(instanceId_t theInstanceId, CFullConnection& theConnections, ogzstream& theErrorFile, bool theIncludeLeakVoltage = false);
-	void PrintDeviceWithSimConnections(instanceId_t theParentId, CFullConnection& theConnections, ogzstream& theErrorFile);
+	void PrintDeviceWithAllConnections(instanceId_t theInstanceId, CFullConnection& theConnections, ostream& theErrorFile, bool theIncludeLeakVoltage = false);
+	void PrintDeviceWithSimConnections(instanceId_t theParentId, CFullConnection& theConnections, ostream& theErrorFile);
 
-	void PrintAllTerminalConnections(terminal_t theTerminal, CFullConnection& theConnections, ogzstream& theErrorFile, bool theIncludeLeakVoltage = false);
-	void PrintSimTerminalConnections(terminal_t theTerminal, CFullConnection& theConnections, ogzstream& theErrorFile);
+	void PrintAllTerminalConnections(terminal_t theTerminal, CFullConnection& theConnections, ostream& theErrorFile, bool theIncludeLeakVoltage = false);
+	void PrintSimTerminalConnections(terminal_t theTerminal, CFullConnection& theConnections, ostream& theErrorFile);
 	void PrintErrorTotals();
 	//void PrintShortedNets(string theShortFileName);
 	string NetVoltageSuffix(string theDelimiter, string theVoltage, resistance_t theResistance, string theLeakVoltage = "");
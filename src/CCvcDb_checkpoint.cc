@@ -0,0 +1,550 @@
+/*
+ * CCvcDb_checkpoint.cc
+ *
+ * Copyright 2014-2026 D. Mitch Bailey  cvc at shuharisystem dot com
+ *
+ * This file is part of cvc.
+ *
+ * cvc is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cvc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with cvc.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * You can download cvc from https://github.com/d-m-bailey/cvc.git
+ */
+
+#include "Cvc.hh"
+#include "CCvcDb.hh"
+#include "CCvcParameters.hh"
+#include "CCircuit.hh"
+#include "CPower.hh"
+
+extern long gVirtualNetUpdateCount;
+extern long gVirtualNetAccessCount;
+
+/// \file
+/// Database snapshots at stage boundaries (--checkpoint, --resume-from)
+
+#define CHECKPOINT_HEADER "#CVC checkpoint 2 "
+#define CHECKPOINT_TRAILER "#CVC checkpoint end"
+
+#define NULL_POWER_INDEX UINT32_MAX
+
+// power text is saved by value and re-interned in CPower::powerDefinitionText on load
+enum checkpointText_t : unsigned char { CHECKPOINT_NULL_TEXT = 0, CHECKPOINT_BLANK_TEXT, CHECKPOINT_STRING_TEXT };
+
+template <typename T>
+static void WriteValue(ofstream & theFile, const T & theValue) {
+	static_assert(is_trivially_copyable<T>::value, "checkpoint values must be trivially copyable");
+	theFile.write(reinterpret_cast<const char *>(&theValue), sizeof(T));
+}
+
+template <typename T>
+static void ReadValue(ifstream & theFile, T & theValue) {
+	static_assert(is_trivially_copyable<T>::value, "checkpoint values must be trivially copyable");
+	if ( ! theFile.read(reinterpret_cast<char *>(&theValue), sizeof(T)) ) throw EFatalError("checkpoint file is truncated");
+}
+
+static void WriteString(ofstream & theFile, const string & theString) {
+	WriteValue(theFile, uint64_t(theString.size()));
+	theFile.write(theString.data(), theString.size());
+}
+
+static void ReadString(ifstream & theFile, string & theString) {
+	uint64_t mySize;
+	ReadValue(theFile, mySize);
+	theString.resize(mySize);
+	if ( mySize > 0 && ! theFile.read(&theString[0], mySize) ) throw EFatalError("checkpoint file is truncated");
+}
+
+template <typename T, typename A>
+static void WriteVector(ofstream & theFile, const vector<T, A> & theVector) {
+	static_assert(is_trivially_copyable<T>::value, "checkpoint vectors must be trivially copyable");
+	WriteValue(theFile, uint64_t(theVector.size()));
+	theFile.write(reinterpret_cast<const char *>(theVector.data()), theVector.size() * sizeof(T));
+}
+
+template <typename T, typename A>
+static void ReadVector(ifstream & theFile, vector<T, A> & theVector) {
+	static_assert(is_trivially_copyable<T>::value, "checkpoint vectors must be trivially copyable");
+	uint64_t mySize;
+	ReadValue(theFile, mySize);
+	vector<T, A>().swap(theVector);
+	theVector.resize(mySize);
+	if ( mySize > 0 && ! theFile.read(reinterpret_cast<char *>(theVector.data()), mySize * sizeof(T)) ) throw EFatalError("checkpoint file is truncated");
+}
+
+static void WriteText(ofstream & theFile, text_t theText) {
+	if ( theText == NULL ) {
+		WriteValue(theFile, CHECKPOINT_NULL_TEXT);
+	} else if ( theText == CPower::powerDefinitionText.BlankTextAddress() ) {
+		WriteValue(theFile, CHECKPOINT_BLANK_TEXT);
+	} else {
+		WriteValue(theFile, CHECKPOINT_STRING_TEXT);
+		WriteString(theFile, string(theText));
+	}
+}
+
+static text_t ReadText(ifstream & theFile) {
+	checkpointText_t myType;
+	ReadValue(theFile, myType);
+	if ( myType == CHECKPOINT_NULL_TEXT ) return NULL;
+	if ( myType == CHECKPOINT_BLANK_TEXT ) return CPower::powerDefinitionText.BlankTextAddress();
+	string myText;
+	ReadString(theFile, myText);
+	return CPower::powerDefinitionText.SetTextAddress(myText.c_str(), myText.size());
+}
+
+static void WriteDependencyMap(ofstream & theFile, CDependencyMap & theMap) {
+	WriteValue(theFile, uint64_t(theMap.size()));
+	for ( auto net_pit = theMap.begin(); net_pit != theMap.end(); net_pit++ ) {
+		WriteValue(theFile, net_pit->first);
+		WriteValue(theFile, uint64_t(net_pit->second.size()));
+		for ( auto dependent_it = net_pit->second.begin(); dependent_it != net_pit->second.end(); dependent_it++ ) {
+			WriteValue(theFile, *dependent_it);
+		}
+	}
+}
+
+static void ReadDependencyMap(ifstream & theFile, CDependencyMap & theMap) {
+	uint64_t myMapSize, myListSize;
+	netId_t myNetId, myDependentNetId;
+	theMap.clear();
+	ReadValue(theFile, myMapSize);
+	for ( uint64_t map_it = 0; map_it < myMapSize; map_it++ ) {
+		ReadValue(theFile, myNetId);
+		ReadValue(theFile, myListSize);
+		list<netId_t> & myList = theMap[myNetId];
+		for ( uint64_t list_it = 0; list_it < myListSize; list_it++ ) {
+			ReadValue(theFile, myDependentNetId);
+			myList.push_back(myDependentNetId);
+		}
+	}
+}
+
+static void WriteVirtualNets(ofstream & theFile, CVirtualNetVector & theVirtualNet_v) {
+	WriteVector(theFile, static_cast<CBaseVirtualNetVector &>(theVirtualNet_v));
+	WriteVector(theFile, theVirtualNet_v.finalNetId_v);
+	WriteVector(theFile, theVirtualNet_v.finalResistance_v);
+	WriteVector(theFile, theVirtualNet_v.lastUpdate_v);
+	WriteVector(theFile, theVirtualNet_v.backupNetId_v);
+	WriteValue(theFile, theVirtualNet_v.lastUpdate);
+}
+
+static void ReadVirtualNets(ifstream & theFile, CVirtualNetVector & theVirtualNet_v) {
+	ReadVector(theFile, static_cast<CBaseVirtualNetVector &>(theVirtualNet_v));
+	ReadVector(theFile, theVirtualNet_v.finalNetId_v);
+	ReadVector(theFile, theVirtualNet_v.finalResistance_v);
+	ReadVector(theFile, theVirtualNet_v.lastUpdate_v);
+	ReadVector(theFile, theVirtualNet_v.backupNetId_v);
+	ReadValue(theFile, theVirtualNet_v.lastUpdate);
+	// routes are a cache and are rebuilt on demand
+	vector<uint32_t, CSpillAllocator<uint32_t>>().swap(theVirtualNet_v.routeEpoch_v);
+	theVirtualNet_v.routeEpoch = theVirtualNet_v.validEpoch = 1;
+}
+
+static void WriteEventQueue(ofstream & theFile, CEventQueue & theEventQueue) {
+	// queues are empty between stages. only the counts are kept.
+	if ( ! ( theEventQueue.mainQueue.empty() && theEventQueue.delayQueue.empty() ) ) {
+		throw EFatalError("checkpoint with pending events");
+	}
+	WriteValue(theFile, theEventQueue.queueStart);
+	WriteValue(theFile, theEventQueue.enqueueCount);
+	WriteValue(theFile, theEventQueue.dequeueCount);
+	WriteValue(theFile, theEventQueue.requeueCount);
+}
+
+static void ReadEventQueue(ifstream & theFile, CEventQueue & theEventQueue, deviceId_t theDeviceCount) {
+	eventKey_t myLastUpdate = theEventQueue.virtualNet_v.lastUpdate;
+	theEventQueue.ResetQueue(theDeviceCount);
+	theEventQueue.virtualNet_v.lastUpdate = myLastUpdate;
+	ReadValue(theFile, theEventQueue.queueStart);
+	ReadValue(theFile, theEventQueue.enqueueCount);
+	ReadValue(theFile, theEventQueue.dequeueCount);
+	ReadValue(theFile, theEventQueue.requeueCount);
+}
+
+static void WritePower(ofstream & theFile, CPower * thePower_p) {
+	WriteValue(theFile, thePower_p->minVoltage);
+	WriteValue(theFile, thePower_p->simVoltage);
+	WriteValue(theFile, thePower_p->maxVoltage);
+	WriteValue(theFile, thePower_p->powerId);
+	WriteValue(theFile, thePower_p->netId);
+	WriteValue(theFile, thePower_p->defaultMinNet);
+	WriteValue(theFile, thePower_p->defaultSimNet);
+	WriteValue(theFile, thePower_p->defaultMaxNet);
+	WriteText(theFile, thePower_p->definition);
+	WriteValue(theFile, thePower_p->type);
+	WriteValue(theFile, thePower_p->active);
+	WriteValue(theFile, thePower_p->minCalculationType);
+	WriteValue(theFile, thePower_p->simCalculationType);
+	WriteValue(theFile, thePower_p->maxCalculationType);
+	WriteValue(theFile, thePower_p->relativeFriendly);
+	WriteValue(theFile, thePower_p->flagAllShorts);
+	CExtraPowerData * myExtraData_p = thePower_p->extraData;
+	WriteValue(theFile, bool(myExtraData_p));
+	if ( ! myExtraData_p ) return;
+	WriteString(theFile, myExtraData_p->expectedSim);
+	WriteString(theFile, myExtraData_p->expectedMin);
+	WriteString(theFile, myExtraData_p->expectedMax);
+	WriteString(theFile, myExtraData_p->family);
+	WriteString(theFile, myExtraData_p->implicitFamily);
+	WriteValue(theFile, uint64_t(myExtraData_p->relativeSet.size()));
+	for ( auto relative_pit = myExtraData_p->relativeSet.begin(); relative_pit != myExtraData_p->relativeSet.end(); relative_pit++ ) {
+		WriteText(theFile, *relative_pit);
+	}
+	WriteText(theFile, myExtraData_p->powerSignal);
+	WriteText(theFile, myExtraData_p->powerAlias);
+	WriteValue(theFile, myExtraData_p->pullDownVoltage);
+	WriteValue(theFile, myExtraData_p->pullUpVoltage);
+}
+
+static CPower * ReadPower(ifstream & theFile) {
+	CPower * myPower_p = new CPower();
+	ReadValue(theFile, myPower_p->minVoltage);
+	ReadValue(theFile, myPower_p->simVoltage);
+	ReadValue(theFile, myPower_p->maxVoltage);
+	ReadValue(theFile, myPower_p->powerId);
+	ReadValue(theFile, myPower_p->netId);
+	ReadValue(theFile, myPower_p->defaultMinNet);
+	ReadValue(theFile, myPower_p->defaultSimNet);
+	ReadValue(theFile, myPower_p->defaultMaxNet);
+	myPower_p->definition = ReadText(theFile);
+	ReadValue(theFile, myPower_p->type);
+	ReadValue(theFile, myPower_p->active);
+	ReadValue(theFile, myPower_p->minCalculationType);
+	ReadValue(theFile, myPower_p->simCalculationType);
+	ReadValue(theFile, myPower_p->maxCalculationType);
+	ReadValue(theFile, myPower_p->relativeFriendly);
+	ReadValue(theFile, myPower_p->flagAllShorts);
+	bool myHasExtraData;
+	ReadValue(theFile, myHasExtraData);
+	if ( ! myHasExtraData ) return myPower_p;
+	CExtraPowerData * myExtraData_p = myPower_p->extraData = new CExtraPowerData;
+	ReadString(theFile, myExtraData_p->expectedSim);
+	ReadString(theFile, myExtraData_p->expectedMin);
+	ReadString(theFile, myExtraData_p->expectedMax);
+	ReadString(theFile, myExtraData_p->family);
+	ReadString(theFile, myExtraData_p->implicitFamily);
+	uint64_t myRelativeCount;
+	ReadValue(theFile, myRelativeCount);
+	for ( uint64_t relative_it = 0; relative_it < myRelativeCount; relative_it++ ) {
+		myExtraData_p->relativeSet.insert(ReadText(theFile));
+	}
+	myExtraData_p->powerSignal = ReadText(theFile);
+	myExtraData_p->powerAlias = ReadText(theFile);
+	ReadValue(theFile, myExtraData_p->pullDownVoltage);
+	ReadValue(theFile, myExtraData_p->pullUpVoltage);
+	return myPower_p;
+}
+
+static void IndexPower(CPower * thePower_p, vector<CPower *> & thePower_v, unordered_map<CPower *, uint32_t> & thePowerIndexMap) {
+	if ( thePower_p && thePowerIndexMap.emplace(thePower_p, thePower_v.size()).second ) {
+		thePower_v.push_back(thePower_p);
+	}
+}
+
+static void WritePowerList(ofstream & theFile, CPowerPtrList & thePowerList, unordered_map<CPower *, uint32_t> & thePowerIndexMap) {
+	WriteValue(theFile, uint64_t(thePowerList.size()));
+	for ( auto power_ppit = thePowerList.begin(); power_ppit != thePowerList.end(); power_ppit++ ) {
+		WriteValue(theFile, thePowerIndexMap.at(*power_ppit));
+	}
+}
+
+static void ReadPowerList(ifstream & theFile, CPowerPtrList & thePowerList, vector<CPower *> & thePower_v) {
+	uint64_t mySize;
+	uint32_t myIndex;
+	thePowerList.clear();
+	ReadValue(theFile, mySize);
+	for ( uint64_t power_it = 0; power_it < mySize; power_it++ ) {
+		ReadValue(theFile, myIndex);
+		thePowerList.push_back(thePower_v.at(myIndex));
+	}
+}
+
+static void WritePowerPtrVector(ofstream & theFile, CPowerPtrVector & thePowerPtr_v, unordered_map<CPower *, uint32_t> & thePowerIndexMap) {
+	vector<uint32_t> myIndex_v(thePowerPtr_v.size(), NULL_POWER_INDEX);
+	for ( size_t net_it = 0; net_it < thePowerPtr_v.size(); net_it++ ) {
+		if ( thePowerPtr_v[net_it].full ) myIndex_v[net_it] = thePowerIndexMap.at(thePowerPtr_v[net_it].full);
+	}
+	WriteVector(theFile, myIndex_v);
+	WriteVector(theFile, thePowerPtr_v.powerPtrType_v);
+}
+
+static void ReadPowerPtrVector(ifstream & theFile, CPowerPtrVector & thePowerPtr_v, vector<CPower *> & thePower_v) {
+	vector<uint32_t> myIndex_v;
+	ReadVector(theFile, myIndex_v);
+	thePowerPtr_v.ResetPowerPointerVector(myIndex_v.size());
+	for ( size_t net_it = 0; net_it < myIndex_v.size(); net_it++ ) {
+		if ( myIndex_v[net_it] != NULL_POWER_INDEX ) thePowerPtr_v[net_it].full = thePower_v.at(myIndex_v[net_it]);
+	}
+	ReadVector(theFile, thePowerPtr_v.powerPtrType_v);
+}
+
+string CCvcDb::CheckpointFilename(int theStage) {
+	return cvcParameters.cvcReportBaseFilename + ".stage" + to_string(theStage) + ".checkpoint";
+}
+
+string CCvcDb::CheckpointHeader(int theStage) {
+	// Netlist, models, fuses, settings and power file must match the run that saved the checkpoint.
+	stringstream myHeader;
+	myHeader << CHECKPOINT_HEADER << theStage << endl;
+	myHeader << PowerStateHeader();
+	myHeader << "power " << FileIdentity(cvcParameters.cvcPowerFilename) << endl;
+	myHeader << "cell error limit " << FileIdentity(cvcParameters.cvcCellErrorLimitFile) << endl;
+	myHeader << "size " << netCount << " " << deviceCount << " " << subcircuitCount << " " << cvcCircuitList.size() << endl;
+	return myHeader.str();
+}
+
+void CCvcDb::SaveCheckpoint(int theStage) {
+	// Saves everything later stages read that is not rebuilt by stage 1.
+	if ( theStage != checkpointStage ) return;
+	string myCheckpointFilename = CheckpointFilename(theStage);
+	string myTemporaryFilename = myCheckpointFilename + ".tmp";
+	reportFile << "CVC: Saving checkpoint after stage " << theStage << " to " << myCheckpointFilename << endl;
+	ofstream myCheckpointFile(myTemporaryFilename, ios::binary | ios::trunc);
+	if ( myCheckpointFile.fail() ) {
+		reportFile << "WARNING: Could not write checkpoint " << myCheckpointFilename << endl;
+		return;
+	}
+	WriteString(myCheckpointFile, CheckpointHeader(theStage));
+
+	WriteVector(myCheckpointFile, firstSource_v);
+	WriteVector(myCheckpointFile, firstGate_v);
+	WriteVector(myCheckpointFile, firstDrain_v);
+	WriteVector(myCheckpointFile, nextSource_v);
+	WriteVector(myCheckpointFile, nextGate_v);
+	WriteVector(myCheckpointFile, nextDrain_v);
+	WriteVector(myCheckpointFile, sourceAdjacency.offset_v);
+	WriteVector(myCheckpointFile, sourceAdjacency.device_v);
+	WriteVector(myCheckpointFile, gateAdjacency.offset_v);
+	WriteVector(myCheckpointFile, gateAdjacency.device_v);
+	WriteVector(myCheckpointFile, drainAdjacency.offset_v);
+	WriteVector(myCheckpointFile, drainAdjacency.device_v);
+	WriteVector(myCheckpointFile, sourceNet_v);
+	WriteVector(myCheckpointFile, gateNet_v);
+	WriteVector(myCheckpointFile, drainNet_v);
+	WriteVector(myCheckpointFile, bulkNet_v);
+	WriteVector(myCheckpointFile, deviceType_v);
+	WriteVector(myCheckpointFile, deviceStatus_v);
+	WriteVector(myCheckpointFile, netStatus_v);
+	WriteVector(myCheckpointFile, connectionCount_v);
+
+	WriteVirtualNets(myCheckpointFile, minNet_v);
+	WriteVirtualNets(myCheckpointFile, simNet_v);
+	WriteVirtualNets(myCheckpointFile, maxNet_v);
+	WriteValue(myCheckpointFile, gVirtualNetAccessCount);
+	WriteValue(myCheckpointFile, gVirtualNetUpdateCount);
+	WriteEventQueue(myCheckpointFile, minEventQueue);
+	WriteEventQueue(myCheckpointFile, simEventQueue);
+	WriteEventQueue(myCheckpointFile, maxEventQueue);
+
+	WriteValue(myCheckpointFile, isDeviceModelSet);
+	WriteValue(myCheckpointFile, isFixedMinNet);
+	WriteValue(myCheckpointFile, isFixedSimNet);
+	WriteValue(myCheckpointFile, isFixedMaxNet);
+	WriteValue(myCheckpointFile, leakVoltageSet);
+	WriteValue(myCheckpointFile, isValidShortData);
+	WriteValue(myCheckpointFile, isFixedEquivalentNet);
+	WriteVector(myCheckpointFile, equivalentNet_v);
+	WriteVector(myCheckpointFile, leastEquivalentNet_v);
+	WriteVector(myCheckpointFile, equivalentNetRank_v);
+	WriteVector(myCheckpointFile, inverterNet_v);
+	vector<unsigned char> myHighLow_v(highLow_v.begin(), highLow_v.end());
+	WriteVector(myCheckpointFile, myHighLow_v);
+
+	WriteValue(myCheckpointFile, uint64_t(mosDiodeSet.size()));
+	for ( auto device_pit = mosDiodeSet.begin(); device_pit != mosDiodeSet.end(); device_pit++ ) {
+		WriteValue(myCheckpointFile, *device_pit);
+	}
+	WriteValue(myCheckpointFile, uint64_t(unknownGateSet.size()));
+	for ( auto gate_pit = unknownGateSet.begin(); gate_pit != unknownGateSet.end(); gate_pit++ ) {
+		WriteString(myCheckpointFile, *gate_pit);
+	}
+	WriteDependencyMap(myCheckpointFile, minConnectionDependencyMap);
+	WriteDependencyMap(myCheckpointFile, maxConnectionDependencyMap);
+	WriteValue(myCheckpointFile, uint64_t(calculatedResistanceInfo_v.size()));
+	for ( auto info_pit = calculatedResistanceInfo_v.begin(); info_pit != calculatedResistanceInfo_v.end(); info_pit++ ) {
+		WriteValue(myCheckpointFile, info_pit->first);
+		WriteString(myCheckpointFile, info_pit->second);
+	}
+	WriteValue(myCheckpointFile, uint64_t(cellErrorCountMap.size()));
+	for ( auto cell_pit = cellErrorCountMap.begin(); cell_pit != cellErrorCountMap.end(); cell_pit++ ) {
+		WriteValue(myCheckpointFile, cell_pit->first);
+		WriteValue(myCheckpointFile, cell_pit->second);
+	}
+	for ( auto circuit_ppit = cvcCircuitList.begin(); circuit_ppit != cvcCircuitList.end(); circuit_ppit++ ) {
+		WriteVector(myCheckpointFile, (*circuit_ppit)->deviceErrorCount_v);
+		WriteVector(myCheckpointFile, (*circuit_ppit)->devicePrintCount_v);
+	}
+	WriteValue(myCheckpointFile, minPower);
+	WriteValue(myCheckpointFile, maxPower);
+	WriteValue(myCheckpointFile, lineLength);
+	WriteValue(myCheckpointFile, errorCount);
+
+	// power objects are shared between lists and nets, so each is saved once and referenced by index
+	vector<CPower *> myPower_v;
+	unordered_map<CPower *, uint32_t> myPowerIndexMap;
+	for ( auto power_ppit = cvcParameters.cvcPowerPtrList.begin(); power_ppit != cvcParameters.cvcPowerPtrList.end(); power_ppit++ ) {
+		IndexPower(*power_ppit, myPower_v, myPowerIndexMap);
+	}
+	for ( auto power_ppit = cvcParameters.cvcExpectedLevelPtrList.begin(); power_ppit != cvcParameters.cvcExpectedLevelPtrList.end(); power_ppit++ ) {
+		IndexPower(*power_ppit, myPower_v, myPowerIndexMap);
+	}
+	for ( auto power_pit = netVoltagePtr_v.begin(); power_pit != netVoltagePtr_v.end(); power_pit++ ) {
+		IndexPower(power_pit->full, myPower_v, myPowerIndexMap);
+	}
+	for ( auto power_pit = leakVoltagePtr_v.begin(); power_pit != leakVoltagePtr_v.end(); power_pit++ ) {
+		IndexPower(power_pit->full, myPower_v, myPowerIndexMap);
+	}
+	for ( auto power_pit = initialVoltagePtr_v.begin(); power_pit != initialVoltagePtr_v.end(); power_pit++ ) {
+		IndexPower(power_pit->full, myPower_v, myPowerIndexMap);
+	}
+	WriteValue(myCheckpointFile, CPower::powerCount);
+	WriteValue(myCheckpointFile, uint64_t(myPower_v.size()));
+	for ( auto power_ppit = myPower_v.begin(); power_ppit != myPower_v.end(); power_ppit++ ) {
+		WritePower(myCheckpointFile, *power_ppit);
+	}
+	WritePowerList(myCheckpointFile, cvcParameters.cvcPowerPtrList, myPowerIndexMap);
+	WritePowerList(myCheckpointFile, cvcParameters.cvcExpectedLevelPtrList, myPowerIndexMap);
+	WritePowerPtrVector(myCheckpointFile, netVoltagePtr_v, myPowerIndexMap);
+	WritePowerPtrVector(myCheckpointFile, leakVoltagePtr_v, myPowerIndexMap);
+	WritePowerPtrVector(myCheckpointFile, initialVoltagePtr_v, myPowerIndexMap);
+
+	WriteString(myCheckpointFile, CHECKPOINT_TRAILER);
+	myCheckpointFile.close();
+	if ( myCheckpointFile.fail() || rename(myTemporaryFilename.c_str(), myCheckpointFilename.c_str()) != 0 ) {
+		reportFile << "WARNING: Could not write checkpoint " << myCheckpointFilename << endl;
+		remove(myTemporaryFilename.c_str());
+	}
+}
+
+void CCvcDb::LoadCheckpoint(int theStage) {
+	// Replaces the stage 1 database with the one saved after theStage.
+	// Power objects from stage 1 are replaced, not deleted (see Cleanup).
+	string myCheckpointFilename = CheckpointFilename(theStage);
+	reportFile << "CVC: Resuming after stage " << theStage << " from " << myCheckpointFilename << endl;
+	ifstream myCheckpointFile(myCheckpointFilename, ios::binary);
+	if ( myCheckpointFile.fail() ) {
+		throw EFatalError("Could not open checkpoint " + myCheckpointFilename);
+	}
+	string myHeader;
+	ReadString(myCheckpointFile, myHeader);
+	if ( myHeader != CheckpointHeader(theStage) ) {
+		throw EFatalError("checkpoint " + myCheckpointFilename + " does not match current netlist, models, power or settings");
+	}
+
+	ReadVector(myCheckpointFile, firstSource_v);
+	ReadVector(myCheckpointFile, firstGate_v);
+	ReadVector(myCheckpointFile, firstDrain_v);
+	ReadVector(myCheckpointFile, nextSource_v);
+	ReadVector(myCheckpointFile, nextGate_v);
+	ReadVector(myCheckpointFile, nextDrain_v);
+	ReadVector(myCheckpointFile, sourceAdjacency.offset_v);
+	ReadVector(myCheckpointFile, sourceAdjacency.device_v);
+	ReadVector(myCheckpointFile, gateAdjacency.offset_v);
+	ReadVector(myCheckpointFile, gateAdjacency.device_v);
+	ReadVector(myCheckpointFile, drainAdjacency.offset_v);
+	ReadVector(myCheckpointFile, drainAdjacency.device_v);
+	ReadVector(myCheckpointFile, sourceNet_v);
+	ReadVector(myCheckpointFile, gateNet_v);
+	ReadVector(myCheckpointFile, drainNet_v);
+	ReadVector(myCheckpointFile, bulkNet_v);
+	ReadVector(myCheckpointFile, deviceType_v);
+	ReadVector(myCheckpointFile, deviceStatus_v);
+	ReadVector(myCheckpointFile, netStatus_v);
+	ReadVector(myCheckpointFile, connectionCount_v);
+
+	ReadVirtualNets(myCheckpointFile, minNet_v);
+	ReadVirtualNets(myCheckpointFile, simNet_v);
+	ReadVirtualNets(myCheckpointFile, maxNet_v);
+	ReadValue(myCheckpointFile, gVirtualNetAccessCount);
+	ReadValue(myCheckpointFile, gVirtualNetUpdateCount);
+	ReadEventQueue(myCheckpointFile, minEventQueue, deviceCount);
+	ReadEventQueue(myCheckpointFile, simEventQueue, deviceCount);
+	ReadEventQueue(myCheckpointFile, maxEventQueue, deviceCount);
+
+	ReadValue(myCheckpointFile, isDeviceModelSet);
+	ReadValue(myCheckpointFile, isFixedMinNet);
+	ReadValue(myCheckpointFile, isFixedSimNet);
+	ReadValue(myCheckpointFile, isFixedMaxNet);
+	ReadValue(myCheckpointFile, leakVoltageSet);
+	ReadValue(myCheckpointFile, isValidShortData);
+	ReadValue(myCheckpointFile, isFixedEquivalentNet);
+	ReadVector(myCheckpointFile, equivalentNet_v);
+	ReadVector(myCheckpointFile, leastEquivalentNet_v);
+	ReadVector(myCheckpointFile, equivalentNetRank_v);
+	ReadVector(myCheckpointFile, inverterNet_v);
+	vector<unsigned char> myHighLow_v;
+	ReadVector(myCheckpointFile, myHighLow_v);
+	highLow_v.assign(myHighLow_v.begin(), myHighLow_v.end());
+
+	uint64_t mySize;
+	deviceId_t myDeviceId;
+	netId_t myNetId;
+	string myText;
+	ReadValue(myCheckpointFile, mySize);
+	mosDiodeSet.clear();
+	for ( uint64_t device_it = 0; device_it < mySize; device_it++ ) {
+		ReadValue(myCheckpointFile, myDeviceId);
+		mosDiodeSet.insert(myDeviceId);
+	}
+	ReadValue(myCheckpointFile, mySize);
+	unknownGateSet.clear();
+	for ( uint64_t gate_it = 0; gate_it < mySize; gate_it++ ) {
+		ReadString(myCheckpointFile, myText);
+		unknownGateSet.insert(myText);
+	}
+	ReadDependencyMap(myCheckpointFile, minConnectionDependencyMap);
+	ReadDependencyMap(myCheckpointFile, maxConnectionDependencyMap);
+	ReadValue(myCheckpointFile, mySize);
+	calculatedResistanceInfo_v.clear();
+	for ( uint64_t info_it = 0; info_it < mySize; info_it++ ) {
+		ReadValue(myCheckpointFile, myNetId);
+		ReadString(myCheckpointFile, calculatedResistanceInfo_v[myNetId]);
+	}
+	ReadValue(myCheckpointFile, mySize);
+	cellErrorCountMap.clear();
+	uint64_t myCellErrorKey;
+	for ( uint64_t cell_it = 0; cell_it < mySize; cell_it++ ) {
+		ReadValue(myCheckpointFile, myCellErrorKey);
+		ReadValue(myCheckpointFile, cellErrorCountMap[myCellErrorKey]);
+	}
+	for ( auto circuit_ppit = cvcCircuitList.begin(); circuit_ppit != cvcCircuitList.end(); circuit_ppit++ ) {
+		ReadVector(myCheckpointFile, (*circuit_ppit)->deviceErrorCount_v);
+		ReadVector(myCheckpointFile, (*circuit_ppit)->devicePrintCount_v);
+	}
+	ReadValue(myCheckpointFile, minPower);
+	ReadValue(myCheckpointFile, maxPower);
+	ReadValue(myCheckpointFile, lineLength);
+	ReadValue(myCheckpointFile, errorCount);
+
+	netId_t myPowerCount;
+	ReadValue(myCheckpointFile, myPowerCount);
+	ReadValue(myCheckpointFile, mySize);
+	vector<CPower *> myPower_v;
+	myPower_v.reserve(mySize);
+	for ( uint64_t power_it = 0; power_it < mySize; power_it++ ) {
+		myPower_v.push_back(ReadPower(myCheckpointFile));
+	}
+	CPower::powerCount = myPowerCount;
+	ReadPowerList(myCheckpointFile, cvcParameters.cvcPowerPtrList, myPower_v);
+	ReadPowerList(myCheckpointFile, cvcParameters.cvcExpectedLevelPtrList, myPower_v);
+	ReadPowerPtrVector(myCheckpointFile, netVoltagePtr_v, myPower_v);
+	ReadPowerPtrVector(myCheckpointFile, leakVoltagePtr_v, myPower_v);
+	ReadPowerPtrVector(myCheckpointFile, initialVoltagePtr_v, myPower_v);
+
+	ReadString(myCheckpointFile, myText);
+	if ( myText != CHECKPOINT_TRAILER ) {
+		throw EFatalError("checkpoint " + myCheckpointFilename + " is corrupt");
+	}
+	reportFile << "INFO: errors found before stage " << theStage + 1 << " are not repeated in " << cvcParameters.cvcReportBaseFilename << ".error.gz" << endl;
+}
@@ -32,6 +32,10 @@
 #include "CEventQueue.hh"
 #include "CVirtualNet.hh"
 #include <stdio.h>
+#include <atomic>
+#include <thread>
+
+extern long gVirtualNetAccessCount;
 
 void CCvcDb::PrintFuseError(netId_t theTargetNetId, CConnection & theConnections) {
 	if ( IncrementDeviceError(theConnections.deviceId, FUSE_ERROR) < cvcParameters.cvcCircuitErrorLimit || cvcParameters.cvcCircuitErrorLimit == 0 ) {
@@ -48,6 +52,7 @@ void CCvcDb::PrintFuseError(netId_t theTargetNetId, CConnection & theConnections
 		} else {
 			errorFile << "; unknown fuse type" << endl;
 		}
+		RecordError(FUSE_ERROR, deviceParent_v[theConnections.deviceId], myFullConnections);
 		PrintDeviceWithAllConnections(deviceParent_v[theConnections.deviceId], myFullConnections, errorFile);
 		errorFile << endl;
 	}
@@ -63,6 +68,7 @@ void CCvcDb::PrintMinVoltageConflict(netId_t theTargetNetId, CConnection & theMi
 		errorFile << "! Min voltage already set for " << NetName(theTargetNetId, PRINT_CIRCUIT_ON, PRINT_HIERARCHY_OFF);
 		errorFile << " at mos diode: expected/found " << theExpectedVoltage << "/" << theMinConnections.gateVoltage;
 		errorFile << " estimated current " << AddSiSuffix(theLeakCurrent) << "A" << endl;
+		RecordError(MIN_VOLTAGE_CONFLICT, deviceParent_v[theMinConnections.deviceId], myFullConnections);
 		PrintDeviceWithAllConnections(deviceParent_v[theMinConnections.deviceId], myFullConnections, errorFile);
 		errorFile << endl;
 	}
@@ -78,12 +84,13 @@ void CCvcDb::PrintMaxVoltageConflict(netId_t theTargetNetId, CConnection & theMa
 		errorFile << "! Max voltage already set for " << NetName(theTargetNetId, PRINT_CIRCUIT_ON, PRINT_HIERARCHY_OFF);
 		errorFile << " at mos diode: expected/found " << theExpectedVoltage << "/" << theMaxConnections.gateVoltage;
 		errorFile << " estimated current " << AddSiSuffix(theLeakCurrent) << "A" << endl;
+		RecordError(MAX_VOLTAGE_CONFLICT, deviceParent_v[theMaxConnections.deviceId], myFullConnections);
 		PrintDeviceWithAllConnections(deviceParent_v[theMaxConnections.deviceId], myFullConnections, errorFile);
 		errorFile << endl;
 	}
 }
 
-void CCvcDb::FindVbgError(ogzstream & theErrorFile, voltage_t theParameter, CFullConnection & theConnections, instanceId_t theInstanceId, string theDisplayParameter) {
+void CCvcDb::FindVbgError(ostream & theErrorFile, voltage_t theParameter, CFullConnection & theConnections, instanceId_t theInstanceId, string theDisplayParameter) {
 	theParameter += cvcParameters.cvcOvervoltageErrorThreshold;
 	if ( ( theConnections.validMaxGate && theConnections.validMinBulk
 				&& abs(theConnections.maxGateVoltage - theConnections.minBulkVoltage) > theParameter )
@@ -108,7 +115,7 @@ void CCvcDb::FindVbgError(ogzstream & theErrorFile, voltage_t theParameter, CFul
 	}
 }
 
-void CCvcDb::FindVbsError(ogzstream & theErrorFile, voltage_t theParameter, CFullConnection & theConnections, instanceId_t theInstanceId, string theDisplayParameter) {
+void CCvcDb::FindVbsError(ostream & theErrorFile, voltage_t theParameter, CFullConnection & theConnections, instanceId_t theInstanceId, string theDisplayParameter) {
 	theParameter += cvcParameters.cvcOvervoltageErrorThreshold;
 	if ( ( theConnections.validMaxSource && theConnections.validMinBulk
 				&& abs(theConnections.maxSourceVoltage - theConnections.minBulkVoltage) > theParameter )
@@ -145,7 +152,7 @@ void CCvcDb::FindVbsError(ogzstream & theErrorFile, voltage_t theParameter, CFul
 	}
 }
 
-void CCvcDb::FindVdsError(ogzstream & theErrorFile, voltage_t theParameter, CFullConnection & theConnections, instanceId_t theInstanceId, string theDisplayParameter) {
+void CCvcDb::FindVdsError(ostream & theErrorFile, voltage_t theParameter, CFullConnection & theConnections, instanceId_t theInstanceId, string theDisplayParameter) {
 	theParameter += cvcParameters.cvcOvervoltageErrorThreshold;
 	if ( ( theConnections.validMinSource && theConnections.validMaxDrain
 				&& abs(theConnections.minSourceVoltage - theConnections.maxDrainVoltage) > theParameter )
@@ -176,7 +183,7 @@ void CCvcDb::FindVdsError(ogzstream & theErrorFile, voltage_t theParameter, CFul
 	}
 }
 
-void CCvcDb::FindVgsError(ogzstream & theErrorFile, voltage_t theParameter, CFullConnection & theConnections, instanceId_t theInstanceId, string theDisplayParameter) {
+void CCvcDb::FindVgsError(ostream & theErrorFile, voltage_t theParameter, CFullConnection & theConnections, instanceId_t theInstanceId, string theDisplayParameter) {
 	theParameter += cvcParameters.cvcOvervoltageErrorThreshold;
 	if ( ( theConnections.validMinGate && theConnections.validMaxSource
 				&& abs(theConnections.minGateVoltage - theConnections.maxSourceVoltage) > theParameter )
@@ -213,7 +220,7 @@ void CCvcDb::FindVgsError(ogzstream & theErrorFile, voltage_t theParameter, CFul
 	}
 }
 
-void CCvcDb::FindModelError(ogzstream & theErrorFile, CModelCheck & theCheck, CFullConnection & theConnections, instanceId_t theInstanceId) {
+void CCvcDb::FindModelError(ostream & theErrorFile, CModelCheck & theCheck, CFullConnection & theConnections, instanceId_t theInstanceId) {
 	bool myError = false;
 	if ( theCheck.parameter == "Vb" ) {
 		if ( ! (theConnections.validMinBulk && theConnections.validMaxBulk) ) {
@@ -236,18 +243,20 @@ void CCvcDb::FindModelError(ogzstream & theErrorFile, CModelCheck & theCheck, CF
 	}
 }
 
-void CCvcDb::PrintOverVoltageError(ogzstream & theErrorFile, CFullConnection & theConnections, cvcError_t theErrorIndex, string theExplanation, instanceId_t theInstanceId) {
+void CCvcDb::PrintOverVoltageError(ostream & theErrorFile, CFullConnection & theConnections, cvcError_t theErrorIndex, string theExplanation, instanceId_t theInstanceId) {
 	if ( cvcParameters.cvcCircuitErrorLimit == 0 || IncrementDeviceError(theConnections.deviceId, theErrorIndex) < cvcParameters.cvcCircuitErrorLimit ) {
 		theErrorFile << theExplanation << endl;
 		bool myLeakCheckFlag = ( theExplanation.find("logic ok") < string::npos );
+		RecordError(theErrorIndex, theInstanceId, theConnections);
 		PrintDeviceWithAllConnections(theInstanceId, theConnections, theErrorFile, myLeakCheckFlag);
 		theErrorFile << endl;
 	}
 }
  
-void CCvcDb::PrintModelError(ogzstream & theErrorFile, CFullConnection & theConnections, CModelCheck & theCheck, instanceId_t theInstanceId) {
+void CCvcDb::PrintModelError(ostream & theErrorFile, CFullConnection & theConnections, CModelCheck & theCheck, instanceId_t theInstanceId) {
 	if ( cvcParameters.cvcCircuitErrorLimit == 0 || IncrementDeviceError(theConnections.deviceId, MODEL_CHECK) < cvcParameters.cvcCircuitErrorLimit ) {
 		theErrorFile << "Model error: " << theCheck.check << endl;
+		RecordError(MODEL_CHECK, theInstanceId, theConnections);
 		PrintDeviceWithAllConnections(theInstanceId, theConnections, theErrorFile, false);
 		theErrorFile << endl;
 	}
@@ -256,21 +265,13 @@ void CCvcDb::PrintModelError(ogzstream & theErrorFile, CFullConnection & theConn
 void CCvcDb::FindAllOverVoltageErrors() {
 	CFullConnection myConnections;
 	reportFile << "! Checking overvoltage errors" << endl << endl;
-	string myVbgErrorFileName(tmpnam(NULL));
-	ogzstream myVbgErrorFile(myVbgErrorFileName);
-	myVbgErrorFile << "! Checking Vbg overvoltage errors" << endl << endl;
-	string myVbsErrorFileName(tmpnam(NULL));
-	ogzstream myVbsErrorFile(myVbsErrorFileName);
-	myVbsErrorFile << "! Checking Vbs overvoltage errors" << endl << endl;
-	string myVdsErrorFileName(tmpnam(NULL));
-	ogzstream myVdsErrorFile(myVdsErrorFileName);
-	myVdsErrorFile << "! Checking Vds overvoltage errors" << endl << endl;
-	string myVgsErrorFileName(tmpnam(NULL));
-	ogzstream myVgsErrorFile(myVgsErrorFileName);
-	myVgsErrorFile << "! Checking Vgs overvoltage errors" << endl << endl;
-	string myModelErrorFileName(tmpnam(NULL));
-	ogzstream myModelErrorFile(myModelErrorFileName);
-	myModelErrorFile << "! Checking Model errors" << endl << endl;
+	// Errors are collected uncompressed per check and compressed once when appended to the error file.
+	CErrorStream myVbgErrors, myVbsErrors, myVdsErrors, myVgsErrors, myModelErrors;
+	myVbgErrors << "! Checking Vbg overvoltage errors" << endl << endl;
+	myVbsErrors << "! Checking Vbs overvoltage errors" << endl << endl;
+	myVdsErrors << "! Checking Vds overvoltage errors" << endl << endl;
+	myVgsErrors << "! Checking Vgs overvoltage errors" << endl << endl;
+	myModelErrors << "! Checking Model errors" << endl << endl;
 
 	for (CModelListMap::iterator keyModelListPair_pit = cvcParameters.cvcModelListMap.begin(); keyModelListPair_pit != cvcParameters.cvcModelListMap.end(); keyModelListPair_pit++) {
 		for (CModelList::iterator model_pit = keyModelListPair_pit->second.begin(); model_pit != keyModelListPair_pit->second.end(); model_pit++) {
@@ -299,106 +300,177 @@ void CCvcDb::FindAllOverVoltageErrors() {
 					MapDeviceNets(myInstance_p, myDevice_p, myConnections);
 					myConnections.SetMinMaxLeakVoltagesAndFlags(this);
 					//string myErrorExplanation = "";
-					if ( model_pit->maxVbg != UNKNOWN_VOLTAGE ) FindVbgError(myVbgErrorFile, model_pit->maxVbg, myConnections, myInstanceId, myVbgDisplayParameter);
-					if ( model_pit->maxVbs != UNKNOWN_VOLTAGE ) FindVbsError(myVbsErrorFile, model_pit->maxVbs, myConnections, myInstanceId, myVbsDisplayParameter);
-					if ( model_pit->maxVds != UNKNOWN_VOLTAGE ) FindVdsError(myVdsErrorFile, model_pit->maxVds, myConnections, myInstanceId, myVdsDisplayParameter);
-					if ( model_pit->maxVgs != UNKNOWN_VOLTAGE ) FindVgsError(myVgsErrorFile, model_pit->maxVgs, myConnections, myInstanceId, myVgsDisplayParameter);
+					if ( model_pit->maxVbg != UNKNOWN_VOLTAGE ) FindVbgError(myVbgErrors, model_pit->maxVbg, myConnections, myInstanceId, myVbgDisplayParameter);
+					if ( model_pit->maxVbs != UNKNOWN_VOLTAGE ) FindVbsError(myVbsErrors, model_pit->maxVbs, myConnections, myInstanceId, myVbsDisplayParameter);
+					if ( model_pit->maxVds != UNKNOWN_VOLTAGE ) FindVdsError(myVdsErrors, model_pit->maxVds, myConnections, myInstanceId, myVdsDisplayParameter);
+					if ( model_pit->maxVgs != UNKNOWN_VOLTAGE ) FindVgsError(myVgsErrors, model_pit->maxVgs, myConnections, myInstanceId, myVgsDisplayParameter);
 					for ( auto check_pit = model_pit->checkList.begin(); check_pit != model_pit->checkList.end(); check_pit++ ) {
-						FindModelError(myModelErrorFile, *check_pit, myConnections, myInstanceId);
+						FindModelError(myModelErrors, *check_pit, myConnections, myInstanceId);
 					}
 				}
 				myDevice_p = myDevice_p->nextDevice_p;
 			}
 		}
 	}
-	myVbgErrorFile.close();
-	myVbsErrorFile.close();
-	myVdsErrorFile.close();
-	myVgsErrorFile.close();
-	myModelErrorFile.close();
-	AppendErrorFile(myVbgErrorFileName, "! Checking Vbg overvoltage errors", OVERVOLTAGE_VBG - OVERVOLTAGE_VBG);
-	AppendErrorFile(myVbsErrorFileName, "! Checking Vbs overvoltage errors", OVERVOLTAGE_VBS - OVERVOLTAGE_VBG);
-	AppendErrorFile(myVdsErrorFileName, "! Checking Vds overvoltage errors", OVERVOLTAGE_VDS - OVERVOLTAGE_VBG);
-	AppendErrorFile(myVgsErrorFileName, "! Checking Vgs overvoltage errors", OVERVOLTAGE_VGS - OVERVOLTAGE_VBG);
-	AppendErrorFile(myModelErrorFileName, "! Checking Model errors", MODEL_CHECK - OVERVOLTAGE_VBG);
+	AppendErrorFile(myVbgErrors, "! Checking Vbg overvoltage errors", OVERVOLTAGE_VBG - OVERVOLTAGE_VBG);
+	AppendErrorFile(myVbsErrors, "! Checking Vbs overvoltage errors", OVERVOLTAGE_VBS - OVERVOLTAGE_VBG);
+	AppendErrorFile(myVdsErrors, "! Checking Vds overvoltage errors", OVERVOLTAGE_VDS - OVERVOLTAGE_VBG);
+	AppendErrorFile(myVgsErrors, "! Checking Vgs overvoltage errors", OVERVOLTAGE_VGS - OVERVOLTAGE_VBG);
+	AppendErrorFile(myModelErrors, "! Checking Model errors", MODEL_CHECK - OVERVOLTAGE_VBG);
 }
 
-void CCvcDb::AppendErrorFile(string theTempFileName, string theHeading, int theErrorSubIndex) {
-	igzstream myTempFile(theTempFileName);
-	errorFile << myTempFile.rdbuf();
+void CCvcDb::AppendErrorFile(CErrorStream & theErrors, string theHeading, int theErrorSubIndex) {
+	theErrors.CopyTo(errorFile);
 	cvcCircuitList.PrintAndResetCircuitErrors(this, cvcParameters.cvcCircuitErrorLimit, logFile, errorFile, theHeading, theErrorSubIndex);
-	myTempFile.close();
-	remove(theTempFileName.c_str());
+}
+
+void CCvcDb::RecordError(int theErrorIndex, instanceId_t theParentId, CFullConnection & theConnections) {
+	// Adds a printed device error to the error database. Terminals that are not connected are left unknown.
+	if ( ! errorDatabase.IsOpen() ) return;
+	CErrorRecord myRecord;
+	myRecord.errorIndex = theErrorIndex;
+	myRecord.deviceId = theConnections.deviceId;
+	myRecord.parentId = theParentId;
+	myRecord.mFactor = CalculateMFactor(theParentId);
+	myRecord.instanceText = errorDatabase.TextIndex(HierarchyName(theParentId, PRINT_CIRCUIT_OFF, PRINT_HIERARCHY_ON));
+	myRecord.circuitText = errorDatabase.TextIndex(instancePtr_v[theParentId]->master_p->name);
+	myRecord.deviceText = errorDatabase.TextIndex(theConnections.device_p->name);
+	myRecord.parameterText = errorDatabase.TextIndex(theConnections.device_p->parameters);
+	auto myPowerId = [] (CPower * thePower_p) { return ( thePower_p ) ? thePower_p->powerId : UNKNOWN_NET; };
+	auto mySetTerminal = [&] (errorTerminal_t theTerminal, netId_t theNetId, CVirtualNet & theMinNet, CVirtualNet & theSimNet, CVirtualNet & theMaxNet,
+			voltage_t theMinVoltage, voltage_t theSimVoltage, voltage_t theMaxVoltage, CPower * theMinPower_p, CPower * theSimPower_p, CPower * theMaxPower_p) {
+		bool myConnected = ( theNetId != UNKNOWN_NET );
+		myRecord.net[theTerminal] = theNetId;
+		myRecord.minNet[theTerminal] = ( myConnected ) ? theMinNet.finalNetId : UNKNOWN_NET;
+		myRecord.simNet[theTerminal] = ( myConnected ) ? theSimNet.finalNetId : UNKNOWN_NET;
+		myRecord.maxNet[theTerminal] = ( myConnected ) ? theMaxNet.finalNetId : UNKNOWN_NET;
+		myRecord.minVoltage[theTerminal] = ( myConnected ) ? theMinVoltage : UNKNOWN_VOLTAGE;
+		myRecord.simVoltage[theTerminal] = ( myConnected ) ? theSimVoltage : UNKNOWN_VOLTAGE;
+		myRecord.maxVoltage[theTerminal] = ( myConnected ) ? theMaxVoltage : UNKNOWN_VOLTAGE;
+		myRecord.minPower[theTerminal] = ( myConnected ) ? myPowerId(theMinPower_p) : UNKNOWN_NET;
+		myRecord.simPower[theTerminal] = ( myConnected ) ? myPowerId(theSimPower_p) : UNKNOWN_NET;
+		myRecord.maxPower[theTerminal] = ( myConnected ) ? myPowerId(theMaxPower_p) : UNKNOWN_NET;
+	};
+	mySetTerminal(ERROR_GATE, theConnections.originalGateId, theConnections.masterMinGateNet, theConnections.masterSimGateNet, theConnections.masterMaxGateNet,
+		theConnections.minGateVoltage, theConnections.simGateVoltage, theConnections.maxGateVoltage,
+		theConnections.minGatePower_p, theConnections.simGatePower_p, theConnections.maxGatePower_p);
+	mySetTerminal(ERROR_SOURCE, theConnections.originalSourceId, theConnections.masterMinSourceNet, theConnections.masterSimSourceNet, theConnections.masterMaxSourceNet,
+		theConnections.minSourceVoltage, theConnections.simSourceVoltage, theConnections.maxSourceVoltage,
+		theConnections.minSourcePower_p, theConnections.simSourcePower_p, theConnections.maxSourcePower_p);
+	mySetTerminal(ERROR_DRAIN, theConnections.originalDrainId, theConnections.masterMinDrainNet, theConnections.masterSimDrainNet, theConnections.masterMaxDrainNet,
+		theConnections.minDrainVoltage, theConnections.simDrainVoltage, theConnections.maxDrainVoltage,
+		theConnections.minDrainPower_p, theConnections.simDrainPower_p, theConnections.maxDrainPower_p);
+	mySetTerminal(ERROR_BULK, theConnections.originalBulkId, theConnections.masterMinBulkNet, theConnections.masterSimBulkNet, theConnections.masterMaxBulkNet,
+		theConnections.minBulkVoltage, theConnections.simBulkVoltage, theConnections.maxBulkVoltage,
+		theConnections.minBulkPower_p, theConnections.simBulkPower_p, theConnections.maxBulkPower_p);
+	errorDatabase.AddRecord(myRecord);
 }
  
-void CCvcDb::FindNmosGateVsSourceErrors() {
-	CFullConnection myConnections;
-	reportFile << "! Checking nmos gate vs source errors: " << endl << endl;
-	errorFile << "! Checking nmos gate vs source errors: " << endl << endl;
-	for ( deviceId_t device_it = 0; device_it < deviceCount; device_it++ ) {
-		CInstance * myInstance_p = instancePtr_v[deviceParent_v[device_it]];
-		CCircuit * myParent_p = myInstance_p->master_p;
-		CDevice * myDevice_p = myParent_p->devicePtr_v[device_it - myInstance_p->firstDeviceId];
-		if ( ! IsNmos_(myDevice_p->model_p->type) ) continue;
-		MapDeviceNets(myInstance_p, myDevice_p, myConnections);
-		bool myVthFlag = false;
-		bool myUnrelatedFlag = false;
-		if ( ! myConnections.minGatePower_p ) continue;
-		if ( myConnections.minGatePower_p->type[ANALOG_BIT] && ! cvcParameters.cvcAnalogGates ) continue;  // ignore analog gate errors
-		if ( IsSCRCPower(myConnections.minGatePower_p) ) continue;  // ignore SCRC input (if not logically ok, should yield floating error)
-		if ( myConnections.minGatePower_p->IsRelatedPower(myConnections.minSourcePower_p, netVoltagePtr_v, minNet_v, minNet_v, true, true)
-				&& myConnections.minGatePower_p->IsRelatedPower(myConnections.minDrainPower_p, netVoltagePtr_v, minNet_v, minNet_v, true, true) ) {
-			// if relatives (default), then checks are conditional
-			voltage_t myGateSourceDifference = myConnections.minGateVoltage - min(myConnections.minSourceVoltage, myConnections.minSourceVoltage + myDevice_p->model_p->Vth);
-			voltage_t myGateDrainDifference = myConnections.minGateVoltage - min(myConnections.minDrainVoltage, myConnections.minDrainVoltage + myDevice_p->model_p->Vth);
-			voltage_t myMaxVoltageDifference = min(0, myDevice_p->model_p->Vth);
-			if ( myConnections.CheckTerminalMinVoltages(GATE | SOURCE)
-					&& myGateSourceDifference > myMaxVoltageDifference
-					&& myConnections.gateId != myConnections.drainId ) {
-				myMaxVoltageDifference = myGateSourceDifference;
-			}
-			if ( myConnections.CheckTerminalMinVoltages(GATE | DRAIN)
-					&& myGateDrainDifference > myMaxVoltageDifference
-					&& myConnections.gateId != myConnections.sourceId ) {
-				myMaxVoltageDifference = myGateDrainDifference;
-			}
-			if ( myMaxVoltageDifference <= cvcParameters.cvcGateErrorThreshold
-					|| ( cvcParameters.cvcMinVthGates && myMaxVoltageDifference < myDevice_p->model_p->Vth ) ) continue;  // no error
-			// Skip gates that are always fully on
-			if ( myConnections.CheckTerminalMaxVoltages(SOURCE) ) {
-				if ( myConnections.CheckTerminalMaxVoltages(DRAIN) ) {
-					if ( myConnections.minGateVoltage >= max(myConnections.maxSourceVoltage, myConnections.maxDrainVoltage) - cvcParameters.cvcGateErrorThreshold ) continue;
-					if ( myConnections.sourceId == myConnections.drainId ) {  // capacitor check
-						if ( IsPower_(netVoltagePtr_v[myConnections.gateId].full) && IsPower_(netVoltagePtr_v[myConnections.drainId].full) ) continue;  // ignore direct power capacitors
-						if ( ! IsInputOrPower_(netVoltagePtr_v[myConnections.masterMinSourceNet.finalNetId].full)
-								|| ! IsInputOrPower_(netVoltagePtr_v[myConnections.masterMinGateNet.finalNetId].full) ) continue;  // ignore capacitors connected to non-input/power nets
+#define DEVICE_CHECK_BLOCK_SIZE 4096
+
+void CCvcDb::ScanDeviceErrors(stage_t theStage) {
+	// Maps each device once for all of the device checks in this stage.
+	// Blocks of devices are checked on separate threads and the results are kept in device order,
+	// so the Find*Errors functions count and print errors in the same order as a single scan.
+	unsigned int myCheckMask = 0;
+	if ( theStage == STAGE_FIRST_MINMAX ) {
+		if ( ! cvcParameters.cvcLogicDiodes ) myCheckMask |= 1 << FORWARD_DIODE;
+		if ( ! cvcParameters.cvcSOI ) myCheckMask |= 1 << NMOS_SOURCE_BULK | 1 << PMOS_SOURCE_BULK;
+		if ( ! gSetup_cvc ) myCheckMask |= 1 << NMOS_GATE_SOURCE | 1 << PMOS_GATE_SOURCE;
+	} else {
+		if ( cvcParameters.cvcLogicDiodes ) myCheckMask |= 1 << FORWARD_DIODE;
+		myCheckMask |= 1 << NMOS_POSSIBLE_LEAK | 1 << PMOS_POSSIBLE_LEAK;
+	}
+	size_t myBlockCount = deviceCount / DEVICE_CHECK_BLOCK_SIZE + 1;
+	vector<CDeviceErrorVector> myBlockError_v(myBlockCount);
+	// threads only read virtual nets, so there can be no pending updates
+	bool myIsFixed = minNet_v.lastUpdate_v.empty() && simNet_v.lastUpdate_v.empty() && maxNet_v.lastUpdate_v.empty();
+	size_t myThreadCount = ( myIsFixed ) ? min(cvcParameters.cvcThreadCount, myBlockCount) : 1;
+	atomic<size_t> myNextBlock(0);
+	atomic<long> myAccessCount(0);
+	auto myCheckBlocks = [&] () {
+		CFullConnection myConnections;
+		long myThreadAccessCount = 0;
+		long * myAccessCount_p = ( myThreadCount > 1 ) ? &myThreadAccessCount : NULL;
+		size_t myBlock;
+		while ( (myBlock = myNextBlock.fetch_add(1)) < myBlockCount ) {
+			deviceId_t myLastDevice = min(deviceCount, uintmax_t(myBlock + 1) * DEVICE_CHECK_BLOCK_SIZE);
+			for ( deviceId_t device_it = myBlock * DEVICE_CHECK_BLOCK_SIZE; device_it < myLastDevice; device_it++ ) {
+				CInstance * myInstance_p = instancePtr_v[deviceParent_v[device_it]];
+				CCircuit * myParent_p = myInstance_p->master_p;
+				CDevice * myDevice_p = myParent_p->devicePtr_v[device_it - myInstance_p->firstDeviceId];
+				unsigned int myDeviceMask = 0;
+				if ( IsNmos_(myDevice_p->model_p->type) ) {
+					myDeviceMask |= 1 << NMOS_SOURCE_BULK | 1 << NMOS_GATE_SOURCE | 1 << NMOS_POSSIBLE_LEAK;
+				} else if ( IsPmos_(myDevice_p->model_p->type) ) {
+					myDeviceMask |= 1 << PMOS_SOURCE_BULK | 1 << PMOS_GATE_SOURCE | 1 << PMOS_POSSIBLE_LEAK;
+				}
+				if ( ! IsNmos_(deviceType_v[device_it]) && ! IsPmos_(deviceType_v[device_it]) && ! myDevice_p->model_p->diodeList.empty() ) {
+					myDeviceMask |= 1 << FORWARD_DIODE;
+				}
+				myDeviceMask &= myCheckMask;
+				if ( ! myDeviceMask ) continue;
+				MapDeviceNets(myInstance_p, myDevice_p, myConnections, myAccessCount_p);
+				for ( int error_it = FORWARD_DIODE; error_it <= PMOS_POSSIBLE_LEAK; error_it++ ) {
+					if ( ! (myDeviceMask & 1 << error_it) ) continue;
+					int myFlags = 0;
+					switch ( error_it ) {
+						case FORWARD_DIODE: { myFlags = CheckForwardBiasDiode(myConnections, false); break; }
+						case NMOS_SOURCE_BULK: { myFlags = CheckNmosSourceVsBulk(myConnections); break; }
+						case NMOS_GATE_SOURCE: { myFlags = CheckNmosGateVsSource(myConnections); break; }
+						case NMOS_POSSIBLE_LEAK: { myFlags = CheckNmosPossibleLeak(myConnections); break; }
+						case PMOS_SOURCE_BULK: { myFlags = CheckPmosSourceVsBulk(myConnections); break; }
+						case PMOS_GATE_SOURCE: { myFlags = CheckPmosGateVsSource(myConnections); break; }
+						case PMOS_POSSIBLE_LEAK: { myFlags = CheckPmosPossibleLeak(myConnections); break; }
+						default: break;
+					}
+					if ( myFlags ) {
+						myBlockError_v[myBlock].push_back(CDeviceError(device_it, cvcError_t(error_it), myFlags));
 					}
-				} else {
-					if ( myConnections.minGateVoltage >= myConnections.maxSourceVoltage - cvcParameters.cvcGateErrorThreshold ) continue;
 				}
-			} else if ( myConnections.CheckTerminalMaxVoltages(DRAIN) ) {
-				if ( myConnections.minGateVoltage >= myConnections.maxDrainVoltage - cvcParameters.cvcGateErrorThreshold ) continue;
-			} else {
-				continue;  // ignore devices with no max connections
 			}
-			myVthFlag = myConnections.minGatePower_p->type[MIN_CALCULATED_BIT]
-				&& ( myConnections.minGateVoltage - myConnections.minSourceVoltage == myDevice_p->model_p->Vth
-					|| myConnections.minGateVoltage - myConnections.minDrainVoltage == myDevice_p->model_p->Vth );
-			if ( myVthFlag && ! cvcParameters.cvcVthGates ) continue;
-		} else {
-			myUnrelatedFlag = true;  // if not relatives, always an error
 		}
-		if ( IncrementDeviceError(myConnections.deviceId, NMOS_GATE_SOURCE) < cvcParameters.cvcCircuitErrorLimit || cvcParameters.cvcCircuitErrorLimit == 0 ) {
-			if ( myUnrelatedFlag ) {
+		myAccessCount += myThreadAccessCount;
+	};
+	vector<thread> myThread_v;
+	for ( size_t thread_it = 1; thread_it < myThreadCount; thread_it++ ) {
+		myThread_v.push_back(thread(myCheckBlocks));
+	}
+	myCheckBlocks();
+	for ( auto thread_pit = myThread_v.begin(); thread_pit != myThread_v.end(); thread_pit++ ) {
+		thread_pit->join();
+	}
+	gVirtualNetAccessCount += myAccessCount;
+	size_t myErrorCount = 0;
+	for ( auto block_pit = myBlockError_v.begin(); block_pit != myBlockError_v.end(); block_pit++ ) {
+		myErrorCount += block_pit->size();
+	}
+	CDeviceErrorVector().swap(deviceError_v);
+	deviceError_v.reserve(myErrorCount);
+	for ( auto block_pit = myBlockError_v.begin(); block_pit != myBlockError_v.end(); block_pit++ ) {
+		deviceError_v.insert(deviceError_v.end(), block_pit->begin(), block_pit->end());
+	}
+}
+
+void CCvcDb::FindNmosGateVsSourceErrors() {
+	CFullConnection myConnections;
+	reportFile << "! Checking nmos gate vs source errors: " << endl << endl;
+	errorFile << "! Checking nmos gate vs source errors: " << endl << endl;
+	for ( auto error_pit = deviceError_v.begin(); error_pit != deviceError_v.end(); error_pit++ ) {
+		if ( error_pit->errorIndex != NMOS_GATE_SOURCE ) continue;
+		if ( IncrementDeviceError(error_pit->deviceId, NMOS_GATE_SOURCE) < cvcParameters.cvcCircuitErrorLimit || cvcParameters.cvcCircuitErrorLimit == 0 ) {
+			MapDeviceNets(error_pit->deviceId, myConnections);
+			if ( error_pit->flags & CHECK_UNRELATED ) {
 				errorFile << "Unrelated power error" << endl;
 /*
 			} else if ( myConnections.minGatePower_p->type[REFERENCE_BIT] ) {
 				errorFile << "Gate reference signal" << endl;
 */
-			} else if ( myVthFlag ) {
+			} else if ( error_pit->flags & CHECK_VTH ) {
 				errorFile << "Gate-source = Vth" << endl;
 			}
-			PrintDeviceWithAllConnections(deviceParent_v[device_it], myConnections, errorFile);
+			RecordError(NMOS_GATE_SOURCE, deviceParent_v[error_pit->deviceId], myConnections);
+			PrintDeviceWithAllConnections(deviceParent_v[error_pit->deviceId], myConnections, errorFile);
 			errorFile << endl;
 		}
 	}
@@ -406,71 +478,74 @@ void CCvcDb::FindNmosGateVsSourceErrors() {
 	CheckOppositeLogic(NMOS);
 	cvcCircuitList.PrintAndResetCircuitErrors(this, cvcParameters.cvcCircuitErrorLimit, logFile, errorFile, "! Checking nmos gate vs source errors: ");
 }
+
+int CCvcDb::CheckNmosGateVsSource(CFullConnection & theConnections) {
+	// Check* functions return deviceCheck_t flags for ScanDeviceErrors. no output, so safe on multiple threads.
+	bool myVthFlag = false;
+	bool myUnrelatedFlag = false;
+	if ( ! theConnections.minGatePower_p ) return 0;
+	if ( theConnections.minGatePower_p->type[ANALOG_BIT] && ! cvcParameters.cvcAnalogGates ) return 0;  // ignore analog gate errors
+	if ( IsSCRCPower(theConnections.minGatePower_p) ) return 0;  // ignore SCRC input (if not logically ok, should yield floating error)
+	if ( theConnections.minGatePower_p->IsRelatedPower(theConnections.minSourcePower_p, netVoltagePtr_v, minNet_v, minNet_v, true, true)
+			&& theConnections.minGatePower_p->IsRelatedPower(theConnections.minDrainPower_p, netVoltagePtr_v, minNet_v, minNet_v, true, true) ) {
+		// if relatives (default), then checks are conditional
+		voltage_t myGateSourceDifference = theConnections.minGateVoltage - min(theConnections.minSourceVoltage, theConnections.minSourceVoltage + theConnections.device_p->model_p->Vth);
+		voltage_t myGateDrainDifference = theConnections.minGateVoltage - min(theConnections.minDrainVoltage, theConnections.minDrainVoltage + theConnections.device_p->model_p->Vth);
+		voltage_t myMaxVoltageDifference = min(0, theConnections.device_p->model_p->Vth);
+		if ( theConnections.CheckTerminalMinVoltages(GATE | SOURCE)
+				&& myGateSourceDifference > myMaxVoltageDifference
+				&& theConnections.gateId != theConnections.drainId ) {
+			myMaxVoltageDifference = myGateSourceDifference;
+		}
+		if ( theConnections.CheckTerminalMinVoltages(GATE | DRAIN)
+				&& myGateDrainDifference > myMaxVoltageDifference
+				&& theConnections.gateId != theConnections.sourceId ) {
+			myMaxVoltageDifference = myGateDrainDifference;
+		}
+		if ( myMaxVoltageDifference <= cvcParameters.cvcGateErrorThreshold
+				|| ( cvcParameters.cvcMinVthGates && myMaxVoltageDifference < theConnections.device_p->model_p->Vth ) ) return 0;  // no error
+		// Skip gates that are always fully on
+		if ( theConnections.CheckTerminalMaxVoltages(SOURCE) ) {
+			if ( theConnections.CheckTerminalMaxVoltages(DRAIN) ) {
+				if ( theConnections.minGateVoltage >= max(theConnections.maxSourceVoltage, theConnections.maxDrainVoltage) - cvcParameters.cvcGateErrorThreshold ) return 0;
+				if ( theConnections.sourceId == theConnections.drainId ) {  // capacitor check
+					if ( IsPower_(netVoltagePtr_v[theConnections.gateId].full) && IsPower_(netVoltagePtr_v[theConnections.drainId].full) ) return 0;  // ignore direct power capacitors
+					if ( ! IsInputOrPower_(netVoltagePtr_v[theConnections.masterMinSourceNet.finalNetId].full)
+							|| ! IsInputOrPower_(netVoltagePtr_v[theConnections.masterMinGateNet.finalNetId].full) ) return 0;  // ignore capacitors connected to non-input/power nets
+				}
+			} else {
+				if ( theConnections.minGateVoltage >= theConnections.maxSourceVoltage - cvcParameters.cvcGateErrorThreshold ) return 0;
+			}
+		} else if ( theConnections.CheckTerminalMaxVoltages(DRAIN) ) {
+			if ( theConnections.minGateVoltage >= theConnections.maxDrainVoltage - cvcParameters.cvcGateErrorThreshold ) return 0;
+		} else {
+			return 0;  // ignore devices with no max connections
+		}
+		myVthFlag = theConnections.minGatePower_p->type[MIN_CALCULATED_BIT]
+			&& ( theConnections.minGateVoltage - theConnections.minSourceVoltage == theConnections.device_p->model_p->Vth
+				|| theConnections.minGateVoltage - theConnections.minDrainVoltage == theConnections.device_p->model_p->Vth );
+		if ( myVthFlag && ! cvcParameters.cvcVthGates ) return 0;
+	} else {
+		myUnrelatedFlag = true;  // if not relatives, always an error
+	}
+	return CHECK_ERROR | ( myUnrelatedFlag ? CHECK_UNRELATED : 0 ) | ( myVthFlag ? CHECK_VTH : 0 );
+}
+
 char GATE_LOGIC_CHECK[] = "GateVsSource logic check";
 
 void CCvcDb::FindPmosGateVsSourceErrors() {
 	CFullConnection myConnections;
 	reportFile << "! Checking pmos gate vs source errors: " << endl << endl;
 	errorFile << "! Checking pmos gate vs source errors: " << endl << endl;
-	for ( deviceId_t device_it = 0; device_it < deviceCount; device_it++ ) {
-		CInstance * myInstance_p = instancePtr_v[deviceParent_v[device_it]];
-		CCircuit * myParent_p = myInstance_p->master_p;
-		CDevice * myDevice_p = myParent_p->devicePtr_v[device_it - myInstance_p->firstDeviceId];
-		if ( ! IsPmos_(myDevice_p->model_p->type) ) continue;
-		MapDeviceNets(myInstance_p, myDevice_p, myConnections);
-		bool myVthFlag = false;
-		bool myUnrelatedFlag = false;
-		if ( ! myConnections.maxGatePower_p ) continue;
-		if ( myConnections.maxGatePower_p->type[ANALOG_BIT] && ! cvcParameters.cvcAnalogGates ) continue;  // ignore analog gate errors
-		if ( IsSCRCPower(myConnections.maxGatePower_p) ) continue;  // ignore SCRC input (if not logically ok, should yield floating error)
-		if ( myConnections.maxGatePower_p->IsRelatedPower(myConnections.maxSourcePower_p, netVoltagePtr_v, maxNet_v, maxNet_v, true, true)
-				&& myConnections.maxGatePower_p->IsRelatedPower(myConnections.maxDrainPower_p, netVoltagePtr_v, maxNet_v, maxNet_v, true, true) ) {
-			// if relatives (default), then checks are conditional
-			voltage_t myGateSourceDifference = max(myConnections.maxSourceVoltage, myConnections.maxSourceVoltage + myDevice_p->model_p->Vth) - myConnections.maxGateVoltage;
-			voltage_t myGateDrainDifference = max(myConnections.maxDrainVoltage, myConnections.maxDrainVoltage + myDevice_p->model_p->Vth) - myConnections.maxGateVoltage;
-			voltage_t myMaxVoltageDifference = max(0, myDevice_p->model_p->Vth);
-			if ( myConnections.CheckTerminalMaxVoltages(GATE | SOURCE) &&
-					myGateSourceDifference > myMaxVoltageDifference  &&
-					myConnections.gateId != myConnections.drainId ) {
-				myMaxVoltageDifference = myGateSourceDifference;
-			}
-			if ( myConnections.CheckTerminalMaxVoltages(GATE | DRAIN) &&
-					myGateDrainDifference > myMaxVoltageDifference  &&
-					myConnections.gateId != myConnections.sourceId ) {
-				myMaxVoltageDifference = myGateDrainDifference;
-			}
-			if ( myMaxVoltageDifference <= cvcParameters.cvcGateErrorThreshold
-					|| ( cvcParameters.cvcMinVthGates && myMaxVoltageDifference < -myDevice_p->model_p->Vth ) ) continue;  // no error
-			// Skip gates that are always fully on
-			if ( myConnections.CheckTerminalMinVoltages(SOURCE) ) {
-				if ( myConnections.CheckTerminalMinVoltages(DRAIN) ) {
-					if ( myConnections.maxGateVoltage <= min(myConnections.minSourceVoltage, myConnections.minDrainVoltage) + cvcParameters.cvcGateErrorThreshold ) continue;
-					if ( myConnections.sourceId == myConnections.drainId ) {  // capacitor check
-						if ( IsPower_(netVoltagePtr_v[myConnections.gateId].full) && IsPower_(netVoltagePtr_v[myConnections.drainId].full) ) continue;  // ignore direct power capacitors
-						if ( ! IsInputOrPower_(netVoltagePtr_v[myConnections.masterMinSourceNet.finalNetId].full)
-								|| ! IsInputOrPower_(netVoltagePtr_v[myConnections.masterMinGateNet.finalNetId].full) ) continue;  // ignore capacitors connected to non-input/power nets
-					}
-				} else {
-					if ( myConnections.maxGateVoltage <= myConnections.minSourceVoltage + cvcParameters.cvcGateErrorThreshold ) continue;
-				}
-			} else if ( myConnections.CheckTerminalMinVoltages(DRAIN) ) {
-				if ( myConnections.maxGateVoltage <= myConnections.minDrainVoltage + cvcParameters.cvcGateErrorThreshold ) continue;
-			} else {
-				continue;  // ignore devices with no min connections
-			}
-			myVthFlag= myConnections.maxGatePower_p->type[MAX_CALCULATED_BIT]
-				&& ( myConnections.maxGateVoltage - myConnections.maxSourceVoltage == myDevice_p->model_p->Vth
-					|| myConnections.maxGateVoltage - myConnections.maxDrainVoltage == myDevice_p->model_p->Vth );
-			if ( myVthFlag && ! cvcParameters.cvcVthGates ) continue;
-		} else {
-			myUnrelatedFlag = true; // if not relatives, always an error
-		}
-		if ( myConnections.maxGatePower_p->type[MAX_CALCULATED_BIT] && cvcParameters.cvcLogicDiodes && ! netVoltagePtr_v[myConnections.gateId].full ) {
+	for ( auto error_pit = deviceError_v.begin(); error_pit != deviceError_v.end(); error_pit++ ) {
+		if ( error_pit->errorIndex != PMOS_GATE_SOURCE ) continue;
+		if ( error_pit->flags & CHECK_EXPECT_LOW ) {
 			// If the source is a calculated value and the CVC_LOGIC_DIODE switch is on and there is no current definition,
 			// there is no error if the gate logic value is low (WARNING: set to 0V is just a kludge)
 			// check expected value later
-			debugFile << "EXPECT low for GateVsSource: " << NetName(myConnections.gateId) << " at " << DeviceName(myConnections.deviceId, PRINT_CIRCUIT_ON) << endl;
-			CPower * myPower_p = new CPower(myConnections.gateId);
+			netId_t myGateId = gateNet_v[error_pit->deviceId];
+			debugFile << "EXPECT low for GateVsSource: " << NetName(myGateId) << " at " << DeviceName(error_pit->deviceId, PRINT_CIRCUIT_ON) << endl;
+			CPower * myPower_p = new CPower(myGateId);
 			myPower_p->definition = CPower::powerDefinitionText.SetTextAddress(GATE_LOGIC_CHECK);
 			myPower_p->extraData = new CExtraPowerData;
 			myPower_p->minVoltage = UNKNOWN_VOLTAGE;
@@ -479,19 +554,21 @@ void CCvcDb::FindPmosGateVsSourceErrors() {
 			myPower_p->type[INPUT_BIT] = false;
 			myPower_p->extraData->expectedSim = "0";
 			cvcParameters.cvcExpectedLevelPtrList.push_back(myPower_p);
-			continue;  // Don't flag error here
+			continue;
 		}
-		if ( IncrementDeviceError(myConnections.deviceId, PMOS_GATE_SOURCE) < cvcParameters.cvcCircuitErrorLimit || cvcParameters.cvcCircuitErrorLimit == 0 ) {
-			if ( myUnrelatedFlag ) {
+		if ( IncrementDeviceError(error_pit->deviceId, PMOS_GATE_SOURCE) < cvcParameters.cvcCircuitErrorLimit || cvcParameters.cvcCircuitErrorLimit == 0 ) {
+			MapDeviceNets(error_pit->deviceId, myConnections);
+			if ( error_pit->flags & CHECK_UNRELATED ) {
 				errorFile << "Unrelated power error" << endl;
 /*
 			} else if ( myConnections.maxGatePower_p->type[REFERENCE_BIT] ) {
 				errorFile << "Gate reference signal" << endl;
 */
-			} else if ( myVthFlag ) {
+			} else if ( error_pit->flags & CHECK_VTH ) {
 				errorFile << "Gate-source = Vth" << endl;
 			}
-			PrintDeviceWithAllConnections(deviceParent_v[device_it], myConnections, errorFile);
+			RecordError(PMOS_GATE_SOURCE, deviceParent_v[error_pit->deviceId], myConnections);
+			PrintDeviceWithAllConnections(deviceParent_v[error_pit->deviceId], myConnections, errorFile);
 			errorFile << endl;
 		}
 	}
@@ -500,119 +577,83 @@ void CCvcDb::FindPmosGateVsSourceErrors() {
 	cvcCircuitList.PrintAndResetCircuitErrors(this, cvcParameters.cvcCircuitErrorLimit, logFile, errorFile, "! Checking pmos gate vs source errors: ");
 }
 
+int CCvcDb::CheckPmosGateVsSource(CFullConnection & theConnections) {
+	bool myVthFlag = false;
+	bool myUnrelatedFlag = false;
+	if ( ! theConnections.maxGatePower_p ) return 0;
+	if ( theConnections.maxGatePower_p->type[ANALOG_BIT] && ! cvcParameters.cvcAnalogGates ) return 0;  // ignore analog gate errors
+	if ( IsSCRCPower(theConnections.maxGatePower_p) ) return 0;  // ignore SCRC input (if not logically ok, should yield floating error)
+	if ( theConnections.maxGatePower_p->IsRelatedPower(theConnections.maxSourcePower_p, netVoltagePtr_v, maxNet_v, maxNet_v, true, true)
+			&& theConnections.maxGatePower_p->IsRelatedPower(theConnections.maxDrainPower_p, netVoltagePtr_v, maxNet_v, maxNet_v, true, true) ) {
+		// if relatives (default), then checks are conditional
+		voltage_t myGateSourceDifference = max(theConnections.maxSourceVoltage, theConnections.maxSourceVoltage + theConnections.device_p->model_p->Vth) - theConnections.maxGateVoltage;
+		voltage_t myGateDrainDifference = max(theConnections.maxDrainVoltage, theConnections.maxDrainVoltage + theConnections.device_p->model_p->Vth) - theConnections.maxGateVoltage;
+		voltage_t myMaxVoltageDifference = max(0, theConnections.device_p->model_p->Vth);
+		if ( theConnections.CheckTerminalMaxVoltages(GATE | SOURCE) &&
+				myGateSourceDifference > myMaxVoltageDifference  &&
+				theConnections.gateId != theConnections.drainId ) {
+			myMaxVoltageDifference = myGateSourceDifference;
+		}
+		if ( theConnections.CheckTerminalMaxVoltages(GATE | DRAIN) &&
+				myGateDrainDifference > myMaxVoltageDifference  &&
+				theConnections.gateId != theConnections.sourceId ) {
+			myMaxVoltageDifference = myGateDrainDifference;
+		}
+		if ( myMaxVoltageDifference <= cvcParameters.cvcGateErrorThreshold
+				|| ( cvcParameters.cvcMinVthGates && myMaxVoltageDifference < -theConnections.device_p->model_p->Vth ) ) return 0;  // no error
+		// Skip gates that are always fully on
+		if ( theConnections.CheckTerminalMinVoltages(SOURCE) ) {
+			if ( theConnections.CheckTerminalMinVoltages(DRAIN) ) {
+				if ( theConnections.maxGateVoltage <= min(theConnections.minSourceVoltage, theConnections.minDrainVoltage) + cvcParameters.cvcGateErrorThreshold ) return 0;
+				if ( theConnections.sourceId == theConnections.drainId ) {  // capacitor check
+					if ( IsPower_(netVoltagePtr_v[theConnections.gateId].full) && IsPower_(netVoltagePtr_v[theConnections.drainId].full) ) return 0;  // ignore direct power capacitors
+					if ( ! IsInputOrPower_(netVoltagePtr_v[theConnections.masterMinSourceNet.finalNetId].full)
+							|| ! IsInputOrPower_(netVoltagePtr_v[theConnections.masterMinGateNet.finalNetId].full) ) return 0;  // ignore capacitors connected to non-input/power nets
+				}
+			} else {
+				if ( theConnections.maxGateVoltage <= theConnections.minSourceVoltage + cvcParameters.cvcGateErrorThreshold ) return 0;
+			}
+		} else if ( theConnections.CheckTerminalMinVoltages(DRAIN) ) {
+			if ( theConnections.maxGateVoltage <= theConnections.minDrainVoltage + cvcParameters.cvcGateErrorThreshold ) return 0;
+		} else {
+			return 0;  // ignore devices with no min connections
+		}
+		myVthFlag= theConnections.maxGatePower_p->type[MAX_CALCULATED_BIT]
+			&& ( theConnections.maxGateVoltage - theConnections.maxSourceVoltage == theConnections.device_p->model_p->Vth
+				|| theConnections.maxGateVoltage - theConnections.maxDrainVoltage == theConnections.device_p->model_p->Vth );
+		if ( myVthFlag && ! cvcParameters.cvcVthGates ) return 0;
+	} else {
+		myUnrelatedFlag = true; // if not relatives, always an error
+	}
+	if ( theConnections.maxGatePower_p->type[MAX_CALCULATED_BIT] && cvcParameters.cvcLogicDiodes && ! netVoltagePtr_v[theConnections.gateId].full ) {
+		return CHECK_EXPECT_LOW;  // Don't flag error here
+	}
+	return CHECK_ERROR | ( myUnrelatedFlag ? CHECK_UNRELATED : 0 ) | ( myVthFlag ? CHECK_VTH : 0 );
+}
+
 void CCvcDb::FindNmosSourceVsBulkErrors() {
 	CFullConnection myConnections;
 	reportFile << "! Checking nmos source/drain vs bias errors: " << endl << endl;
 	errorFile << "! Checking nmos source/drain vs bias errors: " << endl << endl;
 	unordered_set<netId_t> myProblemNets;
-	for ( deviceId_t device_it = 0; device_it < deviceCount; device_it++ ) {
-		CInstance * myInstance_p = instancePtr_v[deviceParent_v[device_it]];
-		CCircuit * myParent_p = myInstance_p->master_p;
-		CDevice * myDevice_p = myParent_p->devicePtr_v[device_it - myInstance_p->firstDeviceId];
-		if ( ! IsNmos_(myDevice_p->model_p->type) ) continue;
-		MapDeviceNets(myInstance_p, myDevice_p, myConnections);
-		if ( myConnections.sourceId == myConnections.drainId && myConnections.sourceId == myConnections.bulkId ) continue;  // ignore drain = source = bulk
-		bool myErrorFlag = false;
-		bool myUnrelatedFlag = false;
-		bool mySourceError = false;
-		bool myDrainError = false;
-		if ( ! myConnections.minBulkPower_p
-				|| (myConnections.minBulkPower_p->IsRelatedPower(myConnections.minSourcePower_p, netVoltagePtr_v, minNet_v, minNet_v, true, true)
-					&& myConnections.minBulkPower_p->IsRelatedPower(myConnections.minDrainPower_p, netVoltagePtr_v, minNet_v, minNet_v, true, true)) ) {
-			// if relatives (default), then checks are conditional
-			if ( (myConnections.maxBulkVoltage == myConnections.minSourceVoltage || myConnections.minSourceVoltage == UNKNOWN_VOLTAGE)
-					&& (myConnections.maxBulkVoltage == myConnections.minDrainVoltage || myConnections.minDrainVoltage == UNKNOWN_VOLTAGE) ) continue;
-				// no error if max bulk = min source = min drain
-			if ( myConnections.minBulkPower_p && myConnections.minBulkPower_p->type[HIZ_BIT] ) {
-				if ( myConnections.sourceId == myConnections.bulkId && myConnections.drainId == myConnections.bulkId ) continue;
-				if ( myConnections.minSourcePower_p && ! myConnections.minBulkPower_p->IsRelatedPower(myConnections.minSourcePower_p, netVoltagePtr_v, minNet_v, minNet_v, false) ) {
-					myErrorFlag = true;
-				} else if ( myConnections.simSourcePower_p && IsKnownVoltage_(myConnections.simSourcePower_p->simVoltage)
-						&& ! myConnections.minBulkPower_p->IsRelatedPower(myConnections.simSourcePower_p, netVoltagePtr_v, minNet_v, simNet_v, false)
-						&& myConnections.simSourceVoltage < myConnections.maxBulkVoltage ) {
-					myErrorFlag = true;
-				} else if ( myConnections.maxSourcePower_p && ! myConnections.minBulkPower_p->IsRelatedPower(myConnections.maxSourcePower_p, netVoltagePtr_v, minNet_v, maxNet_v, false) ) {
-					myErrorFlag = true;
-				} else if ( myConnections.minDrainPower_p && ! myConnections.minBulkPower_p->IsRelatedPower(myConnections.minDrainPower_p, netVoltagePtr_v, minNet_v, minNet_v, false) ) {
-					myErrorFlag = true;
-				} else if ( myConnections.simDrainPower_p && IsKnownVoltage_(myConnections.simDrainPower_p->simVoltage)
-						&& ! myConnections.minBulkPower_p->IsRelatedPower(myConnections.simDrainPower_p, netVoltagePtr_v, minNet_v, simNet_v, false)
-						&& myConnections.simDrainVoltage < myConnections.maxBulkVoltage ) {
-					myErrorFlag = true;
-				} else if ( myConnections.maxDrainPower_p && ! myConnections.minBulkPower_p->IsRelatedPower(myConnections.maxDrainPower_p, netVoltagePtr_v, minNet_v, maxNet_v, false) ) {
-					myErrorFlag = true;
-				}
-			} else if ( myConnections.CheckTerminalMinVoltages(BULK) == false ) {
-				if ( myConnections.minSourcePower_p || myConnections.simSourcePower_p || myConnections.maxSourcePower_p ||
-						myConnections.minDrainPower_p || myConnections.simDrainPower_p || myConnections.maxDrainPower_p ) { // has some connection (all connections open -> no error)
-					myErrorFlag = true;
-				}
-			} else if ( myConnections.CheckTerminalMinVoltages(BULK | SOURCE) &&
-					( myConnections.minBulkVoltage - myConnections.minSourceVoltage > cvcParameters.cvcBiasErrorThreshold ||
-						( myConnections.minSourceVoltage == myConnections.minBulkVoltage &&
-							cvcParameters.cvcBiasErrorThreshold == 0 &&
-							myConnections.masterMinSourceNet.finalResistance < myConnections.masterMinBulkNet.finalResistance) ) ) {
-				mySourceError = true;
-			} else if (	myConnections.CheckTerminalMinVoltages(BULK | DRAIN) &&
-					( myConnections.minBulkVoltage - myConnections.minDrainVoltage > cvcParameters.cvcBiasErrorThreshold ||
-						( myConnections.minDrainVoltage == myConnections.minBulkVoltage &&
-							cvcParameters.cvcBiasErrorThreshold == 0 &&
-							myConnections.masterMinDrainNet.finalResistance < myConnections.masterMinBulkNet.finalResistance) ) ) {
-				myDrainError = true;
-			} else if (	myConnections.CheckTerminalSimVoltages(BULK | SOURCE) &&
-					( myConnections.simBulkVoltage - myConnections.simSourceVoltage > cvcParameters.cvcBiasErrorThreshold ||
-						( myConnections.simSourceVoltage == myConnections.simBulkVoltage &&
-							cvcParameters.cvcBiasErrorThreshold == 0 &&
-							myConnections.masterSimSourceNet.finalResistance < myConnections.masterSimBulkNet.finalResistance) ) ) {
-				myErrorFlag = true;
-			} else if (	myConnections.CheckTerminalSimVoltages(BULK | DRAIN) &&
-					( myConnections.simBulkVoltage - myConnections.simDrainVoltage > cvcParameters.cvcBiasErrorThreshold ||
-						( myConnections.simDrainVoltage == myConnections.simBulkVoltage &&
-							cvcParameters.cvcBiasErrorThreshold == 0 &&
-							myConnections.masterSimDrainNet.finalResistance < myConnections.masterSimBulkNet.finalResistance) ) ) {
-				myErrorFlag = true;
-			} else if (	myConnections.CheckTerminalMaxVoltages(BULK | SOURCE) &&
-					( ( myConnections.maxBulkVoltage - myConnections.maxSourceVoltage > cvcParameters.cvcBiasErrorThreshold &&
-							myConnections.maxSourcePower_p->defaultMaxNet != myConnections.bulkId ) ||
-						( myConnections.maxSourceVoltage == myConnections.maxBulkVoltage &&
-							cvcParameters.cvcBiasErrorThreshold == 0 &&
-							myConnections.maxSourceVoltage != myConnections.minBulkVoltage && // no leak path
-	//						myConnections.masterMinBulkNet.finalNetId != myConnections.masterMaxBulkNet.finalNetId &&
-							myConnections.masterMaxSourceNet.finalResistance > myConnections.masterMaxBulkNet.finalResistance &&
-							! myConnections.minBulkPower_p->type[HIZ_BIT] &&
-							! PathContains(maxNet_v, myConnections.sourceId, myConnections.bulkId)) ) ) { // resistance check backwards in NMOS max (ignore connections through self)
-				myErrorFlag = true;
-	// Added 20140523
-			} else if (	myConnections.CheckTerminalMaxVoltages(BULK | DRAIN) &&
-					( ( myConnections.maxBulkVoltage - myConnections.maxDrainVoltage > cvcParameters.cvcBiasErrorThreshold &&
-							myConnections.maxDrainPower_p->defaultMaxNet != myConnections.bulkId ) ||
-						( myConnections.maxDrainVoltage == myConnections.maxBulkVoltage &&
-							cvcParameters.cvcBiasErrorThreshold == 0 &&
-							myConnections.maxDrainVoltage != myConnections.minBulkVoltage && // no leak path
-	//						myConnections.masterMinBulkNet.finalNetId != myConnections.masterMaxBulkNet.finalNetId &&
-							myConnections.masterMaxDrainNet.finalResistance > myConnections.masterMaxBulkNet.finalResistance &&
-							! myConnections.minBulkPower_p->type[HIZ_BIT] &&
-							! PathContains(maxNet_v, myConnections.drainId, myConnections.bulkId)) ) ) { // resistance check backwards in NMOS max (ignore connections through self)
-				myErrorFlag = true;
-			}
-		} else {
-			myErrorFlag = true; // if not relatives, always an error
-			myUnrelatedFlag = true;
-		}
+	for ( auto error_pit = deviceError_v.begin(); error_pit != deviceError_v.end(); error_pit++ ) {
+		if ( error_pit->errorIndex != NMOS_SOURCE_BULK ) continue;
 		if ( gSetup_cvc ) {
-			if ( myDrainError ) {
-				myProblemNets.insert(myConnections.drainId);
-			} else if ( mySourceError ) {
-				myProblemNets.insert(myConnections.sourceId);
+			if ( error_pit->flags & CHECK_DRAIN ) {
+				myProblemNets.insert(drainNet_v[error_pit->deviceId]);
+			} else if ( error_pit->flags & CHECK_SOURCE ) {
+				myProblemNets.insert(sourceNet_v[error_pit->deviceId]);
 			}
-		} else if ( myErrorFlag || myDrainError || mySourceError ) {
-			if ( IncrementDeviceError(myConnections.deviceId, NMOS_SOURCE_BULK) < cvcParameters.cvcCircuitErrorLimit || cvcParameters.cvcCircuitErrorLimit == 0 ) {
-				if ( myUnrelatedFlag ) {
-					errorFile << "Unrelated power error" << endl;
-				}
-				PrintDeviceWithAllConnections(deviceParent_v[device_it], myConnections, errorFile);
-				errorFile << endl;
+			continue;
+		}
+		if ( IncrementDeviceError(error_pit->deviceId, NMOS_SOURCE_BULK) < cvcParameters.cvcCircuitErrorLimit || cvcParameters.cvcCircuitErrorLimit == 0 ) {
+			MapDeviceNets(error_pit->deviceId, myConnections);
+			if ( error_pit->flags & CHECK_UNRELATED ) {
+				errorFile << "Unrelated power error" << endl;
 			}
+			RecordError(NMOS_SOURCE_BULK, deviceParent_v[error_pit->deviceId], myConnections);
+			PrintDeviceWithAllConnections(deviceParent_v[error_pit->deviceId], myConnections, errorFile);
+			errorFile << endl;
 		}
 	}
 	if ( gSetup_cvc ) {
@@ -650,117 +691,122 @@ void CCvcDb::FindNmosSourceVsBulkErrors() {
 	}
 }
 
-void CCvcDb::FindPmosSourceVsBulkErrors() {
-	CFullConnection myConnections;
-	reportFile << "! Checking pmos source/drain vs bias errors: " << endl << endl;
-	errorFile << "! Checking pmos source/drain vs bias errors: " << endl << endl;
-	unordered_set<netId_t> myProblemNets;
-	for ( deviceId_t device_it = 0; device_it < deviceCount; device_it++ ) {
-		CInstance * myInstance_p = instancePtr_v[deviceParent_v[device_it]];
-		CCircuit * myParent_p = myInstance_p->master_p;
-		CDevice * myDevice_p = myParent_p->devicePtr_v[device_it - myInstance_p->firstDeviceId];
-		if ( ! IsPmos_(myDevice_p->model_p->type) ) continue;
-		MapDeviceNets(myInstance_p, myDevice_p, myConnections);
-		if ( myConnections.sourceId == myConnections.drainId && myConnections.sourceId == myConnections.bulkId ) continue;  // ignore drain = source = bulk
-		bool myErrorFlag = false;
-		bool myUnrelatedFlag = false;
-		bool mySourceError = false;
-		bool myDrainError = false;
-		if ( ! myConnections.maxBulkPower_p
-				|| (myConnections.maxBulkPower_p->IsRelatedPower(myConnections.maxSourcePower_p, netVoltagePtr_v, maxNet_v, maxNet_v, true, true)
-					&& myConnections.maxBulkPower_p->IsRelatedPower(myConnections.maxDrainPower_p, netVoltagePtr_v, maxNet_v, maxNet_v, true, true)) ) {
-			// if relatives (default), then checks are conditional
-			if ( (myConnections.minBulkVoltage == myConnections.maxSourceVoltage || myConnections.maxSourceVoltage == UNKNOWN_VOLTAGE)
-					&& (myConnections.minBulkVoltage == myConnections.maxDrainVoltage || myConnections.maxDrainVoltage == UNKNOWN_VOLTAGE) ) continue;
-				 // no error if min bulk = max source = max drain
-			if ( myConnections.maxBulkPower_p && myConnections.maxBulkPower_p->type[HIZ_BIT] ) {
-				if ( myConnections.minSourcePower_p && ! myConnections.maxBulkPower_p->IsRelatedPower(myConnections.minSourcePower_p, netVoltagePtr_v, maxNet_v, minNet_v, false) ) {
-					myErrorFlag = true;
-				} else if ( myConnections.simSourcePower_p && IsKnownVoltage_(myConnections.simSourcePower_p->simVoltage)
-						&& ! myConnections.maxBulkPower_p->IsRelatedPower(myConnections.simSourcePower_p, netVoltagePtr_v, maxNet_v, simNet_v, false)
-						&& myConnections.simSourceVoltage > myConnections.minBulkVoltage ) {
-					myErrorFlag = true;
-				} else if ( myConnections.maxSourcePower_p && ! myConnections.maxBulkPower_p->IsRelatedPower(myConnections.maxSourcePower_p, netVoltagePtr_v, maxNet_v, maxNet_v, false) ) {
-					myErrorFlag = true;
-				} else if ( myConnections.minDrainPower_p && ! myConnections.maxBulkPower_p->IsRelatedPower(myConnections.minDrainPower_p, netVoltagePtr_v, maxNet_v, minNet_v, false) ) {
-					myErrorFlag = true;
-				} else if ( myConnections.simDrainPower_p && IsKnownVoltage_(myConnections.simDrainPower_p->simVoltage)
-						&& ! myConnections.maxBulkPower_p->IsRelatedPower(myConnections.simDrainPower_p, netVoltagePtr_v, maxNet_v, simNet_v, false)
-						&& myConnections.simDrainVoltage > myConnections.minBulkVoltage ) {
-					myErrorFlag = true;
-				} else if ( myConnections.maxDrainPower_p && ! myConnections.maxBulkPower_p->IsRelatedPower(myConnections.maxDrainPower_p, netVoltagePtr_v, maxNet_v, maxNet_v, false) ) {
-					myErrorFlag = true;
-				}
-			} else if ( myConnections.CheckTerminalMaxVoltages(BULK) == false ) {
-				if ( myConnections.minSourcePower_p || myConnections.simSourcePower_p || myConnections.maxSourcePower_p ||
-						myConnections.minDrainPower_p || myConnections.simDrainPower_p || myConnections.maxDrainPower_p ) { // has some connection (all connections open -> no error)
-					myErrorFlag = true;
-				}
-			} else if (	myConnections.CheckTerminalMinVoltages(BULK | SOURCE) &&
-					( ( myConnections.minSourceVoltage - myConnections.minBulkVoltage > cvcParameters.cvcBiasErrorThreshold &&
-							myConnections.minSourcePower_p->defaultMinNet != myConnections.bulkId ) ||
-						( myConnections.minSourceVoltage == myConnections.minBulkVoltage &&
-							cvcParameters.cvcBiasErrorThreshold == 0 &&
-	//						myConnections.masterMinBulkNet.finalNetId != myConnections.masterMaxBulkNet.finalNetId &&
-							myConnections.minSourceVoltage != myConnections.maxBulkVoltage && // no leak path
-							myConnections.masterMinSourceNet.finalResistance > myConnections.masterMinBulkNet.finalResistance &&
-							! myConnections.maxBulkPower_p->type[HIZ_BIT] &&
-							! PathContains(minNet_v, myConnections.sourceId, myConnections.bulkId)) ) ) { // resistance check backwards in PMOS min (ignore connections through self)
+int CCvcDb::CheckNmosSourceVsBulk(CFullConnection & theConnections) {
+	if ( theConnections.sourceId == theConnections.drainId && theConnections.sourceId == theConnections.bulkId ) return 0;  // ignore drain = source = bulk
+	bool myErrorFlag = false;
+	bool myUnrelatedFlag = false;
+	bool mySourceError = false;
+	bool myDrainError = false;
+	if ( ! theConnections.minBulkPower_p
+			|| (theConnections.minBulkPower_p->IsRelatedPower(theConnections.minSourcePower_p, netVoltagePtr_v, minNet_v, minNet_v, true, true)
+				&& theConnections.minBulkPower_p->IsRelatedPower(theConnections.minDrainPower_p, netVoltagePtr_v, minNet_v, minNet_v, true, true)) ) {
+		// if relatives (default), then checks are conditional
+		if ( (theConnections.maxBulkVoltage == theConnections.minSourceVoltage || theConnections.minSourceVoltage == UNKNOWN_VOLTAGE)
+				&& (theConnections.maxBulkVoltage == theConnections.minDrainVoltage || theConnections.minDrainVoltage == UNKNOWN_VOLTAGE) ) return 0;
+			// no error if max bulk = min source = min drain
+		if ( theConnections.minBulkPower_p && theConnections.minBulkPower_p->type[HIZ_BIT] ) {
+			if ( theConnections.sourceId == theConnections.bulkId && theConnections.drainId == theConnections.bulkId ) return 0;
+			if ( theConnections.minSourcePower_p && ! theConnections.minBulkPower_p->IsRelatedPower(theConnections.minSourcePower_p, netVoltagePtr_v, minNet_v, minNet_v, false) ) {
+				myErrorFlag = true;
+			} else if ( theConnections.simSourcePower_p && IsKnownVoltage_(theConnections.simSourcePower_p->simVoltage)
+					&& ! theConnections.minBulkPower_p->IsRelatedPower(theConnections.simSourcePower_p, netVoltagePtr_v, minNet_v, simNet_v, false)
+					&& theConnections.simSourceVoltage < theConnections.maxBulkVoltage ) {
 				myErrorFlag = true;
-			} else if (	myConnections.CheckTerminalMinVoltages(BULK | DRAIN) &&
-					( ( myConnections.minDrainVoltage - myConnections.minBulkVoltage > cvcParameters.cvcBiasErrorThreshold &&
-							myConnections.minDrainPower_p->defaultMinNet != myConnections.bulkId ) ||
-						( myConnections.minDrainVoltage == myConnections.minBulkVoltage &&
-							cvcParameters.cvcBiasErrorThreshold == 0 &&
-	//						myConnections.masterMinBulkNet.finalNetId != myConnections.masterMaxBulkNet.finalNetId &&
-							myConnections.minDrainVoltage != myConnections.maxBulkVoltage && // no leak path
-							myConnections.masterMinDrainNet.finalResistance > myConnections.masterMinBulkNet.finalResistance &&
-							! myConnections.maxBulkPower_p->type[HIZ_BIT] &&
-							! PathContains(minNet_v, myConnections.drainId, myConnections.bulkId)) ) ) { // resistance check backwards in PMOS min (ignore connections through self)
+			} else if ( theConnections.maxSourcePower_p && ! theConnections.minBulkPower_p->IsRelatedPower(theConnections.maxSourcePower_p, netVoltagePtr_v, minNet_v, maxNet_v, false) ) {
 				myErrorFlag = true;
-			} else if (	myConnections.CheckTerminalSimVoltages(BULK | SOURCE) &&
-					( myConnections.simSourceVoltage - myConnections.simBulkVoltage > cvcParameters.cvcBiasErrorThreshold ||
-						( myConnections.simSourceVoltage == myConnections.simBulkVoltage &&
-							cvcParameters.cvcBiasErrorThreshold == 0 &&
-							myConnections.masterSimSourceNet.finalResistance < myConnections.masterSimBulkNet.finalResistance) ) ) {
+			} else if ( theConnections.minDrainPower_p && ! theConnections.minBulkPower_p->IsRelatedPower(theConnections.minDrainPower_p, netVoltagePtr_v, minNet_v, minNet_v, false) ) {
 				myErrorFlag = true;
-			} else if (	myConnections.CheckTerminalSimVoltages(BULK | DRAIN) &&
-					( myConnections.simDrainVoltage - myConnections.simBulkVoltage > cvcParameters.cvcBiasErrorThreshold ||
-						( myConnections.simDrainVoltage == myConnections.simBulkVoltage &&
-							cvcParameters.cvcBiasErrorThreshold == 0 &&
-							myConnections.masterSimDrainNet.finalResistance < myConnections.masterSimBulkNet.finalResistance) ) ) {
+			} else if ( theConnections.simDrainPower_p && IsKnownVoltage_(theConnections.simDrainPower_p->simVoltage)
+					&& ! theConnections.minBulkPower_p->IsRelatedPower(theConnections.simDrainPower_p, netVoltagePtr_v, minNet_v, simNet_v, false)
+					&& theConnections.simDrainVoltage < theConnections.maxBulkVoltage ) {
+				myErrorFlag = true;
+			} else if ( theConnections.maxDrainPower_p && ! theConnections.minBulkPower_p->IsRelatedPower(theConnections.maxDrainPower_p, netVoltagePtr_v, minNet_v, maxNet_v, false) ) {
 				myErrorFlag = true;
-			} else if (	myConnections.CheckTerminalMaxVoltages(BULK | SOURCE) &&
-					( myConnections.maxSourceVoltage - myConnections.maxBulkVoltage > cvcParameters.cvcBiasErrorThreshold ||
-						( myConnections.maxSourceVoltage == myConnections.maxBulkVoltage &&
-							cvcParameters.cvcBiasErrorThreshold == 0 &&
-							myConnections.masterMaxSourceNet.finalResistance < myConnections.masterMaxBulkNet.finalResistance) ) ) {
-				mySourceError = true;
-			} else if (	myConnections.CheckTerminalMaxVoltages(BULK | DRAIN) &&
-					( myConnections.maxDrainVoltage - myConnections.maxBulkVoltage > cvcParameters.cvcBiasErrorThreshold ||
-						( myConnections.maxDrainVoltage == myConnections.maxBulkVoltage &&
-							cvcParameters.cvcBiasErrorThreshold == 0 &&
-							myConnections.masterMaxDrainNet.finalResistance < myConnections.masterMaxBulkNet.finalResistance) ) ) {
-				myDrainError = true;
 			}
-		} else {
-			myUnrelatedFlag = true;
-			myErrorFlag = true; // if not relatives, always an error
+		} else if ( theConnections.CheckTerminalMinVoltages(BULK) == false ) {
+			if ( theConnections.minSourcePower_p || theConnections.simSourcePower_p || theConnections.maxSourcePower_p ||
+					theConnections.minDrainPower_p || theConnections.simDrainPower_p || theConnections.maxDrainPower_p ) { // has some connection (all connections open -> no error)
+				myErrorFlag = true;
+			}
+		} else if ( theConnections.CheckTerminalMinVoltages(BULK | SOURCE) &&
+				( theConnections.minBulkVoltage - theConnections.minSourceVoltage > cvcParameters.cvcBiasErrorThreshold ||
+					( theConnections.minSourceVoltage == theConnections.minBulkVoltage &&
+						cvcParameters.cvcBiasErrorThreshold == 0 &&
+						theConnections.masterMinSourceNet.finalResistance < theConnections.masterMinBulkNet.finalResistance) ) ) {
+			mySourceError = true;
+		} else if (	theConnections.CheckTerminalMinVoltages(BULK | DRAIN) &&
+				( theConnections.minBulkVoltage - theConnections.minDrainVoltage > cvcParameters.cvcBiasErrorThreshold ||
+					( theConnections.minDrainVoltage == theConnections.minBulkVoltage &&
+						cvcParameters.cvcBiasErrorThreshold == 0 &&
+						theConnections.masterMinDrainNet.finalResistance < theConnections.masterMinBulkNet.finalResistance) ) ) {
+			myDrainError = true;
+		} else if (	theConnections.CheckTerminalSimVoltages(BULK | SOURCE) &&
+				( theConnections.simBulkVoltage - theConnections.simSourceVoltage > cvcParameters.cvcBiasErrorThreshold ||
+					( theConnections.simSourceVoltage == theConnections.simBulkVoltage &&
+						cvcParameters.cvcBiasErrorThreshold == 0 &&
+						theConnections.masterSimSourceNet.finalResistance < theConnections.masterSimBulkNet.finalResistance) ) ) {
+			myErrorFlag = true;
+		} else if (	theConnections.CheckTerminalSimVoltages(BULK | DRAIN) &&
+				( theConnections.simBulkVoltage - theConnections.simDrainVoltage > cvcParameters.cvcBiasErrorThreshold ||
+					( theConnections.simDrainVoltage == theConnections.simBulkVoltage &&
+						cvcParameters.cvcBiasErrorThreshold == 0 &&
+						theConnections.masterSimDrainNet.finalResistance < theConnections.masterSimBulkNet.finalResistance) ) ) {
+			myErrorFlag = true;
+		} else if (	theConnections.CheckTerminalMaxVoltages(BULK | SOURCE) &&
+				( ( theConnections.maxBulkVoltage - theConnections.maxSourceVoltage > cvcParameters.cvcBiasErrorThreshold &&
+						theConnections.maxSourcePower_p->defaultMaxNet != theConnections.bulkId ) ||
+					( theConnections.maxSourceVoltage == theConnections.maxBulkVoltage &&
+						cvcParameters.cvcBiasErrorThreshold == 0 &&
+						theConnections.maxSourceVoltage != theConnections.minBulkVoltage && // no leak path
+//						theConnections.masterMinBulkNet.finalNetId != theConnections.masterMaxBulkNet.finalNetId &&
+						theConnections.masterMaxSourceNet.finalResistance > theConnections.masterMaxBulkNet.finalResistance &&
+						! theConnections.minBulkPower_p->type[HIZ_BIT] &&
+						! PathContains(maxNet_v, theConnections.sourceId, theConnections.bulkId)) ) ) { // resistance check backwards in NMOS max (ignore connections through self)
+			myErrorFlag = true;
+// Added 20140523
+		} else if (	theConnections.CheckTerminalMaxVoltages(BULK | DRAIN) &&
+				( ( theConnections.maxBulkVoltage - theConnections.maxDrainVoltage > cvcParameters.cvcBiasErrorThreshold &&
+						theConnections.maxDrainPower_p->defaultMaxNet != theConnections.bulkId ) ||
+					( theConnections.maxDrainVoltage == theConnections.maxBulkVoltage &&
+						cvcParameters.cvcBiasErrorThreshold == 0 &&
+						theConnections.maxDrainVoltage != theConnections.minBulkVoltage && // no leak path
+//						theConnections.masterMinBulkNet.finalNetId != theConnections.masterMaxBulkNet.finalNetId &&
+						theConnections.masterMaxDrainNet.finalResistance > theConnections.masterMaxBulkNet.finalResistance &&
+						! theConnections.minBulkPower_p->type[HIZ_BIT] &&
+						! PathContains(maxNet_v, theConnections.drainId, theConnections.bulkId)) ) ) { // resistance check backwards in NMOS max (ignore connections through self)
+			myErrorFlag = true;
 		}
+	} else {
+		myErrorFlag = true; // if not relatives, always an error
+		myUnrelatedFlag = true;
+	}
+	return ( myErrorFlag ? CHECK_ERROR : 0 ) | ( myUnrelatedFlag ? CHECK_UNRELATED : 0 )
+		| ( mySourceError ? CHECK_SOURCE : 0 ) | ( myDrainError ? CHECK_DRAIN : 0 );
+}
+
+void CCvcDb::FindPmosSourceVsBulkErrors() {
+	CFullConnection myConnections;
+	reportFile << "! Checking pmos source/drain vs bias errors: " << endl << endl;
+	errorFile << "! Checking pmos source/drain vs bias errors: " << endl << endl;
+	unordered_set<netId_t> myProblemNets;
+	for ( auto error_pit = deviceError_v.begin(); error_pit != deviceError_v.end(); error_pit++ ) {
+		if ( error_pit->errorIndex != PMOS_SOURCE_BULK ) continue;
 		if ( gSetup_cvc ) {
-			if ( myDrainError ) {
-				myProblemNets.insert(myConnections.drainId);
-			} else if ( mySourceError ) {
-				myProblemNets.insert(myConnections.sourceId);
+			if ( error_pit->flags & CHECK_DRAIN ) {
+				myProblemNets.insert(drainNet_v[error_pit->deviceId]);
+			} else if ( error_pit->flags & CHECK_SOURCE ) {
+				myProblemNets.insert(sourceNet_v[error_pit->deviceId]);
 			}
-		} else if ( myErrorFlag || myDrainError || mySourceError ) {
-			if ( IncrementDeviceError(myConnections.deviceId, PMOS_SOURCE_BULK) < cvcParameters.cvcCircuitErrorLimit || cvcParameters.cvcCircuitErrorLimit == 0 ) {
-				if ( myUnrelatedFlag ) {
-					errorFile << "Unrelated power error" << endl;
-				}
-				PrintDeviceWithAllConnections(deviceParent_v[device_it], myConnections, errorFile);
-				errorFile << endl;
+			continue;
+		}
+		if ( IncrementDeviceError(error_pit->deviceId, PMOS_SOURCE_BULK) < cvcParameters.cvcCircuitErrorLimit || cvcParameters.cvcCircuitErrorLimit == 0 ) {
+			MapDeviceNets(error_pit->deviceId, myConnections);
+			if ( error_pit->flags & CHECK_UNRELATED ) {
+				errorFile << "Unrelated power error" << endl;
 			}
+			RecordError(PMOS_SOURCE_BULK, deviceParent_v[error_pit->deviceId], myConnections);
+			PrintDeviceWithAllConnections(deviceParent_v[error_pit->deviceId], myConnections, errorFile);
+			errorFile << endl;
 		}
 	}
 	if ( gSetup_cvc ) {
@@ -798,207 +844,307 @@ void CCvcDb::FindPmosSourceVsBulkErrors() {
 	}
 }
 
+int CCvcDb::CheckPmosSourceVsBulk(CFullConnection & theConnections) {
+	if ( theConnections.sourceId == theConnections.drainId && theConnections.sourceId == theConnections.bulkId ) return 0;  // ignore drain = source = bulk
+	bool myErrorFlag = false;
+	bool myUnrelatedFlag = false;
+	bool mySourceError = false;
+	bool myDrainError = false;
+	if ( ! theConnections.maxBulkPower_p
+			|| (theConnections.maxBulkPower_p->IsRelatedPower(theConnections.maxSourcePower_p, netVoltagePtr_v, maxNet_v, maxNet_v, true, true)
+				&& theConnections.maxBulkPower_p->IsRelatedPower(theConnections.maxDrainPower_p, netVoltagePtr_v, maxNet_v, maxNet_v, true, true)) ) {
+		// if relatives (default), then checks are conditional
+		if ( (theConnections.minBulkVoltage == theConnections.maxSourceVoltage || theConnections.maxSourceVoltage == UNKNOWN_VOLTAGE)
+				&& (theConnections.minBulkVoltage == theConnections.maxDrainVoltage || theConnections.maxDrainVoltage == UNKNOWN_VOLTAGE) ) return 0;
+			 // no error if min bulk = max source = max drain
+		if ( theConnections.maxBulkPower_p && theConnections.maxBulkPower_p->type[HIZ_BIT] ) {
+			if ( theConnections.minSourcePower_p && ! theConnections.maxBulkPower_p->IsRelatedPower(theConnections.minSourcePower_p, netVoltagePtr_v, maxNet_v, minNet_v, false) ) {
+				myErrorFlag = true;
+			} else if ( theConnections.simSourcePower_p && IsKnownVoltage_(theConnections.simSourcePower_p->simVoltage)
+					&& ! theConnections.maxBulkPower_p->IsRelatedPower(theConnections.simSourcePower_p, netVoltagePtr_v, maxNet_v, simNet_v, false)
+					&& theConnections.simSourceVoltage > theConnections.minBulkVoltage ) {
+				myErrorFlag = true;
+			} else if ( theConnections.maxSourcePower_p && ! theConnections.maxBulkPower_p->IsRelatedPower(theConnections.maxSourcePower_p, netVoltagePtr_v, maxNet_v, maxNet_v, false) ) {
+				myErrorFlag = true;
+			} else if ( theConnections.minDrainPower_p && ! theConnections.maxBulkPower_p->IsRelatedPower(theConnections.minDrainPower_p, netVoltagePtr_v, maxNet_v, minNet_v, false) ) {
+				myErrorFlag = true;
+			} else if ( theConnections.simDrainPower_p && IsKnownVoltage_(theConnections.simDrainPower_p->simVoltage)
+					&& ! theConnections.maxBulkPower_p->IsRelatedPower(theConnections.simDrainPower_p, netVoltagePtr_v, maxNet_v, simNet_v, false)
+					&& theConnections.simDrainVoltage > theConnections.minBulkVoltage ) {
+				myErrorFlag = true;
+			} else if ( theConnections.maxDrainPower_p && ! theConnections.maxBulkPower_p->IsRelatedPower(theConnections.maxDrainPower_p, netVoltagePtr_v, maxNet_v, maxNet_v, false) ) {
+				myErrorFlag = true;
+			}
+		} else if ( theConnections.CheckTerminalMaxVoltages(BULK) == false ) {
+			if ( theConnections.minSourcePower_p || theConnections.simSourcePower_p || theConnections.maxSourcePower_p ||
+					theConnections.minDrainPower_p || theConnections.simDrainPower_p || theConnections.maxDrainPower_p ) { // has some connection (all connections open -> no error)
+				myErrorFlag = true;
+			}
+		} else if (	theConnections.CheckTerminalMinVoltages(BULK | SOURCE) &&
+				( ( theConnections.minSourceVoltage - theConnections.minBulkVoltage > cvcParameters.cvcBiasErrorThreshold &&
+						theConnections.minSourcePower_p->defaultMinNet != theConnections.bulkId ) ||
+					( theConnections.minSourceVoltage == theConnections.minBulkVoltage &&
+						cvcParameters.cvcBiasErrorThreshold == 0 &&
+//						theConnections.masterMinBulkNet.finalNetId != theConnections.masterMaxBulkNet.finalNetId &&
+						theConnections.minSourceVoltage != theConnections.maxBulkVoltage && // no leak path
+						theConnections.masterMinSourceNet.finalResistance > theConnections.masterMinBulkNet.finalResistance &&
+						! theConnections.maxBulkPower_p->type[HIZ_BIT] &&
+						! PathContains(minNet_v, theConnections.sourceId, theConnections.bulkId)) ) ) { // resistance check backwards in PMOS min (ignore connections through self)
+			myErrorFlag = true;
+		} else if (	theConnections.CheckTerminalMinVoltages(BULK | DRAIN) &&
+				( ( theConnections.minDrainVoltage - theConnections.minBulkVoltage > cvcParameters.cvcBiasErrorThreshold &&
+						theConnections.minDrainPower_p->defaultMinNet != theConnections.bulkId ) ||
+					( theConnections.minDrainVoltage == theConnections.minBulkVoltage &&
+						cvcParameters.cvcBiasErrorThreshold == 0 &&
+//						theConnections.masterMinBulkNet.finalNetId != theConnections.masterMaxBulkNet.finalNetId &&
+						theConnections.minDrainVoltage != theConnections.maxBulkVoltage && // no leak path
+						theConnections.masterMinDrainNet.finalResistance > theConnections.masterMinBulkNet.finalResistance &&
+						! theConnections.maxBulkPower_p->type[HIZ_BIT] &&
+						! PathContains(minNet_v, theConnections.drainId, theConnections.bulkId)) ) ) { // resistance check backwards in PMOS min (ignore connections through self)
+			myErrorFlag = true;
+		} else if (	theConnections.CheckTerminalSimVoltages(BULK | SOURCE) &&
+				( theConnections.simSourceVoltage - theConnections.simBulkVoltage > cvcParameters.cvcBiasErrorThreshold ||
+					( theConnections.simSourceVoltage == theConnections.simBulkVoltage &&
+						cvcParameters.cvcBiasErrorThreshold == 0 &&
+						theConnections.masterSimSourceNet.finalResistance < theConnections.masterSimBulkNet.finalResistance) ) ) {
+			myErrorFlag = true;
+		} else if (	theConnections.CheckTerminalSimVoltages(BULK | DRAIN) &&
+				( theConnections.simDrainVoltage - theConnections.simBulkVoltage > cvcParameters.cvcBiasErrorThreshold ||
+					( theConnections.simDrainVoltage == theConnections.simBulkVoltage &&
+						cvcParameters.cvcBiasErrorThreshold == 0 &&
+						theConnections.masterSimDrainNet.finalResistance < theConnections.masterSimBulkNet.finalResistance) ) ) {
+			myErrorFlag = true;
+		} else if (	theConnections.CheckTerminalMaxVoltages(BULK | SOURCE) &&
+				( theConnections.maxSourceVoltage - theConnections.maxBulkVoltage > cvcParameters.cvcBiasErrorThreshold ||
+					( theConnections.maxSourceVoltage == theConnections.maxBulkVoltage &&
+						cvcParameters.cvcBiasErrorThreshold == 0 &&
+						theConnections.masterMaxSourceNet.finalResistance < theConnections.masterMaxBulkNet.finalResistance) ) ) {
+			mySourceError = true;
+		} else if (	theConnections.CheckTerminalMaxVoltages(BULK | DRAIN) &&
+				( theConnections.maxDrainVoltage - theConnections.maxBulkVoltage > cvcParameters.cvcBiasErrorThreshold ||
+					( theConnections.maxDrainVoltage == theConnections.maxBulkVoltage &&
+						cvcParameters.cvcBiasErrorThreshold == 0 &&
+						theConnections.masterMaxDrainNet.finalResistance < theConnections.masterMaxBulkNet.finalResistance) ) ) {
+			myDrainError = true;
+		}
+	} else {
+		myUnrelatedFlag = true;
+		myErrorFlag = true; // if not relatives, always an error
+	}
+	return ( myErrorFlag ? CHECK_ERROR : 0 ) | ( myUnrelatedFlag ? CHECK_UNRELATED : 0 )
+		| ( mySourceError ? CHECK_SOURCE : 0 ) | ( myDrainError ? CHECK_DRAIN : 0 );
+}
+
 void CCvcDb::FindForwardBiasDiodes() {
 	CFullConnection myConnections;
-	CFullConnection myDiodeConnections;
 	reportFile << "! Checking forward bias diode errors: " << endl << endl;
 	errorFile << "! Checking forward bias diode errors: " << endl << endl;
-	for ( deviceId_t device_it = 0; device_it < deviceCount; device_it++ ) {
-		CInstance * myInstance_p = instancePtr_v[deviceParent_v[device_it]];
-		CCircuit * myParent_p = myInstance_p->master_p;
-		CDevice * myDevice_p = myParent_p->devicePtr_v[device_it - myInstance_p->firstDeviceId];
-//		if ( myDevice_p->model_p->type != DIODE ) continue;
-		if ( IsNmos_(deviceType_v[device_it]) || IsPmos_(deviceType_v[device_it]) ) continue;
-		if ( myDevice_p->model_p->diodeList.empty() ) continue;
-		MapDeviceNets(myInstance_p, myDevice_p, myConnections);
+	for ( auto error_pit = deviceError_v.begin(); error_pit != deviceError_v.end(); error_pit++ ) {
+		if ( error_pit->errorIndex != FORWARD_DIODE ) continue;
+		if ( error_pit->flags & CHECK_LOG ) {
+			MapDeviceNets(error_pit->deviceId, myConnections);
+			CheckForwardBiasDiode(myConnections, true);  // print unexpected diode information
+		}
+		if ( ! (error_pit->flags & CHECK_ERROR) ) continue;
+		if ( IncrementDeviceError(error_pit->deviceId, FORWARD_DIODE) < cvcParameters.cvcCircuitErrorLimit || cvcParameters.cvcCircuitErrorLimit == 0 ) {
+			MapDeviceNets(error_pit->deviceId, myConnections);
+			if ( error_pit->flags & CHECK_UNRELATED ) {
+				errorFile << "Unrelated power error" << endl;
+			}
+			RecordError(FORWARD_DIODE, deviceParent_v[error_pit->deviceId], myConnections);
+			PrintDeviceWithAllConnections(deviceParent_v[error_pit->deviceId], myConnections, errorFile);
+			errorFile << endl;
+		}
+	}
+	cvcCircuitList.PrintAndResetCircuitErrors(this, cvcParameters.cvcCircuitErrorLimit, logFile, errorFile, "! Checking forward bias diode errors: ");
+}
+
+int CCvcDb::CheckForwardBiasDiode(CFullConnection & theConnections, bool theLogFlag) {
+	// without theLogFlag, returns CHECK_LOG instead of printing unexpected diodes to logFile
+	CFullConnection myDiodeConnections;
+	int myLogFlag = 0;
+	for ( auto diode_pit = theConnections.device_p->model_p->diodeList.begin(); diode_pit != theConnections.device_p->model_p->diodeList.end(); diode_pit++ ) {
+		SetDiodeConnections((*diode_pit), theConnections, myDiodeConnections);  // switch connections for diodes
+		if ( GetEquivalentNet(myDiodeConnections.originalSourceId) == GetEquivalentNet(myDiodeConnections.originalDrainId) ) continue;
 		bool myErrorFlag = false;
-		for ( auto diode_pit = myDevice_p->model_p->diodeList.begin(); diode_pit != myDevice_p->model_p->diodeList.end(); diode_pit++ ) {
-			if ( myErrorFlag ) continue;  // only one error per device
-			SetDiodeConnections((*diode_pit), myConnections, myDiodeConnections);  // switch connections for diodes
-			if ( GetEquivalentNet(myDiodeConnections.originalSourceId) == GetEquivalentNet(myDiodeConnections.originalDrainId) ) continue;
-			bool myUnrelatedFlag = false;
-			if ( myDiodeConnections.CheckTerminalMinMaxVoltages(SOURCE | DRAIN) ) {
-				voltage_t mySourceVoltage = UNKNOWN_VOLTAGE, myDrainVoltage = UNKNOWN_VOLTAGE;
-				if ( myDiodeConnections.minSourcePower_p == myDiodeConnections.minDrainPower_p ) {
-					if ( myDiodeConnections.maxSourceVoltage == myDiodeConnections.maxDrainVoltage
-							&& myDiodeConnections.minSourceVoltage == myDiodeConnections.maxDrainVoltage ) continue;
-					if ( myDiodeConnections.masterMinSourceNet.finalResistance < myDiodeConnections.masterMinDrainNet.finalResistance ) {
-						mySourceVoltage = myDiodeConnections.minSourceVoltage;
-					} else if ( myDiodeConnections.masterMinSourceNet.finalResistance > myDiodeConnections.masterMinDrainNet.finalResistance ) {
-						myDrainVoltage = myDiodeConnections.minDrainVoltage;
-					}
-				}
-				if ( myDiodeConnections.maxSourcePower_p == myDiodeConnections.maxDrainPower_p ) {
-					if ( myDiodeConnections.masterMaxDrainNet.finalResistance < myDiodeConnections.masterMaxSourceNet.finalResistance ) {
-						if (myDrainVoltage == UNKNOWN_VOLTAGE) {
-							myDrainVoltage = myDiodeConnections.maxDrainVoltage; // min drain overrides
-						} else if ( PathCrosses(maxNet_v, myDiodeConnections.sourceId, minNet_v, myDiodeConnections.drainId) ) {
-							continue; // no error if anode to power crosses cathode to ground path
-						} else {
-							logFile << "INFO: unexpected diode " << DeviceName(device_it, PRINT_CIRCUIT_ON) << endl << endl;
-							PrintVirtualNet<CVirtualNetVector>(maxNet_v, myDiodeConnections.sourceId, "Max anode path", logFile);
-							PrintVirtualNet<CVirtualNetVector>(minNet_v, myDiodeConnections.sourceId, "Min anode path", logFile);
-							PrintVirtualNet<CVirtualNetVector>(maxNet_v, myDiodeConnections.drainId, "Max cathode path", logFile);
-							PrintVirtualNet<CVirtualNetVector>(minNet_v, myDiodeConnections.drainId, "Min cathode path", logFile);
-						}
-					} else {
-						if ( PathCrosses(minNet_v, myDiodeConnections.drainId, maxNet_v, myDiodeConnections.sourceId) ) {
-							continue; // no error if anode to power crosses cathode to ground path
-						} else if ( mySourceVoltage != UNKNOWN_VOLTAGE ) {
-							logFile << "INFO: unexpected diode " << DeviceName(device_it, PRINT_CIRCUIT_ON) << endl << endl;
-							PrintVirtualNet<CVirtualNetVector>(maxNet_v, myDiodeConnections.sourceId, "Max anode path", logFile);
-							PrintVirtualNet<CVirtualNetVector>(minNet_v, myDiodeConnections.sourceId, "Min anode path", logFile);
-							PrintVirtualNet<CVirtualNetVector>(maxNet_v, myDiodeConnections.drainId, "Max cathode path", logFile);
-							PrintVirtualNet<CVirtualNetVector>(minNet_v, myDiodeConnections.drainId, "Min cathode path", logFile);
-						}
-						mySourceVoltage = myDiodeConnections.maxSourceVoltage; // max source overrides
-					}
-				}
-				if ( mySourceVoltage == UNKNOWN_VOLTAGE ) {
-					mySourceVoltage = myDiodeConnections.maxSourceVoltage;
-				}
-				if ( myDrainVoltage == UNKNOWN_VOLTAGE ) {
+		bool myUnrelatedFlag = false;
+		if ( myDiodeConnections.CheckTerminalMinMaxVoltages(SOURCE | DRAIN) ) {
+			voltage_t mySourceVoltage = UNKNOWN_VOLTAGE, myDrainVoltage = UNKNOWN_VOLTAGE;
+			if ( myDiodeConnections.minSourcePower_p == myDiodeConnections.minDrainPower_p ) {
+				if ( myDiodeConnections.maxSourceVoltage == myDiodeConnections.maxDrainVoltage
+						&& myDiodeConnections.minSourceVoltage == myDiodeConnections.maxDrainVoltage ) continue;
+				if ( myDiodeConnections.masterMinSourceNet.finalResistance < myDiodeConnections.masterMinDrainNet.finalResistance ) {
+					mySourceVoltage = myDiodeConnections.minSourceVoltage;
+				} else if ( myDiodeConnections.masterMinSourceNet.finalResistance > myDiodeConnections.masterMinDrainNet.finalResistance ) {
 					myDrainVoltage = myDiodeConnections.minDrainVoltage;
 				}
-				if ( mySourceVoltage - myDrainVoltage > cvcParameters.cvcForwardErrorThreshold ) {
-					if ( myDiodeConnections.maxSourcePower_p->type[HIZ_BIT] || myDiodeConnections.minDrainPower_p->type[HIZ_BIT] ) {
-						// the following are errors for cutoff power. unknown annode, unknown cathode, source > max drain, max source not related to min drain
-						if ( mySourceVoltage == UNKNOWN_VOLTAGE || myDiodeConnections.maxDrainVoltage == UNKNOWN_VOLTAGE || mySourceVoltage > myDiodeConnections.maxDrainVoltage ) {
-								myErrorFlag = true;
-						} else if ( ! myDiodeConnections.maxSourcePower_p->IsRelatedPower(myDiodeConnections.minDrainPower_p, netVoltagePtr_v, maxNet_v, minNet_v, true)) {
-								myErrorFlag = true;
-						}
+			}
+			if ( myDiodeConnections.maxSourcePower_p == myDiodeConnections.maxDrainPower_p ) {
+				if ( myDiodeConnections.masterMaxDrainNet.finalResistance < myDiodeConnections.masterMaxSourceNet.finalResistance ) {
+					if (myDrainVoltage == UNKNOWN_VOLTAGE) {
+						myDrainVoltage = myDiodeConnections.maxDrainVoltage; // min drain overrides
+					} else if ( PathCrosses(maxNet_v, myDiodeConnections.sourceId, minNet_v, myDiodeConnections.drainId) ) {
+						continue; // no error if anode to power crosses cathode to ground path
+					} else if ( theLogFlag ) {
+						logFile << "INFO: unexpected diode " << DeviceName(theConnections.deviceId, PRINT_CIRCUIT_ON) << endl << endl;
+						PrintVirtualNet<CVirtualNetVector>(maxNet_v, myDiodeConnections.sourceId, "Max anode path", logFile);
+						PrintVirtualNet<CVirtualNetVector>(minNet_v, myDiodeConnections.sourceId, "Min anode path", logFile);
+						PrintVirtualNet<CVirtualNetVector>(maxNet_v, myDiodeConnections.drainId, "Max cathode path", logFile);
+						PrintVirtualNet<CVirtualNetVector>(minNet_v, myDiodeConnections.drainId, "Min cathode path", logFile);
 					} else {
-						myErrorFlag = true;
+						myLogFlag = CHECK_LOG;  // printed later on one thread
 					}
-				} else if ( ! myDiodeConnections.minSourcePower_p->IsRelatedPower(myDiodeConnections.minDrainPower_p, netVoltagePtr_v, minNet_v, minNet_v, true, true)
-						|| ! myDiodeConnections.maxSourcePower_p->IsRelatedPower(myDiodeConnections.maxDrainPower_p, netVoltagePtr_v, maxNet_v, maxNet_v, true, true) ) {
-					myErrorFlag = true;
-					myUnrelatedFlag = true;
-				}
-			} else if ( myDiodeConnections.CheckTerminalMinMaxVoltages(SOURCE) && ! myDiodeConnections.CheckTerminalMinMaxVoltages(DRAIN) ) {
-				if ( myDiodeConnections.maxSourceVoltage > 0 && ! myDiodeConnections.maxSourcePower_p->type[HIZ_BIT] ) {
-					myErrorFlag = true;
-				}
-			} else if ( ! myDiodeConnections.CheckTerminalMinMaxVoltages(SOURCE) && myDiodeConnections.CheckTerminalMinMaxVoltages(DRAIN) ) {
-				if ( myDiodeConnections.minDrainVoltage <= 0 && ! myDiodeConnections.minDrainPower_p->type[HIZ_BIT] ) {
-					myErrorFlag = true;
+				} else {
+					if ( PathCrosses(minNet_v, myDiodeConnections.drainId, maxNet_v, myDiodeConnections.sourceId) ) {
+						continue; // no error if anode to power crosses cathode to ground path
+					} else if ( mySourceVoltage != UNKNOWN_VOLTAGE && theLogFlag ) {
+						logFile << "INFO: unexpected diode " << DeviceName(theConnections.deviceId, PRINT_CIRCUIT_ON) << endl << endl;
+						PrintVirtualNet<CVirtualNetVector>(maxNet_v, myDiodeConnections.sourceId, "Max anode path", logFile);
+						PrintVirtualNet<CVirtualNetVector>(minNet_v, myDiodeConnections.sourceId, "Min anode path", logFile);
+						PrintVirtualNet<CVirtualNetVector>(maxNet_v, myDiodeConnections.drainId, "Max cathode path", logFile);
+						PrintVirtualNet<CVirtualNetVector>(minNet_v, myDiodeConnections.drainId, "Min cathode path", logFile);
+					} else if ( mySourceVoltage != UNKNOWN_VOLTAGE ) {
+						myLogFlag = CHECK_LOG;
+					}
+					mySourceVoltage = myDiodeConnections.maxSourceVoltage; // max source overrides
 				}
 			}
-			if ( myErrorFlag ) {
-				if ( IncrementDeviceError(myConnections.deviceId, FORWARD_DIODE) < cvcParameters.cvcCircuitErrorLimit || cvcParameters.cvcCircuitErrorLimit == 0 ) {
-					if ( myUnrelatedFlag ) {
-						errorFile << "Unrelated power error" << endl;
+			if ( mySourceVoltage == UNKNOWN_VOLTAGE ) {
+				mySourceVoltage = myDiodeConnections.maxSourceVoltage;
+			}
+			if ( myDrainVoltage == UNKNOWN_VOLTAGE ) {
+				myDrainVoltage = myDiodeConnections.minDrainVoltage;
+			}
+			if ( mySourceVoltage - myDrainVoltage > cvcParameters.cvcForwardErrorThreshold ) {
+				if ( myDiodeConnections.maxSourcePower_p->type[HIZ_BIT] || myDiodeConnections.minDrainPower_p->type[HIZ_BIT] ) {
+					// the following are errors for cutoff power. unknown annode, unknown cathode, source > max drain, max source not related to min drain
+					if ( mySourceVoltage == UNKNOWN_VOLTAGE || myDiodeConnections.maxDrainVoltage == UNKNOWN_VOLTAGE || mySourceVoltage > myDiodeConnections.maxDrainVoltage ) {
+							myErrorFlag = true;
+					} else if ( ! myDiodeConnections.maxSourcePower_p->IsRelatedPower(myDiodeConnections.minDrainPower_p, netVoltagePtr_v, maxNet_v, minNet_v, true)) {
+							myErrorFlag = true;
 					}
-					PrintDeviceWithAllConnections(deviceParent_v[device_it], myConnections, errorFile);
-					errorFile << endl;
+				} else {
+					myErrorFlag = true;
 				}
+			} else if ( ! myDiodeConnections.minSourcePower_p->IsRelatedPower(myDiodeConnections.minDrainPower_p, netVoltagePtr_v, minNet_v, minNet_v, true, true)
+					|| ! myDiodeConnections.maxSourcePower_p->IsRelatedPower(myDiodeConnections.maxDrainPower_p, netVoltagePtr_v, maxNet_v, maxNet_v, true, true) ) {
+				myErrorFlag = true;
+				myUnrelatedFlag = true;
+			}
+		} else if ( myDiodeConnections.CheckTerminalMinMaxVoltages(SOURCE) && ! myDiodeConnections.CheckTerminalMinMaxVoltages(DRAIN) ) {
+			if ( myDiodeConnections.maxSourceVoltage > 0 && ! myDiodeConnections.maxSourcePower_p->type[HIZ_BIT] ) {
+				myErrorFlag = true;
+			}
+		} else if ( ! myDiodeConnections.CheckTerminalMinMaxVoltages(SOURCE) && myDiodeConnections.CheckTerminalMinMaxVoltages(DRAIN) ) {
+			if ( myDiodeConnections.minDrainVoltage <= 0 && ! myDiodeConnections.minDrainPower_p->type[HIZ_BIT] ) {
+				myErrorFlag = true;
 			}
 		}
+		if ( myErrorFlag ) return CHECK_ERROR | myLogFlag | ( myUnrelatedFlag ? CHECK_UNRELATED : 0 );  // only one error per device
 	}
-	cvcCircuitList.PrintAndResetCircuitErrors(this, cvcParameters.cvcCircuitErrorLimit, logFile, errorFile, "! Checking forward bias diode errors: ");
+	return myLogFlag;
 }
 
 void CCvcDb::FindNmosPossibleLeakErrors() {
 	CFullConnection myConnections;
 	reportFile << "! Checking nmos possible leak errors: " << endl << endl;
 	errorFile << "! Checking nmos possible leak errors: " << endl << endl;
-	for ( deviceId_t device_it = 0; device_it < deviceCount; device_it++ ) {
-		CInstance * myInstance_p = instancePtr_v[deviceParent_v[device_it]];
-		CCircuit * myParent_p = myInstance_p->master_p;
-		CDevice * myDevice_p = myParent_p->devicePtr_v[device_it - myInstance_p->firstDeviceId];
-		if ( ! IsNmos_(myDevice_p->model_p->type) ) continue;
-		bool myErrorFlag = false;
-		MapDeviceNets(myInstance_p, myDevice_p, myConnections);
-		if ( IsKnownVoltage_(myConnections.simGateVoltage) ) continue;
-		if ( myConnections.CheckTerminalMinVoltages(SOURCE | DRAIN) == true ) {
-			voltage_t myMaxGateVoltage = MaxVoltage(myConnections.gateId);
-			if ( myMaxGateVoltage == UNKNOWN_VOLTAGE ) {
-				myMaxGateVoltage = MaxLeakVoltage(myConnections.gateId);
-			}
-			if ( myMaxGateVoltage != UNKNOWN_VOLTAGE
-					&& myMaxGateVoltage <= myConnections.minSourceVoltage + myConnections.device_p->model_p->Vth
-					&& myMaxGateVoltage <= myConnections.minDrainVoltage + myConnections.device_p->model_p->Vth ) {
-				continue;  // always off
-			}
+	for ( auto error_pit = deviceError_v.begin(); error_pit != deviceError_v.end(); error_pit++ ) {
+		if ( error_pit->errorIndex != NMOS_POSSIBLE_LEAK ) continue;
+		if ( IncrementDeviceError(error_pit->deviceId, NMOS_POSSIBLE_LEAK) < cvcParameters.cvcCircuitErrorLimit || cvcParameters.cvcCircuitErrorLimit == 0 ) {
+			MapDeviceNets(error_pit->deviceId, myConnections);
+			RecordError(NMOS_POSSIBLE_LEAK, deviceParent_v[error_pit->deviceId], myConnections);
+			PrintDeviceWithAllConnections(deviceParent_v[error_pit->deviceId], myConnections, errorFile);
+			errorFile << endl;
 		}
-		if ( myConnections.CheckTerminalSimVoltages(SOURCE | DRAIN) == true ) {
-			if ( myConnections.simSourceVoltage == myConnections.simDrainVoltage ) continue;
-			if ( abs(myConnections.simSourceVoltage - myConnections.simDrainVoltage) <= cvcParameters.cvcLeakErrorThreshold ) continue;
-			if ( myConnections.simSourcePower_p->type[HIZ_BIT] &&
-					! myConnections.simSourcePower_p->IsRelatedPower(myConnections.simDrainPower_p, netVoltagePtr_v, simNet_v, simNet_v, false) ) {
-				;  // possible leaks to cutoff power
-			} else if ( myConnections.simDrainPower_p->type[HIZ_BIT] &&
-					! myConnections.simDrainPower_p->IsRelatedPower(myConnections.simSourcePower_p, netVoltagePtr_v, simNet_v, simNet_v, false) ) {
-				;  // possible leaks to cutoff power
-			} else if ( myConnections.simSourcePower_p->IsInternalOverride() || myConnections.simDrainPower_p->IsInternalOverride() ) {
-				continue;
-			} else if ( myConnections.simSourcePower_p->type[SIM_CALCULATED_BIT] || myConnections.simDrainPower_p->type[SIM_CALCULATED_BIT] ) {
-				if ( myConnections.EstimatedCurrent() <= cvcParameters.cvcLeakLimit ) continue;
-			}
-			myErrorFlag = true;
-		} else if ( myConnections.EstimatedMinimumCurrent() > cvcParameters.cvcLeakLimit ) {
-			myErrorFlag = true;
+	}
+	cvcCircuitList.PrintAndResetCircuitErrors(this, cvcParameters.cvcCircuitErrorLimit, logFile, errorFile, "! Checking nmos possible leak errors: ");
+}
+
+int CCvcDb::CheckNmosPossibleLeak(CFullConnection & theConnections) {
+	bool myErrorFlag = false;
+	if ( IsKnownVoltage_(theConnections.simGateVoltage) ) return 0;
+	if ( theConnections.CheckTerminalMinVoltages(SOURCE | DRAIN) == true ) {
+		voltage_t myMaxGateVoltage = theConnections.maxGateVoltage;  // same as MaxVoltage(gateId)
+		if ( myMaxGateVoltage == UNKNOWN_VOLTAGE ) {
+			myMaxGateVoltage = MaxLeakVoltage(theConnections.gateId);
 		}
-		if ( myErrorFlag ) {
-			if ( IncrementDeviceError(myConnections.deviceId, NMOS_POSSIBLE_LEAK) < cvcParameters.cvcCircuitErrorLimit || cvcParameters.cvcCircuitErrorLimit == 0 ) {
-				PrintDeviceWithAllConnections(deviceParent_v[device_it], myConnections, errorFile);
-				errorFile << endl;
-			}
+		if ( myMaxGateVoltage != UNKNOWN_VOLTAGE
+				&& myMaxGateVoltage <= theConnections.minSourceVoltage + theConnections.device_p->model_p->Vth
+				&& myMaxGateVoltage <= theConnections.minDrainVoltage + theConnections.device_p->model_p->Vth ) {
+			return 0;  // always off
 		}
 	}
-	cvcCircuitList.PrintAndResetCircuitErrors(this, cvcParameters.cvcCircuitErrorLimit, logFile, errorFile, "! Checking nmos possible leak errors: ");
+	if ( theConnections.CheckTerminalSimVoltages(SOURCE | DRAIN) == true ) {
+		if ( theConnections.simSourceVoltage == theConnections.simDrainVoltage ) return 0;
+		if ( abs(theConnections.simSourceVoltage - theConnections.simDrainVoltage) <= cvcParameters.cvcLeakErrorThreshold ) return 0;
+		if ( theConnections.simSourcePower_p->type[HIZ_BIT] &&
+				! theConnections.simSourcePower_p->IsRelatedPower(theConnections.simDrainPower_p, netVoltagePtr_v, simNet_v, simNet_v, false) ) {
+			;  // possible leaks to cutoff power
+		} else if ( theConnections.simDrainPower_p->type[HIZ_BIT] &&
+				! theConnections.simDrainPower_p->IsRelatedPower(theConnections.simSourcePower_p, netVoltagePtr_v, simNet_v, simNet_v, false) ) {
+			;  // possible leaks to cutoff power
+		} else if ( theConnections.simSourcePower_p->IsInternalOverride() || theConnections.simDrainPower_p->IsInternalOverride() ) {
+			return 0;
+		} else if ( theConnections.simSourcePower_p->type[SIM_CALCULATED_BIT] || theConnections.simDrainPower_p->type[SIM_CALCULATED_BIT] ) {
+			if ( theConnections.EstimatedCurrent() <= cvcParameters.cvcLeakLimit ) return 0;
+		}
+		myErrorFlag = true;
+	} else if ( theConnections.EstimatedMinimumCurrent() > cvcParameters.cvcLeakLimit ) {
+		myErrorFlag = true;
+	}
+	return ( myErrorFlag ) ? CHECK_ERROR : 0;
 }
 
 void CCvcDb::FindPmosPossibleLeakErrors() {
 	CFullConnection myConnections;
 	reportFile << "! Checking pmos possible leak errors: " << endl << endl;
 	errorFile << "! Checking pmos possible leak errors: " << endl << endl;
-	for ( deviceId_t device_it = 0; device_it < deviceCount; device_it++ ) {
-		CInstance * myInstance_p = instancePtr_v[deviceParent_v[device_it]];
-		CCircuit * myParent_p = myInstance_p->master_p;
-		CDevice * myDevice_p = myParent_p->devicePtr_v[device_it - myInstance_p->firstDeviceId];
-		if ( ! IsPmos_(myDevice_p->model_p->type) ) continue;
-		bool myErrorFlag = false;
-		MapDeviceNets(myInstance_p, myDevice_p, myConnections);
-		if ( IsKnownVoltage_(myConnections.simGateVoltage) ) continue;
-		if ( myConnections.CheckTerminalMaxVoltages(SOURCE | DRAIN) == true ) {
-			voltage_t myMinGateVoltage = MinVoltage(myConnections.gateId);
-			if ( myMinGateVoltage == UNKNOWN_VOLTAGE ) {
-				myMinGateVoltage = MinLeakVoltage(myConnections.gateId);
-			}
-			if ( myMinGateVoltage != UNKNOWN_VOLTAGE
-					&& myMinGateVoltage >= myConnections.maxSourceVoltage + myConnections.device_p->model_p->Vth
-					&& myMinGateVoltage >= myConnections.maxDrainVoltage + myConnections.device_p->model_p->Vth ) {
-				continue;  // always off
-			}
+	for ( auto error_pit = deviceError_v.begin(); error_pit != deviceError_v.end(); error_pit++ ) {
+		if ( error_pit->errorIndex != PMOS_POSSIBLE_LEAK ) continue;
+		if ( IncrementDeviceError(error_pit->deviceId, PMOS_POSSIBLE_LEAK) < cvcParameters.cvcCircuitErrorLimit || cvcParameters.cvcCircuitErrorLimit == 0 ) {
+			MapDeviceNets(error_pit->deviceId, myConnections);
+			RecordError(PMOS_POSSIBLE_LEAK, deviceParent_v[error_pit->deviceId], myConnections);
+			PrintDeviceWithAllConnections(deviceParent_v[error_pit->deviceId], myConnections, errorFile);
+			errorFile << endl;
 		}
-		if ( myConnections.CheckTerminalSimVoltages(SOURCE | DRAIN) == true ) {
-			if ( myConnections.simSourceVoltage == myConnections.simDrainVoltage ) continue;
-			if ( abs(myConnections.simSourceVoltage - myConnections.simDrainVoltage) <= cvcParameters.cvcLeakErrorThreshold ) continue;
-			if ( myConnections.simSourcePower_p->type[HIZ_BIT] &&
-					! myConnections.simSourcePower_p->IsRelatedPower(myConnections.simDrainPower_p, netVoltagePtr_v, simNet_v, simNet_v, false) ) {
-				;  // possible leaks to cutoff power
-			} else if ( myConnections.simDrainPower_p->type[HIZ_BIT] &&
-					! myConnections.simDrainPower_p->IsRelatedPower(myConnections.simSourcePower_p, netVoltagePtr_v, simNet_v, simNet_v, false) ) {
-				;  // possible leaks to cutoff power
-			} else if ( myConnections.simSourcePower_p->IsInternalOverride() || myConnections.simDrainPower_p->IsInternalOverride() ) {
-				continue;
-			} else if ( myConnections.simSourcePower_p->type[SIM_CALCULATED_BIT] || myConnections.simDrainPower_p->type[SIM_CALCULATED_BIT] ) {
-				if ( myConnections.EstimatedCurrent() <= cvcParameters.cvcLeakLimit ) continue;
-			}
-			myErrorFlag = true;
-		} else if ( myConnections.EstimatedMinimumCurrent() > cvcParameters.cvcLeakLimit ) {
-			myErrorFlag = true;
+	}
+	cvcCircuitList.PrintAndResetCircuitErrors(this, cvcParameters.cvcCircuitErrorLimit, logFile, errorFile, "! Checking pmos possible leak errors: ");
+}
+
+int CCvcDb::CheckPmosPossibleLeak(CFullConnection & theConnections) {
+	bool myErrorFlag = false;
+	if ( IsKnownVoltage_(theConnections.simGateVoltage) ) return 0;
+	if ( theConnections.CheckTerminalMaxVoltages(SOURCE | DRAIN) == true ) {
+		voltage_t myMinGateVoltage = theConnections.minGateVoltage;  // same as MinVoltage(gateId)
+		if ( myMinGateVoltage == UNKNOWN_VOLTAGE ) {
+			myMinGateVoltage = MinLeakVoltage(theConnections.gateId);
 		}
-		if ( myErrorFlag ) {
-			if ( IncrementDeviceError(myConnections.deviceId, PMOS_POSSIBLE_LEAK) < cvcParameters.cvcCircuitErrorLimit || cvcParameters.cvcCircuitErrorLimit == 0 ) {
-				PrintDeviceWithAllConnections(deviceParent_v[device_it], myConnections, errorFile);
-				errorFile << endl;
-			}
+		if ( myMinGateVoltage != UNKNOWN_VOLTAGE
+				&& myMinGateVoltage >= theConnections.maxSourceVoltage + theConnections.device_p->model_p->Vth
+				&& myMinGateVoltage >= theConnections.maxDrainVoltage + theConnections.device_p->model_p->Vth ) {
+			return 0;  // always off
 		}
 	}
-	cvcCircuitList.PrintAndResetCircuitErrors(this, cvcParameters.cvcCircuitErrorLimit, logFile, errorFile, "! Checking pmos possible leak errors: ");
+	if ( theConnections.CheckTerminalSimVoltages(SOURCE | DRAIN) == true ) {
+		if ( theConnections.simSourceVoltage == theConnections.simDrainVoltage ) return 0;
+		if ( abs(theConnections.simSourceVoltage - theConnections.simDrainVoltage) <= cvcParameters.cvcLeakErrorThreshold ) return 0;
+		if ( theConnections.simSourcePower_p->type[HIZ_BIT] &&
+				! theConnections.simSourcePower_p->IsRelatedPower(theConnections.simDrainPower_p, netVoltagePtr_v, simNet_v, simNet_v, false) ) {
+			;  // possible leaks to cutoff power
+		} else if ( theConnections.simDrainPower_p->type[HIZ_BIT] &&
+				! theConnections.simDrainPower_p->IsRelatedPower(theConnections.simSourcePower_p, netVoltagePtr_v, simNet_v, simNet_v, false) ) {
+			;  // possible leaks to cutoff power
+		} else if ( theConnections.simSourcePower_p->IsInternalOverride() || theConnections.simDrainPower_p->IsInternalOverride() ) {
+			return 0;
+		} else if ( theConnections.simSourcePower_p->type[SIM_CALCULATED_BIT] || theConnections.simDrainPower_p->type[SIM_CALCULATED_BIT] ) {
+			if ( theConnections.EstimatedCurrent() <= cvcParameters.cvcLeakLimit ) return 0;
+		}
+		myErrorFlag = true;
+	} else if ( theConnections.EstimatedMinimumCurrent() > cvcParameters.cvcLeakLimit ) {
+		myErrorFlag = true;
+	}
+	return ( myErrorFlag ) ? CHECK_ERROR : 0;
 }
 
 void CCvcDb::FindFloatingInputErrors() {
@@ -1008,12 +1154,13 @@ void CCvcDb::FindFloatingInputErrors() {
 	bool myFloatingFlag;
 	for (netId_t net_it = 0; net_it < netCount; net_it++) {
 		if ( connectionCount_v[net_it].gateCount > 0 ) { // skips subordinate nets. only equivalent master nets have counts
-			if ( firstGate_v[net_it] == UNKNOWN_DEVICE ) continue;
-			MapDeviceNets(firstGate_v[net_it], myConnections);
+			if ( gateAdjacency.Count(net_it) == 0 ) continue;
+			MapDeviceNets(gateAdjacency.First(net_it), myConnections);
 			if ( myConnections.simGateVoltage != UNKNOWN_VOLTAGE ) continue;  // skip known voltages
 			myFloatingFlag = IsFloatingGate(myConnections);
 			if ( myFloatingFlag || myConnections.IsPossibleHiZ(this) ) {
-				for ( deviceId_t device_it = firstGate_v[net_it]; device_it != UNKNOWN_DEVICE; device_it = nextGate_v[device_it] ) {
+				for ( auto device_pit = gateAdjacency.begin(net_it); device_pit != gateAdjacency.end(net_it); device_pit++ ) {
+					deviceId_t device_it = *device_pit;
 					MapDeviceNets(device_it, myConnections);
 					bool myHasLeakPath = HasLeakPath(myConnections);
 					if ( myFloatingFlag ) {
@@ -1028,6 +1175,7 @@ void CCvcDb::FindFloatingInputErrors() {
 						if ( IncrementDeviceError(myConnections.deviceId, HIZ_INPUT) < cvcParameters.cvcCircuitErrorLimit || cvcParameters.cvcCircuitErrorLimit == 0 ) {
 							if ( ! myHasLeakPath ) errorFile << "* No leak path" << endl;
 							if ( ! myFloatingFlag ) errorFile << "* Tri-state input" << endl;
+							RecordError(HIZ_INPUT, deviceParent_v[device_it], myConnections);
 							PrintDeviceWithAllConnections(deviceParent_v[device_it], myConnections, errorFile);
 							errorFile << endl;
 						}
@@ -1038,18 +1186,20 @@ void CCvcDb::FindFloatingInputErrors() {
 	}
 	for (netId_t net_it = 0; net_it < netCount; net_it++) {  // second pass to catch floating nets caused by floating nets
 		if ( connectionCount_v[net_it].gateCount > 0 ) { // skips subordinate nets. only equivalent master nets have counts
-			if ( firstGate_v[net_it] == UNKNOWN_DEVICE ) continue;
+			if ( gateAdjacency.Count(net_it) == 0 ) continue;
 			if ( SimVoltage(net_it) != UNKNOWN_VOLTAGE || (netVoltagePtr_v[net_it].full && netVoltagePtr_v[net_it].full->type[INPUT_BIT]) ) continue;
 			if ( HasActiveConnections(net_it) ) continue;
-			MapDeviceNets(firstGate_v[net_it], myConnections);
+			MapDeviceNets(gateAdjacency.First(net_it), myConnections);
 			if ( IsFloatingGate(myConnections) ) continue;  // Already processed previously
-			for ( deviceId_t device_it = firstGate_v[net_it]; device_it != UNKNOWN_DEVICE; device_it = nextGate_v[device_it] ) {
+			for ( auto device_pit = gateAdjacency.begin(net_it); device_pit != gateAdjacency.end(net_it); device_pit++ ) {
+				deviceId_t device_it = *device_pit;
 				MapDeviceNets(device_it, myConnections);
 				if ( myConnections.HasParallelShort(this) ) continue;  // skip devices that have source/drain shorted
 				bool myHasLeakPath = HasLeakPath(myConnections);
 				if ( myHasLeakPath ) {
 					if ( IncrementDeviceError(myConnections.deviceId, HIZ_INPUT) < cvcParameters.cvcCircuitErrorLimit || cvcParameters.cvcCircuitErrorLimit == 0 ) {
 						errorFile << "* Secondary HI-Z error" << endl;
+						RecordError(HIZ_INPUT, deviceParent_v[device_it], myConnections);
 						PrintDeviceWithAllConnections(deviceParent_v[device_it], myConnections, errorFile);
 						errorFile << endl;
 					}
@@ -1215,6 +1365,7 @@ void CCvcDb::FindLDDErrors() {
 								if ( !( IsKnownVoltage_(myConnections.simGateVoltage) &&
 										myConnections.simGateVoltage <= min(myConnections.minSourceVoltage, myConnections.minDrainVoltage) ) ) {
 									if ( IncrementDeviceError(myConnections.deviceId, LDD_SOURCE) < cvcParameters.cvcCircuitErrorLimit || cvcParameters.cvcCircuitErrorLimit == 0 ) {
+										RecordError(LDD_SOURCE, myParent_p->instanceId_v[instance_it], myConnections);
 										PrintDeviceWithAllConnections(myParent_p->instanceId_v[instance_it], myConnections, errorFile);
 										errorFile << endl;
 									}
@@ -1236,6 +1387,7 @@ void CCvcDb::FindLDDErrors() {
 								if ( !( IsKnownVoltage_(myConnections.simGateVoltage) &&
 										myConnections.simGateVoltage >= max(myConnections.maxSourceVoltage, myConnections.maxDrainVoltage) ) ) {
 									if ( IncrementDeviceError(myConnections.deviceId, LDD_SOURCE) < cvcParameters.cvcCircuitErrorLimit || cvcParameters.cvcCircuitErrorLimit == 0 ) {
+										RecordError(LDD_SOURCE, myParent_p->instanceId_v[instance_it], myConnections);
 										PrintDeviceWithAllConnections(myParent_p->instanceId_v[instance_it], myConnections, errorFile);
 										errorFile << endl;
 									}
@@ -1291,6 +1443,7 @@ void CCvcDb::CheckInverterIO(modelType_t theType) {
 					CFullConnection myFullConnections;
 					MapDeviceNets(myDevice, myFullConnections);
 					errorFile << "* inverter input/output mismatch" << endl;
+					RecordError((theType == NMOS ? NMOS_GATE_SOURCE : PMOS_GATE_SOURCE), deviceParent_v[myDevice], myFullConnections);
 					PrintDeviceWithAllConnections(deviceParent_v[myDevice], myFullConnections, errorFile);
 					errorFile << endl;
 				}
@@ -1342,7 +1495,8 @@ void CCvcDb::CheckOppositeLogic(modelType_t theType) {
 
 			netId_t myErrorNet = (myFirstPower_p && IsPower_(myFirstPower_p)) ? GetEquivalentNet(*opposite_pit) : GetEquivalentNet(*net_pit);
 			int myErrorCount = 0;
-			for ( auto device_it = firstGate_v[myErrorNet]; device_it != UNKNOWN_DEVICE; device_it = nextGate_v[device_it]) {
+			for ( auto device_pit = gateAdjacency.begin(myErrorNet); device_pit != gateAdjacency.end(myErrorNet); device_pit++ ) {
+				deviceId_t device_it = *device_pit;
 				if ( sourceNet_v[device_it] == drainNet_v[device_it] ) continue;  // ignore inactive devices
 
 				if ( theType == PMOS && ! IsPmos_(deviceType_v[device_it]) ) continue;  // ignore wrong types
@@ -1354,6 +1508,7 @@ void CCvcDb::CheckOppositeLogic(modelType_t theType) {
 					CFullConnection myFullConnections;
 					MapDeviceNets(device_it, myFullConnections);
 					errorFile << "* opposite logic required " << get<0>(*check_pit) << " & " << get<1>(*check_pit) << endl;
+					RecordError(HIZ_INPUT, deviceParent_v[device_it], myFullConnections);
 					PrintDeviceWithAllConnections(deviceParent_v[device_it], myFullConnections, errorFile);
 					errorFile << endl;
 				}
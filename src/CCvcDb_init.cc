@@ -34,7 +34,8 @@
 #include <csignal>
 #include <sys/stat.h>
 #include <regex>
-#include "mmappable_vector.h"
+#include <atomic>
+#include <thread>
 
 extern CCvcDb * gCvcDb;
 extern int gContinueCount;
@@ -68,9 +69,6 @@ CCvcDb::CCvcDb(int argc, const char * argv[]) :
 		minNet_v(MIN_CALCULATED_BIT),
 		simNet_v(SIM_CALCULATED_BIT),
 		maxNet_v(MAX_CALCULATED_BIT),
-//		initialSimNet_v(mmap_allocator<CVirtualNet>("", READ_WRITE_SHARED, 0, MAP_WHOLE_FILE | ALLOW_REMAP | BYPASS_FILE_POOL)),
-//		maxLeakNet_v(mmap_allocator<CVirtualNet>("", READ_WRITE_SHARED, 0, MAP_WHOLE_FILE | ALLOW_REMAP | BYPASS_FILE_POOL)),
-//		minLeakNet_v(mmap_allocator<CVirtualNet>("", READ_WRITE_SHARED, 0, MAP_WHOLE_FILE | ALLOW_REMAP | BYPASS_FILE_POOL)),
 		maxEventQueue(MAX_QUEUE, MAX_INACTIVE, MAX_PENDING, maxNet_v, netVoltagePtr_v),
 		minEventQueue(MIN_QUEUE, MIN_INACTIVE, MIN_PENDING, minNet_v, netVoltagePtr_v),
 		simEventQueue(SIM_QUEUE, SIM_INACTIVE, SIM_PENDING, simNet_v, netVoltagePtr_v),
@@ -91,6 +89,17 @@ CCvcDb::CCvcDb(int argc, const char * argv[]) :
 		} else if ( strcmp(argv[cvcArgIndex], "-s") == 0 || strcmp(argv[cvcArgIndex], "--setup") == 0 ) {
 			cout << "CVC: Creating setup files " << endl;
 			gSetup_cvc = true;
+		} else if ( strcmp(argv[cvcArgIndex], "--checkpoint") == 0 || strcmp(argv[cvcArgIndex], "--resume-from") == 0 ) {
+			string myOption = argv[cvcArgIndex++];
+			string myStage = ( cvcArgIndex < argc ) ? argv[cvcArgIndex] : "";
+			if ( myStage.length() != 1 || myStage[0] < '0' + STAGE_LINK || myStage[0] > '0' + STAGE_SECOND_SIM ) {
+				throw EFatalError("invalid stage '" + myStage + "' for " + myOption + ". expected " + to_string(STAGE_LINK) + "-" + to_string(STAGE_SECOND_SIM));
+			}
+			if ( myOption == "--checkpoint" ) {
+				checkpointStage = myStage[0] - '0';
+			} else {
+				resumeStage = myStage[0] - '0';
+			}
 		} else {
 			cout << "WARNING: unrecognized option " << argv[cvcArgIndex] << endl;
 		}
@@ -126,6 +135,17 @@ void CCvcDb::CountObjectsAndLinkSubcircuits() {
 	if ( topCircuit_p->netCount > MAX_NET || topCircuit_p->subcircuitCount > MAX_SUBCIRCUIT || topCircuit_p->deviceCount > MAX_DEVICE ) {
 		throw EFatalError("data size exceeds 4G items");
 	}
+	// ids for cell error count keys
+	instanceId_t myCircuitId = 0;
+	size_t myCircuitDeviceCount = 0;
+	for ( auto circuit_ppit = cvcCircuitList.begin(); circuit_ppit != cvcCircuitList.end(); circuit_ppit++ ) {
+		(*circuit_ppit)->circuitId = myCircuitId++;
+		(*circuit_ppit)->firstCircuitDeviceId = myCircuitDeviceCount;
+		myCircuitDeviceCount += (*circuit_ppit)->devicePtr_v.size();
+	}
+	if ( myCircuitId >= (instanceId_t(1) << 29) || myCircuitDeviceCount > MAX_DEVICE ) {
+		throw EFatalError("data size exceeds 4G items");
+	}
 }
 
 void CCvcDb::AssignGlobalIDs() {
@@ -138,10 +158,11 @@ void CCvcDb::AssignGlobalIDs() {
 	deviceParent_v.clear();
 	deviceParent_v.reserve(topCircuit_p->deviceCount);
 
-	instancePtr_v.clear();
-	instancePtr_v.reserve(topCircuit_p->subcircuitCount);
-	instancePtr_v.resize(topCircuit_p->subcircuitCount, NULL);
-	instancePtr_v[0] = new CInstance;
+	size_t myNetIdCount = 0;  // upper limit of local to global net map entries, including parallel instances
+	for ( auto circuit_ppit = cvcCircuitList.begin(); circuit_ppit != cvcCircuitList.end(); circuit_ppit++ ) {
+		myNetIdCount += size_t((*circuit_ppit)->instanceCount) * (*circuit_ppit)->localSignalIdMap.size();
+	}
+	instancePtr_v.Reset(topCircuit_p->subcircuitCount, myNetIdCount);
 	instancePtr_v[0]->AssignTopGlobalIDs(this, topCircuit_p);
 }
 
@@ -206,20 +227,20 @@ netId_t CCvcDb::MasterPowerNet(netId_t theFirstNetId, netId_t theSecondNetId) {
 	throw EEquivalenceError();
 }
 
-// merges 2 equivalency lists
-void CCvcDb::MakeEquivalentNets(CNetMap & theNetMap, netId_t theFirstNetId, netId_t theSecondNetId, deviceId_t theDeviceId) {
+// merges 2 equivalence classes. power is resolved once at the new root.
+void CCvcDb::MakeEquivalentNets(netId_t theFirstNetId, netId_t theSecondNetId, deviceId_t theDeviceId) {
 	netId_t myLesserNetId, myGreaterNetId;
 
-	theFirstNetId = GetLeastEquivalentNet(theFirstNetId);
-	theSecondNetId = GetLeastEquivalentNet(theSecondNetId);
-	if ( theFirstNetId > theSecondNetId ) {
+	theFirstNetId = FindEquivalentRoot(theFirstNetId);
+	theSecondNetId = FindEquivalentRoot(theSecondNetId);
+	if ( theFirstNetId == theSecondNetId ) return; // already equivalent
+	// lesser/greater by least net in class
+	if ( leastEquivalentNet_v[theFirstNetId] > leastEquivalentNet_v[theSecondNetId] ) {
 		myGreaterNetId = theFirstNetId;
 		myLesserNetId = theSecondNetId;
-	} else if ( theFirstNetId < theSecondNetId ) {
+	} else {
 		myLesserNetId = theFirstNetId;
 		myGreaterNetId = theSecondNetId;
-	} else {
-		return; // already equivalent
 	}
 	bool mySamePowerFlag;
 	CPower * myMasterPower_p = SetMasterPower(theFirstNetId, theSecondNetId, mySamePowerFlag);
@@ -235,27 +256,116 @@ void CCvcDb::MakeEquivalentNets(CNetMap & theNetMap, netId_t theFirstNetId, netI
 			return;
 		}
 	}
+	// union by rank
+	netId_t myRootNetId = myLesserNetId;
+	netId_t myChildNetId = myGreaterNetId;
+	if ( equivalentNetRank_v[myGreaterNetId] > equivalentNetRank_v[myLesserNetId] ) {
+		myRootNetId = myGreaterNetId;
+		myChildNetId = myLesserNetId;
+	} else if ( equivalentNetRank_v[myGreaterNetId] == equivalentNetRank_v[myLesserNetId] ) {
+		equivalentNetRank_v[myLesserNetId]++;
+	}
+	equivalentNet_v[myChildNetId] = myRootNetId;
+	leastEquivalentNet_v[myRootNetId] = leastEquivalentNet_v[myLesserNetId];
 	if ( myMasterPower_p ) {
-		netVoltagePtr_v[myMinorNetId].full = myMasterPower_p;
-		for ( auto net_pit = theNetMap[myMinorNetId].begin(); net_pit != theNetMap[myMinorNetId].end(); net_pit++ ) {
-			netVoltagePtr_v[*net_pit].full = myMasterPower_p;
+		netVoltagePtr_v[myRootNetId].full = myMasterPower_p;
+	}
+}
+
+static netId_t FindComponent(vector<atomic<netId_t>> & theComponent_v, netId_t theNetId) {
+	// lock free find with path halving. parents are never greater than children.
+	netId_t myParent = theComponent_v[theNetId].load();
+	while ( myParent != theNetId ) {
+		netId_t myGrandparent = theComponent_v[myParent].load();
+		if ( myGrandparent != myParent ) {
+			theComponent_v[theNetId].compare_exchange_weak(myParent, myGrandparent);
 		}
+		theNetId = myGrandparent;
+		myParent = theComponent_v[theNetId].load();
 	}
-	theNetMap[myLesserNetId].push_front(myGreaterNetId);
-	if ( theNetMap.count(myGreaterNetId) > 0 ) {
-		theNetMap[myLesserNetId].splice_after(theNetMap[myLesserNetId].before_begin(), theNetMap[myGreaterNetId]);
+	return theNetId;
+}
+
+static void UnionComponents(vector<atomic<netId_t>> & theComponent_v, netId_t theFirstNetId, netId_t theSecondNetId) {
+	// link the greater root to the lesser root, so the final root is the least net in each component
+	while ( true ) {
+		theFirstNetId = FindComponent(theComponent_v, theFirstNetId);
+		theSecondNetId = FindComponent(theComponent_v, theSecondNetId);
+		if ( theFirstNetId == theSecondNetId ) return;
+		if ( theFirstNetId < theSecondNetId ) swap(theFirstNetId, theSecondNetId);
+		netId_t myExpectedNetId = theFirstNetId;
+		if ( theComponent_v[theFirstNetId].compare_exchange_strong(myExpectedNetId, theSecondNetId) ) return;
+	}
+}
+
+void CCvcDb::UnionSwitchNets(vector<CDevice *> & theSwitch_v, vector<atomic<netId_t>> & theComponent_v) {
+	// Connected components of all switch devices, ignoring power. Unions are concurrent over switch masters.
+	for ( netId_t net_it = 0; net_it < netCount; net_it++ ) {
+		theComponent_v[net_it].store(net_it);
+	}
+	atomic<size_t> myNextSwitch(0);
+	auto myUnionSwitches = [&] () {
+		size_t mySwitch;
+		while ( (mySwitch = myNextSwitch.fetch_add(1)) < theSwitch_v.size() ) {
+			CDevice * myDevice_p = theSwitch_v[mySwitch];
+			CCircuit * myParent_p = myDevice_p->parent_p;
+			for (instanceId_t instance_it = 0; instance_it < myParent_p->instanceId_v.size(); instance_it++) {
+				CInstance * myInstance_p = instancePtr_v[myParent_p->instanceId_v[instance_it]];
+				if ( myInstance_p->IsParallelInstance() ) continue;  // parallel instances
+				UnionComponents(theComponent_v, myInstance_p->localToGlobalNetId_v[myDevice_p->signalId_v[0]],
+						myInstance_p->localToGlobalNetId_v[myDevice_p->signalId_v[1]]);
+			}
+		}
+	};
+	size_t myThreadCount = min(cvcParameters.cvcThreadCount, theSwitch_v.size());
+	vector<thread> myThread_v;
+	for ( size_t thread_it = 1; thread_it < myThreadCount; thread_it++ ) {
+		myThread_v.push_back(thread(myUnionSwitches));
+	}
+	myUnionSwitches();
+	for ( auto thread_pit = myThread_v.begin(); thread_pit != myThread_v.end(); thread_pit++ ) {
+		thread_pit->join();
 	}
-	equivalentNet_v[myGreaterNetId] = myLesserNetId;
 }
 
 void CCvcDb::SetEquivalentNets() {
 	reportFile << "CVC: Shorting switches..." << endl;
 	isFixedEquivalentNet = false;
 	ResetVector<CNetIdVector>(equivalentNet_v, netCount);
+	ResetVector<CNetIdVector>(leastEquivalentNet_v, netCount);
+	ResetVector<vector<unsigned char>>(equivalentNetRank_v, netCount, 0);
+	vector<CDevice *> mySwitch_v;
+	for (CModelListMap::iterator keyModelListPair_pit = cvcParameters.cvcModelListMap.begin(); keyModelListPair_pit != cvcParameters.cvcModelListMap.end(); keyModelListPair_pit++) {
+		for (CModelList::iterator model_pit = keyModelListPair_pit->second.begin(); model_pit != keyModelListPair_pit->second.end(); model_pit++) {
+			if ( model_pit->type != SWITCH_ON ) continue;
+			for ( CDevice * myDevice_p = model_pit->firstDevice_p; myDevice_p; myDevice_p = myDevice_p->nextDevice_p ) {
+				mySwitch_v.push_back(myDevice_p);
+			}
+		}
+	}
+	vector<atomic<netId_t>> myComponent_v(netCount);
+	UnionSwitchNets(mySwitch_v, myComponent_v);
+	// Components with at most one power net short without conflicts, so they are set directly.
+	// Others are shorted in netlist order to keep power conflict resolution and error order.
+	vector<unsigned char> myComponentPowerCount_v(netCount, 0);
 	for (netId_t net_it = 0; net_it < netCount; net_it++) {
-		equivalentNet_v[net_it] = net_it;
+		if ( netVoltagePtr_v[net_it].full ) {
+			netId_t myComponentNetId = FindComponent(myComponent_v, net_it);
+			if ( myComponentPowerCount_v[myComponentNetId] < 2 ) myComponentPowerCount_v[myComponentNetId]++;
+		}
+	}
+	for (netId_t net_it = 0; net_it < netCount; net_it++) {
+		netId_t myComponentNetId = FindComponent(myComponent_v, net_it);
+		leastEquivalentNet_v[net_it] = net_it;
+		if ( myComponentPowerCount_v[myComponentNetId] < 2 ) {
+			equivalentNet_v[net_it] = myComponentNetId;
+			if ( netVoltagePtr_v[net_it].full && net_it != myComponentNetId ) {
+				netVoltagePtr_v[myComponentNetId].full = netVoltagePtr_v[net_it].full;
+			}
+		} else {
+			equivalentNet_v[net_it] = net_it;
+		}
 	}
-	CNetMap myEquivalentNetMap;
 	for (CModelListMap::iterator keyModelListPair_pit = cvcParameters.cvcModelListMap.begin(); keyModelListPair_pit != cvcParameters.cvcModelListMap.end(); keyModelListPair_pit++) {
 		for (CModelList::iterator model_pit = keyModelListPair_pit->second.begin(); model_pit != keyModelListPair_pit->second.end(); model_pit++) {
 			if ( model_pit->type == SWITCH_ON ) {
@@ -274,12 +384,12 @@ void CCvcDb::SetEquivalentNets() {
 						}
 						CInstance * myInstance_p = instancePtr_v[myParent_p->instanceId_v[instance_it]];
 						deviceId_t myDeviceId = myInstance_p->firstDeviceId + myLocalDeviceId;
+						netId_t mySourceNetId = myInstance_p->localToGlobalNetId_v[myDevice_p->signalId_v[0]];
 						try {
 							// short source and drain
-							MakeEquivalentNets(myEquivalentNetMap,
-									myInstance_p->localToGlobalNetId_v[myDevice_p->signalId_v[0]],
-									myInstance_p->localToGlobalNetId_v[myDevice_p->signalId_v[1]],
-									myDeviceId);
+							if ( myComponentPowerCount_v[FindComponent(myComponent_v, mySourceNetId)] >= 2 ) {
+								MakeEquivalentNets(mySourceNetId, myInstance_p->localToGlobalNetId_v[myDevice_p->signalId_v[1]], myDeviceId);
+							}
 						}
 						catch (const EEquivalenceError& myException) {
 							CFullConnection myConnections;
@@ -298,6 +408,7 @@ void CCvcDb::SetEquivalentNets() {
 								if ( myConnections.simSourceVoltage == myConnections.simDrainVoltage ) {
 									errorFile << "Unrelated power error" << endl;
 								}
+								RecordError(LEAK, myParent_p->instanceId_v[instance_it], myConnections);
 								PrintDeviceWithSimConnections(myParent_p->instanceId_v[instance_it], myConnections, errorFile);
 								errorFile << endl;
 							}
@@ -313,12 +424,30 @@ void CCvcDb::SetEquivalentNets() {
 		}
 	}
 	cvcCircuitList.PrintAndResetCircuitErrors(this, cvcParameters.cvcCircuitErrorLimit, logFile, errorFile, "! Switch shorts");
-	// following iterator must be int! netId_t results in infinite loop
-	for (int net_it = equivalentNet_v.size() - 1; net_it >= 0; net_it--) {
-		equivalentNet_v[net_it] = GetEquivalentNet(net_it);
-		if ( netVoltagePtr_v[net_it].full && netId_t(net_it) != netVoltagePtr_v[net_it].full->netId ) netVoltagePtr_v[net_it].full = NULL;
+	FixEquivalentNets();
+}
+
+void CCvcDb::FixEquivalentNets() {
+	// Replace union-find parents with the final equivalent net. Power is only kept on the power net itself.
+	for (netId_t net_it = 0; net_it < netCount; net_it++) {
+		equivalentNet_v[net_it] = FindEquivalentRoot(net_it);
 	}
-	myEquivalentNetMap.clear();
+	for (netId_t net_it = 0; net_it < netCount; net_it++) {
+		if ( equivalentNet_v[net_it] != net_it ) continue;
+		CPower * myPower_p = netVoltagePtr_v[net_it].full;
+		if ( myPower_p && myPower_p->netId != UNKNOWN_NET ) {
+			leastEquivalentNet_v[net_it] = myPower_p->netId;
+		}
+	}
+	for (netId_t net_it = 0; net_it < netCount; net_it++) {
+		equivalentNet_v[net_it] = leastEquivalentNet_v[equivalentNet_v[net_it]];
+	}
+	for (netId_t net_it = 0; net_it < netCount; net_it++) {
+		if ( netVoltagePtr_v[net_it].full
+				&& ( equivalentNet_v[net_it] != net_it || net_it != netVoltagePtr_v[net_it].full->netId ) ) netVoltagePtr_v[net_it].full = NULL;
+	}
+	CNetIdVector().swap(leastEquivalentNet_v);
+	vector<unsigned char>().swap(equivalentNetRank_v);
 	isFixedEquivalentNet = true;
 }
 
@@ -415,6 +544,7 @@ void CCvcDb::LinkDevices() {
 		}
 	}
 	cout << endl;
+	BuildConnectionAdjacency(false);
 }
 
 returnCode_t CCvcDb::SetDeviceModels() {
@@ -559,16 +689,28 @@ void CCvcDb::MergeConnectionListByTerminals(netId_t theFromNet, netId_t theToNet
 	theFirstDevice_v[theFromNet] = UNKNOWN_DEVICE;
 }
 
-void CCvcDb::DumpConnectionList(string theHeading, CDeviceIdVector& theFirstDevice_v, CDeviceIdVector& theNextDevice_v) {
-	deviceId_t myDeviceId;
+void CCvcDb::BuildConnectionAdjacency(bool theReleaseLists) {
+	// Connection lists are only updated while linking and merging. Lookups use the compressed copies.
+	sourceAdjacency.Build(firstSource_v, nextSource_v, cvcParameters.cvcThreadCount);
+	gateAdjacency.Build(firstGate_v, nextGate_v, cvcParameters.cvcThreadCount);
+	drainAdjacency.Build(firstDrain_v, nextDrain_v, cvcParameters.cvcThreadCount);
+	if ( theReleaseLists ) {
+		CDeviceIdVector().swap(firstSource_v);
+		CDeviceIdVector().swap(firstGate_v);
+		CDeviceIdVector().swap(firstDrain_v);
+		CDeviceIdVector().swap(nextSource_v);
+		CDeviceIdVector().swap(nextGate_v);
+		CDeviceIdVector().swap(nextDrain_v);
+	}
+}
+
+void CCvcDb::DumpConnectionList(string theHeading, CDeviceIdAdjacency& theAdjacency) {
 	cout << theHeading << endl;
-	for ( netId_t net_it = 0; net_it < theFirstDevice_v.size(); net_it++) {
-		if ( theFirstDevice_v[net_it] == UNKNOWN_DEVICE ) continue;
+	for ( netId_t net_it = 0; net_it < theAdjacency.size(); net_it++) {
+		if ( theAdjacency.Count(net_it) == 0 ) continue;
 		cout << "  " << net_it << ":" << NetName(net_it) << " => ";
-		myDeviceId = theFirstDevice_v[net_it];
-		while ( myDeviceId != UNKNOWN_DEVICE ) {
-			cout << myDeviceId << ":" << DeviceName(myDeviceId) << " -> ";
-			myDeviceId = theNextDevice_v[myDeviceId];
+		for ( auto device_pit = theAdjacency.begin(net_it); device_pit != theAdjacency.end(net_it); device_pit++ ) {
+			cout << *device_pit << ":" << DeviceName(*device_pit) << " -> ";
 		}
 		cout << "end" << endl;
 	}
@@ -576,9 +718,9 @@ void CCvcDb::DumpConnectionList(string theHeading, CDeviceIdVector& theFirstDevi
 
 void CCvcDb::DumpConnectionLists(string theHeading) {
 	cout << "Connection list dump " << theHeading << endl;
-	DumpConnectionList(" Gate connections", firstGate_v, nextGate_v);
-	DumpConnectionList(" Source connections", firstSource_v, nextSource_v);
-	DumpConnectionList(" Drain connections", firstDrain_v, nextDrain_v);
+	DumpConnectionList(" Gate connections", gateAdjacency);
+	DumpConnectionList(" Source connections", sourceAdjacency);
+	DumpConnectionList(" Drain connections", drainAdjacency);
 //	DumpConnectionList(" Bulk connections", firstBulk_v, nextBulk_v);
 	cout << "Connection list dump end" << endl;
 }
@@ -655,6 +797,7 @@ void CCvcDb::ShortNonConductingResistors() {
 			}
 		}
 	}
+	BuildConnectionAdjacency(true);
 }
 
 void CCvcDb::SetResistorVoltagesForMosSwitches() {
@@ -664,7 +807,8 @@ void CCvcDb::SetResistorVoltagesForMosSwitches() {
 //		if ( ! myPower_p->type[EXPECTED_ONLY_BIT] ) {
 		netId_t myNetId = myPower_p->netId;
 		if ( ! myPower_p->type[POWER_BIT] ) continue;  // only process power
-		for (deviceId_t device_it = firstSource_v[myNetId]; device_it != UNKNOWN_DEVICE; device_it = nextSource_v[device_it]) {
+		for ( auto device_pit = sourceAdjacency.begin(myNetId); device_pit != sourceAdjacency.end(myNetId); device_pit++ ) {
+			deviceId_t device_it = *device_pit;
 			switch(deviceType_v[device_it]) {
 			case NMOS: case PMOS: case LDDN: case LDDP:
 				break;
@@ -1241,8 +1385,8 @@ void CCvcDb::SetSCRCPower() {
 		if ( (*power_ppit)->type[HIZ_BIT] ) {
 			// Check for power switches.
 			netId_t myNetId = (*power_ppit)->netId;
-			(void) SetSCRCGatePower(myNetId, firstDrain_v, nextDrain_v, sourceNet_v, mySCRCSignalCount, mySCRCIgnoreCount, true);
-			(void) SetSCRCGatePower(myNetId, firstSource_v, nextSource_v, drainNet_v, mySCRCSignalCount, mySCRCIgnoreCount, true);
+			(void) SetSCRCGatePower(myNetId, drainAdjacency, sourceNet_v, mySCRCSignalCount, mySCRCIgnoreCount, true);
+			(void) SetSCRCGatePower(myNetId, sourceAdjacency, drainNet_v, mySCRCSignalCount, mySCRCIgnoreCount, true);
 		}
 	}
 	reportFile << "Set " << mySCRCSignalCount << " power mos signals." << " Ignored " << mySCRCIgnoreCount << " signals." << endl;
@@ -1253,11 +1397,11 @@ void CCvcDb::SetSCRCPower() {
 	for ( size_t net_it = 0; net_it < netCount; net_it++ ) {
 		if ( IsSCRCLogicNet(net_it) ) {
 			size_t myAttemptCount = 0;
-			myAttemptCount += SetSCRCGatePower(net_it, firstDrain_v, nextDrain_v, sourceNet_v, mySCRCSignalCount, mySCRCIgnoreCount, false);
-			myAttemptCount += SetSCRCGatePower(net_it, firstSource_v, nextSource_v, drainNet_v, mySCRCSignalCount, mySCRCIgnoreCount, false);
+			myAttemptCount += SetSCRCGatePower(net_it, drainAdjacency, sourceNet_v, mySCRCSignalCount, mySCRCIgnoreCount, false);
+			myAttemptCount += SetSCRCGatePower(net_it, sourceAdjacency, drainNet_v, mySCRCSignalCount, mySCRCIgnoreCount, false);
 			if ( myAttemptCount == 0 ) {  // Could not set any gate nets, so set net directly
-				CPower * myFinalMinPower_p = netVoltagePtr_v[minNet_v[net_it].finalNetId].full;
-				CPower * myFinalMaxPower_p = netVoltagePtr_v[maxNet_v[net_it].finalNetId].full;
+				CPower * myFinalMinPower_p = netVoltagePtr_v[minNet_v.FinalNetId(net_it)].full;
+				CPower * myFinalMaxPower_p = netVoltagePtr_v[maxNet_v.FinalNetId(net_it)].full;
 				if ( IsSCRCPower(myFinalMinPower_p) && IsSCRCPower(myFinalMaxPower_p) ) continue;  // don't set double SCRC
 				voltage_t myExpectedVoltage = IsSCRCPower(myFinalMinPower_p) ? myFinalMaxPower_p->maxVoltage : myFinalMinPower_p->minVoltage;
 				if ( netVoltagePtr_v[net_it].full ) {
@@ -1279,11 +1423,12 @@ void CCvcDb::SetSCRCPower() {
 	reportFile << "Set " << mySCRCSignalCount << " inverter signals." << " Ignored " << mySCRCIgnoreCount << " signals." << endl;
 }
 
-size_t CCvcDb::SetSCRCGatePower(netId_t theNetId, CDeviceIdVector & theFirstSource_v, CDeviceIdVector & theNextSource_v, CNetIdVector & theDrain_v,
+size_t CCvcDb::SetSCRCGatePower(netId_t theNetId, CDeviceIdAdjacency & theSourceAdjacency, CNetIdVector & theDrain_v,
 		size_t & theSCRCSignalCount, size_t & theSCRCIgnoreCount, bool theNoCheckFlag) {
 	CPower * mySourcePower_p = netVoltagePtr_v[theNetId].full;
 	size_t myAttemptCount = 0;
-	for ( auto device_it = theFirstSource_v[theNetId]; device_it != UNKNOWN_DEVICE; device_it = theNextSource_v[device_it] ) {
+	for ( auto device_pit = theSourceAdjacency.begin(theNetId); device_pit != theSourceAdjacency.end(theNetId); device_pit++ ) {
+		deviceId_t device_it = *device_pit;
 		if ( ! IsMos_(deviceType_v[device_it]) ) continue;  // Only process mosfets.
 		CPower * myDrainPower_p = netVoltagePtr_v[theDrain_v[device_it]].full;
 		if ( ! myDrainPower_p ) continue;  // ignore non-power nets
@@ -1303,8 +1448,8 @@ void CCvcDb::SetSCRCParentPower(netId_t theNetId, deviceId_t theDeviceId, bool t
 		myParentNet = inverterNet_v[myParentNet];
 		theExpectedHighInput = ! theExpectedHighInput;
 	}
-	CPower * myHighPower_p = netVoltagePtr_v[maxNet_v[myParentNet].finalNetId].full;
-	CPower * myLowPower_p = netVoltagePtr_v[minNet_v[myParentNet].finalNetId].full;
+	CPower * myHighPower_p = netVoltagePtr_v[maxNet_v.FinalNetId(myParentNet)].full;
+	CPower * myLowPower_p = netVoltagePtr_v[minNet_v.FinalNetId(myParentNet)].full;
 	CPower * myExpectedPower_p = theExpectedHighInput ? myHighPower_p : myLowPower_p;
 	voltage_t myExpectedVoltage = UNKNOWN_VOLTAGE;
 	if ( myExpectedPower_p ) {
@@ -1344,8 +1489,8 @@ void CCvcDb::SetSCRCParentPower(netId_t theNetId, deviceId_t theDeviceId, bool t
 }
 
 bool CCvcDb::IsSCRCLogicNet(netId_t theNetId) {
-	CPower * myMinPower = netVoltagePtr_v[minNet_v[theNetId].finalNetId].full;
-	CPower * myMaxPower = netVoltagePtr_v[maxNet_v[theNetId].finalNetId].full;
+	CPower * myMinPower = netVoltagePtr_v[minNet_v.FinalNetId(theNetId)].full;
+	CPower * myMaxPower = netVoltagePtr_v[maxNet_v.FinalNetId(theNetId)].full;
 	if ( ! myMinPower || ! myMaxPower ) return false;
 	if ( myMinPower->type[HIZ_BIT] == myMaxPower->type[HIZ_BIT] ) return false;
 	if ( myMinPower->type[MIN_CALCULATED_BIT] || myMaxPower->type[MAX_CALCULATED_BIT] ) return false;
@@ -1376,19 +1521,19 @@ bool CCvcDb::SetLatchPower(int thePassCount, vector<bool> & theIgnoreNet_v, CNet
 			}
 		}
 		if ( theIgnoreNet_v[net_it]
-				|| simNet_v[net_it].finalNetId != net_it  // already assigned
+				|| simNet_v.FinalNetId(net_it) != net_it  // already assigned
 				|| ( netVoltagePtr_v[net_it].full && netVoltagePtr_v[net_it].full->simVoltage != UNKNOWN_VOLTAGE ) ) {  // already defined
 			theIgnoreNet_v[net_it] = true;
 			continue;
 		}
 		int myNmosCount = 0;
 		int myPmosCount = 0;
-		netId_t myMinNet = minNet_v[net_it].finalNetId;
+		netId_t myMinNet = minNet_v.FinalNetId(net_it);
 		voltage_t myMinVoltage = UNKNOWN_VOLTAGE;
 		if ( myMinNet != UNKNOWN_NET && netVoltagePtr_v[myMinNet].full && netVoltagePtr_v[myMinNet].full->type[POWER_BIT] ) {
 			myMinVoltage = netVoltagePtr_v[myMinNet].full->minVoltage;
 		}
-		netId_t myMaxNet = maxNet_v[net_it].finalNetId;
+		netId_t myMaxNet = maxNet_v.FinalNetId(net_it);
 		voltage_t myMaxVoltage = UNKNOWN_VOLTAGE;
 		if ( myMaxNet != UNKNOWN_NET && netVoltagePtr_v[myMaxNet].full && netVoltagePtr_v[myMaxNet].full->type[POWER_BIT] ) {
 			myMaxVoltage = netVoltagePtr_v[myMaxNet].full->maxVoltage;
@@ -1399,9 +1544,9 @@ bool CCvcDb::SetLatchPower(int thePassCount, vector<bool> & theIgnoreNet_v, CNet
 		mosData_t myNmosData_v[MAX_LATCH_DEVICE_COUNT];
 		mosData_t myPmosData_v[MAX_LATCH_DEVICE_COUNT];
 		FindLatchDevices(net_it, myNmosData_v, myPmosData_v, myNmosCount, myPmosCount, myMinVoltage, myMaxVoltage,
-			firstDrain_v, nextDrain_v, sourceNet_v);
+			drainAdjacency, sourceNet_v);
 		FindLatchDevices(net_it, myNmosData_v, myPmosData_v, myNmosCount, myPmosCount, myMinVoltage, myMaxVoltage,
-			firstSource_v, nextSource_v, drainNet_v);
+			sourceAdjacency, drainNet_v);
 		voltage_t myNmosVoltage = UNKNOWN_VOLTAGE;
 		voltage_t myPmosVoltage = UNKNOWN_VOLTAGE;
 		string myNmosPowerName;
@@ -1445,6 +1590,7 @@ bool CCvcDb::SetLatchPower(int thePassCount, vector<bool> & theIgnoreNet_v, CNet
 				CFullConnection myConnections;
 				MapDeviceNets(mySampleNmos, myConnections);
 				errorFile << "! Short Detected: " << PrintVoltage(myNmosVoltage) << " to " << PrintVoltage(myPmosVoltage) << " at n/pmux" << endl;
+				RecordError(LEAK, deviceParent_v[mySampleNmos], myConnections);
 				PrintDeviceWithAllConnections(deviceParent_v[mySampleNmos], myConnections, errorFile);
 				errorFile << endl;
 			}
@@ -1485,11 +1631,12 @@ bool CCvcDb::SetLatchPower(int thePassCount, vector<bool> & theIgnoreNet_v, CNet
 
 void CCvcDb::FindLatchDevices(netId_t theNetId, mosData_t theNmosData_v[], mosData_t thePmosData_v[], int & theNmosCount, int & thePmosCount,
 	voltage_t theMinVoltage, voltage_t theMaxVoltage,
-	CDeviceIdVector & theFirstDrain_v, CDeviceIdVector & theNextDrain_v, CNetIdVector & theSourceNet_v) {
-	for ( deviceId_t device_it = theFirstDrain_v[theNetId]; device_it != UNKNOWN_DEVICE; device_it = theNextDrain_v[device_it] ) {
+	CDeviceIdAdjacency & theDrainAdjacency, CNetIdVector & theSourceNet_v) {
+	for ( auto device_pit = theDrainAdjacency.begin(theNetId); device_pit != theDrainAdjacency.end(theNetId); device_pit++ ) {
+		deviceId_t device_it = *device_pit;
 		if ( theSourceNet_v[device_it] == gateNet_v[device_it] && netVoltagePtr_v[theSourceNet_v[device_it]].full ) continue; // skip ESD mos
-		netId_t mySource = simNet_v[theSourceNet_v[device_it]].finalNetId;
-		netId_t myGate = simNet_v[gateNet_v[device_it]].finalNetId;
+		netId_t mySource = simNet_v.FinalNetId(theSourceNet_v[device_it]);
+		netId_t myGate = simNet_v.FinalNetId(gateNet_v[device_it]);
 		voltage_t myGateVoltage = UNKNOWN_VOLTAGE;
 		CPower * myGatePower_p = netVoltagePtr_v[myGate].full;
 		if ( myGatePower_p && ! myGatePower_p->type[SIM_CALCULATED_BIT] ) {
@@ -1505,12 +1652,12 @@ void CCvcDb::FindLatchDevices(netId_t theNetId, mosData_t theNmosData_v[], mosDa
 				deviceId_t myNextDevice = GetSeriesConnectedDevice(device_it, mySource);
 				if ( myNextDevice != UNKNOWN_DEVICE ) {
 					// this section uses the instance sourceNet_v
-					if ( simNet_v[sourceNet_v[myNextDevice]].finalNetId == mySource ) {
-						theNmosData_v[theNmosCount].source = simNet_v[drainNet_v[myNextDevice]].finalNetId;
+					if ( simNet_v.FinalNetId(sourceNet_v[myNextDevice]) == mySource ) {
+						theNmosData_v[theNmosCount].source = simNet_v.FinalNetId(drainNet_v[myNextDevice]);
 					} else {
-						theNmosData_v[theNmosCount].source = simNet_v[sourceNet_v[myNextDevice]].finalNetId;
+						theNmosData_v[theNmosCount].source = simNet_v.FinalNetId(sourceNet_v[myNextDevice]);
 					}
-					theNmosData_v[theNmosCount].gate = simNet_v[gateNet_v[myNextDevice]].finalNetId;
+					theNmosData_v[theNmosCount].gate = simNet_v.FinalNetId(gateNet_v[myNextDevice]);
 					theNmosData_v[theNmosCount].id = myNextDevice;
 					theNmosCount++;
 				}
@@ -1526,12 +1673,12 @@ void CCvcDb::FindLatchDevices(netId_t theNetId, mosData_t theNmosData_v[], mosDa
 				deviceId_t myNextDevice = GetSeriesConnectedDevice(device_it, mySource);
 				if ( myNextDevice != UNKNOWN_DEVICE ) {
 					// this section uses the instance sourceNet_v
-					if ( simNet_v[sourceNet_v[myNextDevice]].finalNetId == mySource ) {
-						thePmosData_v[thePmosCount].source = simNet_v[drainNet_v[myNextDevice]].finalNetId;
+					if ( simNet_v.FinalNetId(sourceNet_v[myNextDevice]) == mySource ) {
+						thePmosData_v[thePmosCount].source = simNet_v.FinalNetId(drainNet_v[myNextDevice]);
 					} else {
-						thePmosData_v[thePmosCount].source = simNet_v[sourceNet_v[myNextDevice]].finalNetId;
+						thePmosData_v[thePmosCount].source = simNet_v.FinalNetId(sourceNet_v[myNextDevice]);
 					}
-					thePmosData_v[thePmosCount].gate = simNet_v[gateNet_v[myNextDevice]].finalNetId;
+					thePmosData_v[thePmosCount].gate = simNet_v.FinalNetId(gateNet_v[myNextDevice]);
 					thePmosData_v[thePmosCount].id = myNextDevice;
 					thePmosCount++;
 				}
@@ -1548,14 +1695,15 @@ void CCvcDb::PrintInputNetsWithMinMaxSuggestions(netId_t theNetId) {
 	bool mySearchingFlag = true;
 	CPower * myLowPower_p = NULL;
 	CPower * myHighPower_p = NULL;
-	for ( deviceId_t device_it = firstGate_v[theNetId]; device_it != UNKNOWN_DEVICE && mySearchingFlag; device_it = nextGate_v[device_it] ) {
+	for ( auto device_pit = gateAdjacency.begin(theNetId); device_pit != gateAdjacency.end(theNetId) && mySearchingFlag; device_pit++ ) {
+		deviceId_t device_it = *device_pit;
 		if ( IsNmos_(deviceType_v[device_it]) && ! myLowPower_p && sourceNet_v[device_it] != UNKNOWN_NET ) {
-			netId_t mySourceId = minNet_v[GetEquivalentNet(sourceNet_v[device_it])].finalNetId;
+			netId_t mySourceId = minNet_v.FinalNetId(GetEquivalentNet(sourceNet_v[device_it]));
 			if ( netVoltagePtr_v.powerPtrType_v[mySourceId] == FULL_POWER_PTR ) {
 				myLowPower_p = netVoltagePtr_v[mySourceId].full;
 			}
 		} else if ( IsPmos_(deviceType_v[device_it]) && ! myHighPower_p && drainNet_v[device_it] != UNKNOWN_NET ) {
-			netId_t mySourceId = maxNet_v[GetEquivalentNet(sourceNet_v[device_it])].finalNetId;
+			netId_t mySourceId = maxNet_v.FinalNetId(GetEquivalentNet(sourceNet_v[device_it]));
 			if ( netVoltagePtr_v.powerPtrType_v[mySourceId] == FULL_POWER_PTR ) {
 			myHighPower_p = netVoltagePtr_v[mySourceId].full;
 			}
@@ -1625,17 +1773,18 @@ void CCvcDb::PrintNetSuggestions() {
 		myUncheckedNets.insert(net_it);
 		bool myIsPossibleInput = true;
 		bool myHasGateConnection = false;
-		if ( firstGate_v[net_it] == UNKNOWN_DEVICE && firstSource_v[net_it] == UNKNOWN_DEVICE && firstDrain_v[net_it] == UNKNOWN_DEVICE ) {
+		if ( gateAdjacency.Count(net_it) == 0 && sourceAdjacency.Count(net_it) == 0 && drainAdjacency.Count(net_it) == 0 ) {
 			reportFile << NetName(net_it, PRINT_CIRCUIT_ON) << " NO_CONNECTIONS" << endl;
 		}
 		while( ! myUncheckedNets.empty() && myUncheckedNets.size() < 10 && myIsPossibleInput ) {  // 10 is arbitrary limit to prevent runaway
 			netId_t myCheckNet = *(myUncheckedNets.begin());
 			myCheckedNets.insert(myCheckNet);
 			myUncheckedNets.erase(myUncheckedNets.begin());
-			if ( firstGate_v[myCheckNet] != UNKNOWN_DEVICE ) {
+			if ( gateAdjacency.Count(myCheckNet) > 0 ) {
 				myHasGateConnection = true;
 			}
-			for ( deviceId_t device_it = firstSource_v[myCheckNet]; device_it != UNKNOWN_DEVICE && myIsPossibleInput; device_it = nextSource_v[device_it] ) {
+			for ( auto device_pit = sourceAdjacency.begin(myCheckNet); device_pit != sourceAdjacency.end(myCheckNet) && myIsPossibleInput; device_pit++ ) {
+				deviceId_t device_it = *device_pit;
 				netId_t mySearchNet = drainNet_v[device_it];
 				if ( ( IsMos_(deviceType_v[device_it]) && mySearchNet != gateNet_v[device_it] )
 						|| ( ! IsMos_(device_it) && netVoltagePtr_v[mySearchNet].full ) ) {
@@ -1650,7 +1799,8 @@ void CCvcDb::PrintNetSuggestions() {
 					}
 				}
 			}
-			for ( deviceId_t device_it = firstDrain_v[myCheckNet]; device_it != UNKNOWN_DEVICE && myIsPossibleInput; device_it = nextDrain_v[device_it] ) {
+			for ( auto device_pit = drainAdjacency.begin(myCheckNet); device_pit != drainAdjacency.end(myCheckNet) && myIsPossibleInput; device_pit++ ) {
+				deviceId_t device_it = *device_pit;
 				netId_t mySearchNet = sourceNet_v[device_it];
 				if ( ( IsMos_(deviceType_v[device_it]) && mySearchNet != gateNet_v[device_it] )
 						|| ( ! IsMos_(device_it) && netVoltagePtr_v[mySearchNet].full ) ) {
@@ -1674,6 +1824,7 @@ void CCvcDb::PrintNetSuggestions() {
 }
 
 returnCode_t CCvcDb::LoadCellErrorLimits() {
+	CInstanceIdVector().swap(errorLimitAncestor_v);
 	if ( IsEmpty(cvcParameters.cvcCellErrorLimitFile) ) return OK;
 	igzstream myCellErrorLimitFile;
 	myCellErrorLimitFile.open(cvcParameters.cvcCellErrorLimitFile);
@@ -1701,6 +1852,14 @@ returnCode_t CCvcDb::LoadCellErrorLimits() {
 		return FAIL;
 	}
 	myCellErrorLimitFile.close();
+	// Resolved once so error counting does not search the hierarchy. Parents have lower ids than their subcircuits.
+	errorLimitAncestor_v.assign(topCircuit_p->subcircuitCount, 0);
+	for ( instanceId_t instance_it = 1; instance_it < errorLimitAncestor_v.size(); instance_it++ ) {
+		CInstance * myInstance_p = instancePtr_v[instance_it];
+		assert(myInstance_p->parentId < instance_it);
+		errorLimitAncestor_v[instance_it] = ( myInstance_p->master_p->errorLimit == UNKNOWN_DEVICE )
+			? errorLimitAncestor_v[myInstance_p->parentId] : instance_it;
+	}
 	return OK;
 }
 
@@ -829,7 +829,7 @@ returnCode_t CCvcDb::InteractiveCvc(int theCurrentStage) {
 					for (auto netId_pit = myNetIdList->begin(); netId_pit != myNetIdList->end(); netId_pit++) {
 						netId_t myEquivalentNetId = (isFixedEquivalentNet) ? GetEquivalentNet(*netId_pit) : *netId_pit;
 						string myTopNet = NetName(myEquivalentNetId, myPrintSubcircuitNameFlag);
-						netId_t myFinalNet = simNet_v[myEquivalentNetId].finalNetId;
+						netId_t myFinalNet = simNet_v.FinalNetId(myEquivalentNetId);
 						reportFile << myTopNet << " ";
 						if ( netVoltagePtr_v[myFinalNet].full ) {
 							netVoltagePtr_v[myFinalNet].full->Print(reportFile);
@@ -1020,13 +1020,13 @@ returnCode_t CCvcDb::InteractiveCvc(int theCurrentStage) {
 						}
 						reportFile << endl;
 						if ( theCurrentStage >= STAGE_COMPLETE ) {
-							if ( minNet_v[myEquivalentNetId].backupNetId != myNetId )
+							if ( minNet_v.BackupNetId(myEquivalentNetId) != myNetId )
 								PrintBackupNet(minNet_v, myNetId, "Initial min path", reportFile);
-							if ( maxNet_v[myEquivalentNetId].backupNetId != myNetId )
+							if ( maxNet_v.BackupNetId(myEquivalentNetId) != myNetId )
 								PrintBackupNet(maxNet_v, myNetId, "Initial max path", reportFile);
 						}
 						if ( theCurrentStage >= STAGE_SECOND_SIM ) {
-							if ( simNet_v[myEquivalentNetId].backupNetId != myNetId )
+							if ( simNet_v.BackupNetId(myEquivalentNetId) != myNetId )
 								PrintBackupNet(simNet_v, myNetId, "Initial sim path", reportFile);
 	/* 3pass
 							if ( logicMinNet_v[myNetId].nextNetId != myNetId )
@@ -1058,6 +1058,7 @@ returnCode_t CCvcDb::InteractiveCvc(int theCurrentStage) {
 				cvcArgIndex--;
 				logFile.close();
 				errorFile.close();
+				errorDatabase.Close();
 				myReturnCode = SKIP;
 //			} else if ( myCommand == "shortfile" || myCommand == "s" ) {
 //				myFileName = "";
@@ -1174,7 +1175,7 @@ void CCvcDb::DumpUnknownLogicalPorts(instanceId_t theCurrentInstanceId, string t
 			if ( myPrintedNets.count(myTopNetId) > 0 ) continue;  // ignore already printed
 			if ( ! myIsLogicalNet_v[myTopNetId] ) continue;  // ignore analog nets and known logic
 			if ( ! regex_match(signalMap_pit->first, mySearchPattern) ) continue;  // ignore non-match
-			if ( firstGate_v[myTopNetId] == UNKNOWN_NET ) continue;  // ignore floating outputs (also ignores transfer gate connections)
+			if ( gateAdjacency.First(myTopNetId) == UNKNOWN_NET ) continue;  // ignore floating outputs (also ignores transfer gate connections)
 			netId_t mySourceNet = myTopNetId;
 			myNetStack.push_front(tuple<instanceId_t, netId_t, netId_t>(instance_it, net_it, mySourceNet));
 			// must be done after second sim so power & override nets are propagated
@@ -1189,7 +1190,7 @@ void CCvcDb::DumpUnknownLogicalPorts(instanceId_t theCurrentInstanceId, string t
 				netId_t myNet = get<2>(mySearchTuple);
 				if ( ! IsInstanceNet(myNet, theCurrentInstanceId) ) continue;  // ignore nets not in current instance
 				instanceId_t mySearchInstance = get<0>(mySearchTuple);
-				deviceId_t mySourceDevice = ( firstSource_v[myNet] == UNKNOWN_DEVICE ) ? firstDrain_v[myNet] : firstSource_v[myNet];
+				deviceId_t mySourceDevice = ( sourceAdjacency.Count(myNet) == 0 ) ? drainAdjacency.First(myNet) : sourceAdjacency.First(myNet);
 				if ( mySourceDevice != UNKNOWN_DEVICE ) {  // use device instance as search
 					mySearchInstance = deviceParent_v[mySourceDevice];
 				}
@@ -1268,7 +1269,7 @@ void CCvcDb::DumpUnknownLogicalNets(string theFileName, bool thePrintCircuitFlag
 	for ( netId_t net_it = 0; net_it < netCount; net_it++ ) {
 		if ( ! myIsLogicalNet_v[net_it] ) continue;  // skip shorted, defined, and analog nets
 
-		if ( simNet_v[net_it].finalNetId != net_it ) continue;  // skip known values
+		if ( simNet_v.FinalNetId(net_it) != net_it ) continue;  // skip known values
 
 		if ( inverterNet_v[net_it] != UNKNOWN_NET
 				&& inverterNet_v[net_it] >= topCircuit_p->portCount
@@ -1583,31 +1584,31 @@ void CCvcDb::PrintInstancePowerFile(instanceId_t theInstanceId, string thePowerF
 			CPower *myMinPower_p = NULL;
 			CPower *myMaxPower_p = NULL;
 			if ( theCurrentStage == STAGE_COMPLETE ) {
-				myMinNetId = minNet_v[myGlobalNetId].backupNetId;
+				myMinNetId = minNet_v.BackupNetId(myGlobalNetId);
 				if ( myMinNetId != UNKNOWN_NET ) {
-					while ( myMinNetId != minNet_v[myMinNetId].backupNetId ) {
-						myMinNetId = minNet_v[myMinNetId].backupNetId;
+					while ( myMinNetId != minNet_v.BackupNetId(myMinNetId) ) {
+						myMinNetId = minNet_v.BackupNetId(myMinNetId);
 					}
 					myMinPower_p = leakVoltagePtr_v[myMinNetId].full;
 				}
-				myMaxNetId = maxNet_v[myGlobalNetId].backupNetId;
+				myMaxNetId = maxNet_v.BackupNetId(myGlobalNetId);
 				if ( myMaxNetId != UNKNOWN_NET ) {
-					while ( myMaxNetId != maxNet_v[myMaxNetId].backupNetId ) {
-						myMaxNetId = maxNet_v[myMaxNetId].backupNetId;
+					while ( myMaxNetId != maxNet_v.BackupNetId(myMaxNetId) ) {
+						myMaxNetId = maxNet_v.BackupNetId(myMaxNetId);
 					}
 					myMaxPower_p = leakVoltagePtr_v[myMaxNetId].full;
 				}
 			} else {
-				myMinNetId = minNet_v[myGlobalNetId].finalNetId;
+				myMinNetId = minNet_v.FinalNetId(myGlobalNetId);
 				if ( myMinNetId != UNKNOWN_NET ) {
 					myMinPower_p = netVoltagePtr_v[myMinNetId].full;
 				}
-				myMaxNetId = maxNet_v[myGlobalNetId].finalNetId;
+				myMaxNetId = maxNet_v.FinalNetId(myGlobalNetId);
 				if ( myMaxNetId != UNKNOWN_NET ) {
 					myMaxPower_p = netVoltagePtr_v[myMaxNetId].full;
 				}
 			}
-			netId_t mySimNetId = simNet_v[myGlobalNetId].finalNetId;
+			netId_t mySimNetId = simNet_v.FinalNetId(myGlobalNetId);
 			if ( myMinPower_p && myMinPower_p->minVoltage != UNKNOWN_VOLTAGE ) {
 				myPowerFile << " min@" << PrintParameter(myMinPower_p->minVoltage, VOLTAGE_SCALE);
 			}
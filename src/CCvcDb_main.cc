@@ -65,6 +65,8 @@ void CCvcDb::VerifyCircuitForAllModes(int argc, const char * argv[]) {
 		cvcParameters.LoadEnvironment(argv[cvcArgIndex], reportPrefix);
 		if ( ! LockReport(gInteractive_cvc) ) continue;
 		SetOutputFiles(cvcParameters.cvcReportFilename);
+		SetSpillDirectory(cvcParameters.cvcScratchDirectory);
+		AdviseSpill(SPILL_SEQUENTIAL);
 		logFile << "CVC: Circuit Validation Check  Version " << CVC_VERSION << endl;
 		reportFile << "CVC: Start: " << CurrentTime() << endl;
 		TakeSnapshot(&lastSnapshot);
@@ -90,12 +92,20 @@ void CCvcDb::VerifyCircuitForAllModes(int argc, const char * argv[]) {
 			}
 */
 		} else {
-			reportFile << "CVC: Parsing netlist " << cvcParameters.cvcNetlistFilename << endl;
 			cvcCircuitList.Clear();
 			instancePtr_v.Clear();
-			if (cvcParserDriver.parse (cvcParameters.cvcNetlistFilename, cvcCircuitList,
-					cvcParameters.cvcSOI ) != 0 ) {
-				throw EFatalError("Could not parse " + cvcParameters.cvcNetlistFilename);
+			if ( ! IsEmpty(cvcParameters.cvcNetlistCacheFile)
+					&& cvcCircuitList.LoadNetlistCache(cvcParameters.cvcNetlistCacheFile, cvcParameters.cvcNetlistFilename, cvcParameters.cvcSOI) ) {
+				reportFile << "CVC: Reading netlist cache " << cvcParameters.cvcNetlistCacheFile << endl;
+			} else {
+				reportFile << "CVC: Parsing netlist " << cvcParameters.cvcNetlistFilename << endl;
+				if (cvcParserDriver.parse (cvcParameters.cvcNetlistFilename, cvcCircuitList,
+						cvcParameters.cvcSOI, cvcParameters.cvcNetlistParseJobs ) != 0 ) {
+					throw EFatalError("Could not parse " + cvcParameters.cvcNetlistFilename);
+				}
+				if ( ! IsEmpty(cvcParameters.cvcNetlistCacheFile) ) {
+					cvcCircuitList.SaveNetlistCache(cvcParameters.cvcNetlistCacheFile, cvcParameters.cvcNetlistFilename, cvcParameters.cvcSOI);
+				}
 			}
 			if (cvcCircuitList.errorCount > 0 || cvcCircuitList.warningCount > 0) {
 				reportFile << "WARNING: unsupported devices in netlist" << endl;
@@ -123,6 +133,7 @@ void CCvcDb::VerifyCircuitForAllModes(int argc, const char * argv[]) {
 		if ( powerFileStatus == OK ) {
 			cout << "Setting power for mode..." << endl;
 			powerFileStatus = SetModePower();
+			SetPowerState();
 		}
 		if ( modelFileStatus == OK ) {
 			cout << "Setting models..." << endl;
@@ -143,44 +154,57 @@ void CCvcDb::VerifyCircuitForAllModes(int argc, const char * argv[]) {
 			}
 			continue;
 		}
+		if ( resumeStage > 0 ) {
+			ResetMinSimMaxAndQueues();
+			LoadCheckpoint(resumeStage);
+			reportFile << PrintProgress(&lastSnapshot, "RESUME") << endl;
+		}
 
 /// Stage 2) Create database
-		ResetMinSimMaxAndQueues();
-		SetEquivalentNets();
-		if ( SetInstancePower() != OK || SetExpectedPower() != OK ) {
-			reportFile << "ERROR: skipped due to problems in power files" << endl;
-			continue;
-		}
-		cvcParameters.cvcPowerPtrList.SetFamilies(cvcParameters.cvcPowerFamilyMap);
-		cvcParameters.SetHiZPropagation();
-		cvcParameters.cvcModelListMap.Print(logFile);
-		PrintPowerList(logFile, "Power List");
-		cvcParameters.cvcPowerPtrList.SetPowerLimits(maxPower, minPower);
-		LinkDevices();
-		OverrideFuses();
-		mosDiodeSet.clear();
-		if ( gSetup_cvc ) {
-			PrintNetSuggestions();
-		}
-		reportFile << PrintProgress(&lastSnapshot, "EQUIV") << endl;
-		reportFile << "Power nets " << CPower::powerCount << endl;
-//		DumpStatistics(parameterModelPtrMap, "parameter->model map", logFile);
-		DumpStatistics(parameterResistanceMap, "parameter->resistance map", logFile);
-		DumpStatistics(cvcCircuitList.circuitNameMap, "text->circuit map", logFile);
-		DumpStatistics(cvcCircuitList.cdlText.fixedTextToAddressMap, "string->text map", logFile);
-		if ( gInteractive_cvc && --gContinueCount < 1 && InteractiveCvc(STAGE_LINK) == SKIP ) {
-			continue;
+		if ( resumeStage < STAGE_LINK ) {
+			AdviseSpill(SPILL_SEQUENTIAL);
+			ResetMinSimMaxAndQueues();
+			SetEquivalentNets();
+			if ( SetInstancePower() != OK || SetExpectedPower() != OK ) {
+				reportFile << "ERROR: skipped due to problems in power files" << endl;
+				continue;
+			}
+			cvcParameters.cvcPowerPtrList.SetFamilies(cvcParameters.cvcPowerFamilyMap);
+			cvcParameters.SetHiZPropagation();
+			cvcParameters.cvcModelListMap.Print(logFile);
+			PrintPowerList(logFile, "Power List");
+			cvcParameters.cvcPowerPtrList.SetPowerLimits(maxPower, minPower);
+			LinkDevices();
+			ReportPowerChanges();
+			OverrideFuses();
+			mosDiodeSet.clear();
+			if ( gSetup_cvc ) {
+				PrintNetSuggestions();
+			}
+			reportFile << PrintProgress(&lastSnapshot, "EQUIV") << endl;
+			reportFile << "Power nets " << CPower::powerCount << endl;
+//			DumpStatistics(parameterModelPtrMap, "parameter->model map", logFile);
+			DumpStatistics(parameterResistanceMap, "parameter->resistance map", logFile);
+			DumpStatistics(cvcCircuitList.circuitNameMap, "text->circuit map", logFile);
+			cvcCircuitList.cdlText.DumpStatistics("string->text map", logFile);
+			if ( gInteractive_cvc && --gContinueCount < 1 && InteractiveCvc(STAGE_LINK) == SKIP ) {
+				continue;
+			}
+			SaveCheckpoint(STAGE_LINK);
 		}
 
 /// Stage 3) Calculate voltages across resistors
 /// - Calculated resistance
-		ShortNonConductingResistors();
-//		SetResistorVoltagesForMosSwitches();
-		SetResistorVoltagesByPower();
-		reportFile << PrintProgress(&lastSnapshot, "RES") << endl;
-		reportFile << "Power nets " << CPower::powerCount << endl;
-		if ( gInteractive_cvc && --gContinueCount < 1
-				&& InteractiveCvc(STAGE_RESISTANCE) == SKIP ) continue;
+		if ( resumeStage < STAGE_RESISTANCE ) {
+			ShortNonConductingResistors();
+//			SetResistorVoltagesForMosSwitches();
+			SetResistorVoltagesByPower();
+			reportFile << PrintProgress(&lastSnapshot, "RES") << endl;
+			reportFile << "Power nets " << CPower::powerCount << endl;
+			if ( gInteractive_cvc && --gContinueCount < 1
+					&& InteractiveCvc(STAGE_RESISTANCE) == SKIP ) continue;
+			SaveCheckpoint(STAGE_RESISTANCE);
+		}
 
 /// Stage 4) First min/max propagation\n
 /// - unexpected min/max values\n
@@ -189,72 +213,85 @@ void CCvcDb::VerifyCircuitForAllModes(int argc, const char * argv[]) {
 /// - NMOS gate-source errors\n
 /// - PMOS source-bulk errors\n
 /// - PMOS gate-source errors\n
-		ResetMinMaxPower();
-		SetAnalogNets();
-		reportFile << PrintProgress(&lastSnapshot, "MIN/MAX1") << endl;
-		reportFile << "Power nets " << CPower::powerCount << endl;
-		if ( detectErrorFlag ) {
-			if ( ! cvcParameters.cvcLogicDiodes ) {
-				FindForwardBiasDiodes();
-			}
-			if ( ! cvcParameters.cvcSOI ) {
-				FindNmosSourceVsBulkErrors();
+		if ( resumeStage < STAGE_FIRST_MINMAX ) {
+			AdviseSpill(SPILL_RANDOM);
+			ResetMinMaxPower();
+			SetAnalogNets();
+			reportFile << PrintProgress(&lastSnapshot, "MIN/MAX1") << endl;
+			reportFile << "Power nets " << CPower::powerCount << endl;
+			if ( detectErrorFlag ) {
+				AdviseSpill(SPILL_SEQUENTIAL);
+				ScanDeviceErrors(STAGE_FIRST_MINMAX);
+				if ( ! cvcParameters.cvcLogicDiodes ) {
+					FindForwardBiasDiodes();
+				}
+				if ( ! cvcParameters.cvcSOI ) {
+					FindNmosSourceVsBulkErrors();
+				}
+				if ( ! gSetup_cvc ) {
+					FindNmosGateVsSourceErrors();
+				}
+				if ( ! cvcParameters.cvcSOI ) {
+					FindPmosSourceVsBulkErrors();
+				}
+				if ( ! gSetup_cvc ) {
+					FindPmosGateVsSourceErrors();
+				}
+				reportFile << PrintProgress(&lastSnapshot, "ERROR") << endl;
 			}
-			if ( ! gSetup_cvc ) {
-				FindNmosGateVsSourceErrors();
-			}
-			if ( ! cvcParameters.cvcSOI ) {
-				FindPmosSourceVsBulkErrors();
-			}
-			if ( ! gSetup_cvc ) {
-				FindPmosGateVsSourceErrors();
-			}
-			reportFile << PrintProgress(&lastSnapshot, "ERROR") << endl;
+			if ( gInteractive_cvc && --gContinueCount < 1
+					&& InteractiveCvc(STAGE_FIRST_MINMAX) == SKIP ) continue;
+			SaveCheckpoint(STAGE_FIRST_MINMAX);
 		}
-		if ( gInteractive_cvc && --gContinueCount < 1
-				&& InteractiveCvc(STAGE_FIRST_MINMAX) == SKIP ) continue;
 		if ( gSetup_cvc ) continue;
 
 /// Stage 5) First sim propagation\n
 /// - missing bulk connection check
-		SaveMinMaxLeakVoltages();
-		SetSimPower(POWER_NETS_ONLY);
-		cvcCircuitList.PrintAndResetCircuitErrors(this, cvcParameters.cvcCircuitErrorLimit, logFile, errorFile, "! Logic shorts 1");
-		reportFile << PrintProgress(&lastSnapshot, "SIM1") << endl;
-		reportFile << "Power nets " << CPower::powerCount << endl;
-		if ( ! cvcParameters.cvcSOI ) {
-			CheckConnections();
-		}
-		if ( gInteractive_cvc && --gContinueCount < 1
-				&& InteractiveCvc(STAGE_FIRST_SIM) == SKIP ) continue;
-		SaveInitialVoltages();
-		if ( gDebug_cvc ) {
-			PrintAllVirtualNets<CVirtualNetVector>(
-					minNet_v, simNet_v, maxNet_v, "(1)");
+		if ( resumeStage < STAGE_FIRST_SIM ) {
+			AdviseSpill(SPILL_RANDOM);
+			SaveMinMaxLeakVoltages();
+			SetSimPower(POWER_NETS_ONLY);
+			cvcCircuitList.PrintAndResetCircuitErrors(this, cvcParameters.cvcCircuitErrorLimit, logFile, errorFile, "! Logic shorts 1");
+			reportFile << PrintProgress(&lastSnapshot, "SIM1") << endl;
+			reportFile << "Power nets " << CPower::powerCount << endl;
+			if ( ! cvcParameters.cvcSOI ) {
+				CheckConnections();
+			}
+			if ( gInteractive_cvc && --gContinueCount < 1
+					&& InteractiveCvc(STAGE_FIRST_SIM) == SKIP ) continue;
+			SaveInitialVoltages();
+			if ( gDebug_cvc ) {
+				PrintAllVirtualNets<CVirtualNetVector>(
+						minNet_v, simNet_v, maxNet_v, "(1)");
+			}
+			SaveCheckpoint(STAGE_FIRST_SIM);
 		}
 
 /// Stage 6) Second sim propagation\n
 /// - LDD connection errors
-		if ( cvcParameters.cvcSCRC ) {
-			SetSCRCPower();
-		}
-		SetSimPower(ALL_NETS_AND_FUSE);
-		reportFile << PrintProgress(&lastSnapshot, "SIM2") << endl;
-		reportFile << "Power nets " << CPower::powerCount << endl;
-		CNetIdSet myNewNetSet;
-		vector<bool> myIgnoreNet_v(simNet_v.size(), false);
-		int myPassCount = 0;
-		while ( SetLatchPower(++myPassCount, myIgnoreNet_v, myNewNetSet) ) {
-			SetSimPower(ALL_NETS_AND_FUSE, myNewNetSet);
-			reportFile << PrintProgress(&lastSnapshot, "LATCH " + to_string(myPassCount)) << endl;
-		}
-		cvcCircuitList.PrintAndResetCircuitErrors(this, cvcParameters.cvcCircuitErrorLimit, logFile, errorFile, "! Logic shorts 2");
-		if ( detectErrorFlag ) {
-			FindLDDErrors();
-//			FindForwardBiasDiodes();
+		if ( resumeStage < STAGE_SECOND_SIM ) {
+			if ( cvcParameters.cvcSCRC ) {
+				SetSCRCPower();
+			}
+			SetSimPower(ALL_NETS_AND_FUSE);
+			reportFile << PrintProgress(&lastSnapshot, "SIM2") << endl;
+			reportFile << "Power nets " << CPower::powerCount << endl;
+			CNetIdSet myNewNetSet;
+			vector<bool> myIgnoreNet_v(simNet_v.size(), false);
+			int myPassCount = 0;
+			while ( SetLatchPower(++myPassCount, myIgnoreNet_v, myNewNetSet) ) {
+				SetSimPower(ALL_NETS_AND_FUSE, myNewNetSet);
+				reportFile << PrintProgress(&lastSnapshot, "LATCH " + to_string(myPassCount)) << endl;
+			}
+			cvcCircuitList.PrintAndResetCircuitErrors(this, cvcParameters.cvcCircuitErrorLimit, logFile, errorFile, "! Logic shorts 2");
+			if ( detectErrorFlag ) {
+				FindLDDErrors();
+//				FindForwardBiasDiodes();
+			}
+			if ( gInteractive_cvc && --gContinueCount < 1
+					&& InteractiveCvc(STAGE_SECOND_SIM) == SKIP ) continue;
+			SaveCheckpoint(STAGE_SECOND_SIM);
 		}
-		if ( gInteractive_cvc && --gContinueCount < 1
-				&& InteractiveCvc(STAGE_SECOND_SIM) == SKIP ) continue;
 
 /// Stage 7) Second min/max propagation\n
 /// - overvoltage errors\n
@@ -262,11 +299,14 @@ void CCvcDb::VerifyCircuitForAllModes(int argc, const char * argv[]) {
 /// - PMOS possible leak errors\n
 /// - floating gate errors\n
 /// - expected value errors
+		AdviseSpill(SPILL_RANDOM);
 		ResetMinMaxPower();
 		SetInverters();
 		reportFile << PrintProgress(&lastSnapshot, "MIN/MAX2") << endl;
 		reportFile << "Power nets " << CPower::powerCount << endl;
 		if ( detectErrorFlag ) {
+			AdviseSpill(SPILL_SEQUENTIAL);
+			ScanDeviceErrors(STAGE_COMPLETE);
 			if ( cvcParameters.cvcLogicDiodes ) {
 				FindForwardBiasDiodes();
 			}
@@ -285,13 +325,19 @@ void CCvcDb::VerifyCircuitForAllModes(int argc, const char * argv[]) {
 			cvcParameters.cvcModelListMap.DebugPrint();
 			Print("", "CVC Database");
 			PrintFlatCdl();
+			PrintCellContexts();
 		}
+		SavePowerState();
 		reportFile << "Virtual net update/access " << gVirtualNetUpdateCount << "/"
 				<< gVirtualNetAccessCount << endl;
+		if ( ! IsEmpty(cvcParameters.cvcScratchDirectory) ) {
+			reportFile << "CVC: Scratch file peak " << SpillPeakSize() << " bytes in " << cvcParameters.cvcScratchDirectory << endl;
+		}
 		reportFile << "CVC: Log output to " << cvcParameters.cvcReportFilename << endl;
 		reportFile << "CVC: End: " << CurrentTime() << endl;
 		errorFile.close();
 		debugFile.close();
+		errorDatabase.Close();
 		if ( gInteractive_cvc ) InteractiveCvc(STAGE_COMPLETE);
 
 /// Clean-up
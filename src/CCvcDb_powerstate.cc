@@ -0,0 +1,195 @@
+/*
+ * CCvcDb_powerstate.cc
+ *
+ * Copyright 2014-2026 D. Mitch Bailey  cvc at shuharisystem dot com
+ *
+ * This file is part of cvc.
+ *
+ * cvc is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cvc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with cvc.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * You can download cvc from https://github.com/d-m-bailey/cvc.git
+ */
+
+#include "Cvc.hh"
+#include "CCvcDb.hh"
+#include "CCvcParameters.hh"
+#include "CPower.hh"
+
+/// \file
+/// Power definition diff report between runs (CVC_POWER_STATE_FILE)
+
+#define POWER_STATE_HEADER "#CVC power state "
+#define POWER_CHANGE_REPORT_LIMIT 10
+
+string CCvcDb::PowerStateFilename() {
+	// One state file per mode. The header includes the mode settings, so modes cannot share a file.
+	if ( IsEmpty(cvcParameters.cvcMode) ) return cvcParameters.cvcPowerStateFile;
+	return cvcParameters.cvcPowerStateFile + "." + cvcParameters.cvcMode;
+}
+
+string CCvcDb::PowerStateHeader() {
+	// Everything except the power definitions that affects propagation, one item per line.
+	// changes in any input file invalidate the saved power state.
+	stringstream myHeader;
+	myHeader << POWER_STATE_HEADER << CVC_VERSION << endl;
+	myHeader << "netlist " << cvcParameters.cvcTopBlock << " " << cvcParameters.cvcSOI << " " << FileIdentity(cvcParameters.cvcNetlistFilename) << endl;
+	myHeader << "model " << FileIdentity(cvcParameters.cvcModelFilename) << endl;
+	myHeader << "fuse " << FileIdentity(cvcParameters.cvcFuseFilename) << endl;
+	stringstream myEnvironment;
+	cvcParameters.PrintEnvironment(myEnvironment);
+	string myInput;
+	while ( getline(myEnvironment, myInput) ) {
+		if ( myInput.substr(0, 4) != "CVC_" ) continue;
+		// file names, output and resource settings do not change propagation
+		if ( myInput.find("_FILE =") != string::npos || myInput.find("_DIRECTORY =") != string::npos
+				|| myInput.find("_NAME =") != string::npos || myInput.find("_TITLE =") != string::npos
+				|| myInput.find("_JOBS =") != string::npos || myInput.find("_THREAD_COUNT =") != string::npos ) continue;
+		myHeader << "env " << myInput << endl;
+	}
+	return myHeader.str();
+}
+
+void CCvcDb::SetPowerState() {
+	// Save the definition of each net with power after SetModePower.
+	powerState.clear();
+	if ( IsEmpty(cvcParameters.cvcPowerStateFile) ) return;
+	for ( netId_t net_it = 0; net_it < netCount; net_it++ ) {
+		CPower * myPower_p = netVoltagePtr_v[net_it].full;
+		if ( ! myPower_p ) continue;
+		powerState[net_it] = string(myPower_p->powerSignal()) + " " + string(myPower_p->definition) + " :" + myPower_p->PowerDefinition();
+	}
+}
+
+void CCvcDb::ReportPowerChanges() {
+	// Compare power definitions with the last saved state and report the nets and devices that the changes can reach.
+	// Report only. Propagation is still done for the whole circuit.
+	if ( IsEmpty(cvcParameters.cvcPowerStateFile) ) return;
+	string myStateFilename = PowerStateFilename();
+	ifstream myStateFile(myStateFilename);
+	if ( myStateFile.fail() ) {
+		reportFile << "CVC: No power state in " << myStateFilename << endl;
+		return;
+	}
+	stringstream myHeader(PowerStateHeader());
+	string myInput, myExpected;
+	while ( getline(myHeader, myExpected) ) {
+		if ( ! getline(myStateFile, myInput) || myInput != myExpected ) {
+			reportFile << "CVC: Power state " << myStateFilename << " does not match: " << myExpected << endl;
+			return;
+		}
+	}
+	map<netId_t, string> myLastPowerState;
+	while ( getline(myStateFile, myInput) ) {
+		size_t myDelimiter = myInput.find(' ', 6);
+		if ( myInput.substr(0, 6) != "power " || myDelimiter == string::npos ) {
+			reportFile << "CVC: Invalid power state " << myStateFilename << endl;
+			return;
+		}
+		netId_t myNetId = from_string<netId_t>(myInput.substr(6, myDelimiter - 6));
+		if ( myNetId >= netCount ) {
+			reportFile << "CVC: Invalid power state " << myStateFilename << endl;
+			return;
+		}
+		myLastPowerState[myNetId] = myInput.substr(myDelimiter + 1);
+	}
+	myStateFile.close();
+	// changed, added and removed definitions
+	list<netId_t> myChangedNet_l;
+	auto myLast_pit = myLastPowerState.begin();
+	auto myCurrent_pit = powerState.begin();
+	while ( myLast_pit != myLastPowerState.end() || myCurrent_pit != powerState.end() ) {
+		if ( myCurrent_pit == powerState.end() || ( myLast_pit != myLastPowerState.end() && myLast_pit->first < myCurrent_pit->first ) ) {
+			logFile << "INFO: power removed " << NetName(myLast_pit->first) << " " << myLast_pit->second << endl;
+			myChangedNet_l.push_back(myLast_pit->first);
+			myLast_pit++;
+		} else if ( myLast_pit == myLastPowerState.end() || myCurrent_pit->first < myLast_pit->first ) {
+			logFile << "INFO: power added " << NetName(myCurrent_pit->first) << " " << myCurrent_pit->second << endl;
+			myChangedNet_l.push_back(myCurrent_pit->first);
+			myCurrent_pit++;
+		} else {
+			if ( myLast_pit->second != myCurrent_pit->second ) {
+				logFile << "INFO: power changed " << NetName(myCurrent_pit->first) << " " << myLast_pit->second << " -> " << myCurrent_pit->second << endl;
+				myChangedNet_l.push_back(myCurrent_pit->first);
+			}
+			myLast_pit++;
+			myCurrent_pit++;
+		}
+	}
+	// Fan-out through source/drain and from gate to source/drain. Fully defined power nets stop propagation.
+	vector<bool> myAffectedNet_v(netCount, false);
+	vector<bool> myAffectedDevice_v(deviceCount, false);
+	netId_t myAffectedNetCount = 0;
+	deviceId_t myAffectedDeviceCount = 0;
+	list<netId_t> myPendingNet_l;
+	for ( auto net_pit = myChangedNet_l.begin(); net_pit != myChangedNet_l.end(); net_pit++ ) {
+		netId_t myNetId = GetEquivalentNet(*net_pit);
+		if ( myAffectedNet_v[myNetId] ) continue;
+		myAffectedNet_v[myNetId] = true;
+		myAffectedNetCount++;
+		myPendingNet_l.push_back(myNetId);
+	}
+	auto myAddNet = [&] (netId_t theNetId) {
+		if ( theNetId == UNKNOWN_NET || myAffectedNet_v[theNetId] ) return;
+		myAffectedNet_v[theNetId] = true;
+		myAffectedNetCount++;
+		CPower * myPower_p = netVoltagePtr_v[theNetId].full;
+		if ( myPower_p && myPower_p->minVoltage != UNKNOWN_VOLTAGE && myPower_p->simVoltage != UNKNOWN_VOLTAGE
+				&& myPower_p->maxVoltage != UNKNOWN_VOLTAGE ) return;
+		myPendingNet_l.push_back(theNetId);
+	};
+	CDeviceIdAdjacency * myAdjacency_v[] = {&sourceAdjacency, &drainAdjacency, &gateAdjacency};
+	while ( ! myPendingNet_l.empty() ) {
+		netId_t myNetId = myPendingNet_l.front();
+		myPendingNet_l.pop_front();
+		for ( auto adjacency_pp : myAdjacency_v ) {
+			for ( auto device_pit = adjacency_pp->begin(myNetId); device_pit != adjacency_pp->end(myNetId); device_pit++ ) {
+				if ( ! myAffectedDevice_v[*device_pit] ) {
+					myAffectedDevice_v[*device_pit] = true;
+					myAffectedDeviceCount++;
+				}
+				myAddNet(sourceNet_v[*device_pit]);
+				myAddNet(drainNet_v[*device_pit]);
+			}
+		}
+	}
+	reportFile << "CVC: Power changes since last run " << myChangedNet_l.size() << " nets";
+	reportFile << ", affecting " << myAffectedNetCount << " nets and " << myAffectedDeviceCount << " devices" << endl;
+	int myPrintCount = 0;
+	for ( auto net_pit = myChangedNet_l.begin(); net_pit != myChangedNet_l.end() && myPrintCount++ < POWER_CHANGE_REPORT_LIMIT; net_pit++ ) {
+		reportFile << "  " << NetName(*net_pit) << endl;
+	}
+	if ( myChangedNet_l.size() > POWER_CHANGE_REPORT_LIMIT ) {
+		reportFile << "  ... see log for all changes" << endl;
+	}
+}
+
+void CCvcDb::SavePowerState() {
+	// Written after a complete run, so that an interrupted run keeps the last state.
+	if ( IsEmpty(cvcParameters.cvcPowerStateFile) ) return;
+	string myStateFilename = PowerStateFilename();
+	string myTemporaryFilename = myStateFilename + ".tmp";
+	ofstream myStateFile(myTemporaryFilename, ios::trunc);
+	if ( myStateFile.fail() ) {
+		reportFile << "WARNING: Could not write power state " << myStateFilename << endl;
+		return;
+	}
+	myStateFile << PowerStateHeader();
+	for ( auto power_pit = powerState.begin(); power_pit != powerState.end(); power_pit++ ) {
+		myStateFile << "power " << power_pit->first << " " << power_pit->second << endl;
+	}
+	myStateFile.close();
+	if ( myStateFile.fail() || rename(myTemporaryFilename.c_str(), myStateFilename.c_str()) != 0 ) {
+		reportFile << "WARNING: Could not write power state " << myStateFilename << endl;
+	}
+}
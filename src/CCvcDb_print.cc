@@ -125,6 +125,7 @@ void CCvcDb::SetOutputFiles(string theReportFilename) {
 	if ( ! logFile.good() ) {
 		throw EFatalError("Could not open " + theReportFilename);
 	}
+	gzstreambuf::set_threads(cvcParameters.cvcThreadCount);  // gzip output is compressed and tagged gzip input is inflated in parallel
 	errorFile.open(cvcParameters.cvcReportBaseFilename + ".error.gz");
 	if ( ! errorFile.good() ) {
 		throw EFatalError("Could not open " + cvcParameters.cvcReportBaseFilename + ".error.gz");
@@ -133,6 +134,10 @@ void CCvcDb::SetOutputFiles(string theReportFilename) {
 	if ( ! debugFile.good() ) {
 		throw EFatalError("Could not open " + cvcParameters.cvcReportBaseFilename + ".debug.gz");
 	}
+	errorDatabase.Close();
+	if ( cvcParameters.cvcErrorDatabase ) {
+		errorDatabase.Open(cvcParameters.cvcReportBaseFilename + ".error.db");
+	}
 
 	reportFile << "CVC: Log output to " << theReportFilename << endl;
 	reportFile << "CVC: Error output to " << cvcParameters.cvcReportBaseFilename << ".error.gz" << endl;
@@ -245,6 +250,31 @@ void CCvcDb::PrintFlatCdl() {
 	PrintNewCdlLine(string(""));
 }
 
+void CCvcDb::PrintCellContexts() {
+	// Unique port voltage contexts (min/sim/max at each port) of expanded leaf cell instances.
+	// Cells with few contexts for many instances are the candidates for hierarchical verification.
+	debugFile << "DEBUG: leaf cell contexts" << endl;
+	for ( auto circuit_ppit = cvcCircuitList.begin(); circuit_ppit != cvcCircuitList.end(); circuit_ppit++ ) {
+		CCircuit * myCircuit_p = *circuit_ppit;
+		if ( myCircuit_p->instanceId_v.size() < 2 || ! myCircuit_p->subcircuitPtr_v.empty() ) continue;
+		unordered_set<string> myContextSet;
+		instanceId_t myExpandedCount = 0;
+		for ( auto instanceId_pit = myCircuit_p->instanceId_v.begin(); instanceId_pit != myCircuit_p->instanceId_v.end(); instanceId_pit++ ) {
+			CInstance * myInstance_p = instancePtr_v[*instanceId_pit];
+			if ( myInstance_p->IsParallelInstance() ) continue;
+			myExpandedCount++;
+			string myContext = "";
+			for ( netId_t port_it = 0; port_it < myCircuit_p->portCount; port_it++ ) {
+				netId_t myNetId = GetEquivalentNet(myInstance_p->localToGlobalNetId_v[port_it]);
+				myContext += to_string<voltage_t>(MinVoltage(myNetId)) + "/" + to_string<voltage_t>(SimVoltage(myNetId)) + "/"
+					+ to_string<voltage_t>(MaxVoltage(myNetId)) + " ";
+			}
+			myContextSet.insert(myContext);
+		}
+		debugFile << "DEBUG: cell " << myCircuit_p->name << " instances " << myExpandedCount << " contexts " << myContextSet.size() << endl;
+	}
+}
+
 void CCvcDb::PrintHierarchicalCdl(CCircuit *theCircuit, unordered_set<text_t> & thePrintedList, ostream & theCdlFile) {
 	for (instanceId_t instance_it = 0; instance_it < theCircuit->subcircuitPtr_v.size(); instance_it++) {
 		CCircuit * myMaster_p = theCircuit->subcircuitPtr_v[instance_it]->master_p;
@@ -351,11 +381,10 @@ void CCvcDb::PrintSourceDrainConnections(CStatus& theConnectionStatus, string th
 	cout << endl;
 }
 
-void CCvcDb::PrintConnections(deviceId_t theDeviceCount, deviceId_t theDeviceId, CDeviceIdVector& theNextDevice_v, string theIndentation, string theHeading) {
+void CCvcDb::PrintConnections(deviceId_t theDeviceCount, netId_t theNetId, CDeviceIdAdjacency& theAdjacency, string theIndentation, string theHeading) {
 	cout << theIndentation << theHeading << "(" << theDeviceCount << ")>";
-	while (theDeviceId != UNKNOWN_DEVICE ) {
-		cout << " " << theDeviceId;
-		theDeviceId = theNextDevice_v[theDeviceId];
+	for ( auto device_pit = theAdjacency.begin(theNetId); device_pit != theAdjacency.end(theNetId); device_pit++ ) {
+		cout << " " << *device_pit;
 	}
 	cout << endl;
 }
@@ -457,9 +486,9 @@ void CCvcDb::Print(const string theIndentation, const string theHeading) {
 //				netVoltagePtr_v[net_it]->Print(cout, myIndentation + "  ");
 //			}
 		}
-		if ( firstSource_v[net_it] != UNKNOWN_DEVICE ) PrintConnections(connectionCount_v[net_it].sourceCount, firstSource_v[net_it], nextSource_v, myIndentation + "  ", "SourceConnections");
-		if ( firstDrain_v[net_it] != UNKNOWN_DEVICE ) PrintConnections(connectionCount_v[net_it].drainCount, firstDrain_v[net_it], nextDrain_v, myIndentation + "  ", "DrainConnections");
-		if ( firstGate_v[net_it] != UNKNOWN_DEVICE ) PrintConnections(connectionCount_v[net_it].gateCount, firstGate_v[net_it], nextGate_v, myIndentation + "  ", "GateConnections");
+		if ( sourceAdjacency.Count(net_it) > 0 ) PrintConnections(connectionCount_v[net_it].sourceCount, net_it, sourceAdjacency, myIndentation + "  ", "SourceConnections");
+		if ( drainAdjacency.Count(net_it) > 0 ) PrintConnections(connectionCount_v[net_it].drainCount, net_it, drainAdjacency, myIndentation + "  ", "DrainConnections");
+		if ( gateAdjacency.Count(net_it) > 0 ) PrintConnections(connectionCount_v[net_it].gateCount, net_it, gateAdjacency, myIndentation + "  ", "GateConnections");
 		if ( myBulkCount[net_it] > 0 ) PrintBulkConnections(net_it, myIndentation + "  ", "BulkConnections");
 //		if ( firstBulk_v[net_it] != UNKNOWN_DEVICE ) PrintConnections(connectionCount_v[net_it].bulkCount, firstBulk_v[net_it], nextBulk_v, myIndentation + "  ", "BulkConnections");
 		if ( connectionCount_v[net_it].sourceCount + connectionCount_v[net_it].drainCount > 0 ) {
@@ -527,7 +556,7 @@ void CCvcDb::PrintVirtualNets(CVirtualNetVector& theVirtualNet_v, string theTitl
 	cout << theIndentation << "VirtualNetVector" << theTitle << "> end" << endl;
 }
 
-void CCvcDb::PrintDeviceWithAllConnections(instanceId_t theParentId, CFullConnection& theConnections, ogzstream& theErrorFile, bool theIncludeLeakVoltage) {
+void CCvcDb::PrintDeviceWithAllConnections(instanceId_t theParentId, CFullConnection& theConnections, ostream& theErrorFile, bool theIncludeLeakVoltage) {
 	int myMFactor = CalculateMFactor(theParentId);
 	theErrorFile << DeviceName(theConnections.device_p->name, theParentId, PRINT_CIRCUIT_ON) << " " << theConnections.device_p->parameters;
 	if ( myMFactor > 1 ) theErrorFile << " {m=" << myMFactor << "}";
@@ -557,7 +586,7 @@ void CCvcDb::PrintDeviceWithAllConnections(instanceId_t theParentId, CFullConnec
 	}
 }
 
-void CCvcDb::PrintDeviceWithSimConnections(instanceId_t theParentId, CFullConnection& theConnections, ogzstream& theErrorFile) {
+void CCvcDb::PrintDeviceWithSimConnections(instanceId_t theParentId, CFullConnection& theConnections, ostream& theErrorFile) {
 	int myMFactor = CalculateMFactor(theParentId);
 	theErrorFile << DeviceName(theConnections.device_p->name, theParentId, PRINT_CIRCUIT_ON) << " " << theConnections.device_p->parameters;
 	if ( myMFactor > 1 ) theErrorFile << " {m=" << myMFactor << "}";
@@ -607,7 +636,7 @@ string CCvcDb::PrintVoltage(voltage_t theVoltage, CPower * thePower_p) {
 	}
 }
 
-void CCvcDb::PrintAllTerminalConnections(terminal_t theTerminal, CFullConnection& theConnections, ogzstream& theErrorFile, bool theIncludeLeakVoltage) {
+void CCvcDb::PrintAllTerminalConnections(terminal_t theTerminal, CFullConnection& theConnections, ostream& theErrorFile, bool theIncludeLeakVoltage) {
 	netId_t myNetId, myMinNetId, mySimNetId, myMaxNetId;
 	string myMinVoltageString, mySimVoltageString, myMaxVoltageString;
 	string myMinLeakVoltageString = "", myMaxLeakVoltageString = "";
@@ -712,7 +741,7 @@ void CCvcDb::PrintAllTerminalConnections(terminal_t theTerminal, CFullConnection
 	theErrorFile << " Max: " << NetName(myMaxNetId) << NetVoltageSuffix(myMaxPowerDelimiter, myMaxVoltageString, myMaxResistance, myMaxLeakVoltageString) << endl;
 }
 
-void CCvcDb::PrintSimTerminalConnections(terminal_t theTerminal, CFullConnection& theConnections, ogzstream& theErrorFile) {
+void CCvcDb::PrintSimTerminalConnections(terminal_t theTerminal, CFullConnection& theConnections, ostream& theErrorFile) {
 	netId_t myNetId, mySimNetId;
 	string mySimVoltageString;
 	string mySimPowerDelimiter;
@@ -813,7 +842,7 @@ void CCvcDb::PrintShortedNets(string theShortFileName) {
 					logFile << "WARNING: possible missing input at net " << NetName(net_it);
 					logFile << NetVoltageSuffix(PowerDelimiter_(netVoltagePtr_v[mySimNet], SIM_CALCULATED_BIT),
 							PrintVoltage(netVoltagePtr_v[mySimNet]->simVoltage, netVoltagePtr_v[mySimNet]),
-							simNet_v[mySimNet].finalResistance) << endl;
+							simNet_v.FinalResistance(mySimNet)) << endl;
 				}
 			} else {
 				short_v[net_it].second = "@";
@@ -889,7 +918,7 @@ void CCvcDb::PrintClassSizes() {
 	cout << "CHierList " << sizeof(class CHierList) << endl;
 	cout << "CInstance " << sizeof(class CInstance) << endl;
 	cout << "CInstanceIdVector " << sizeof(class CInstanceIdVector) << endl;
-	cout << "CInstancePtrVector " << sizeof(class CInstancePtrVector) << endl;
+	cout << "CInstanceVector " << sizeof(class CInstanceVector) << endl;
 	cout << "CLeakList " << sizeof(class CLeakList) << endl;
 	cout << "CLeakMap " << sizeof(class CLeakMap) << endl;
 	cout << "CModel " << sizeof(class CModel) << endl;
@@ -898,7 +927,6 @@ void CCvcDb::PrintClassSizes() {
 	cout << "CModelListMap " << sizeof(class CModelListMap) << endl;
 	cout << "CNetIdVector " << sizeof(class CNetIdVector) << endl;
 	cout << "CNetList " << sizeof(class CNetList) << endl;
-	cout << "CNetMap " << sizeof(class CNetMap) << endl;
 	cout << "CNormalValue " << sizeof(class CNormalValue) << endl;
 	cout << "CParameterMap " << sizeof(class CParameterMap) << endl;
 	cout << "CPower " << sizeof(class CPower) << endl;
@@ -910,7 +938,6 @@ void CCvcDb::PrintClassSizes() {
 	cout << "CShortVector " << sizeof(class CShortVector) << endl;
 	cout << "CStatusVector " << sizeof(class CStatusVector) << endl;
 	cout << "CStringList " << sizeof(class CStringList) << endl;
-	cout << "CStringTextMap " << sizeof(class CStringTextMap) << endl;
 	cout << "CTextCircuitPtrMap " << sizeof(class CTextCircuitPtrMap) << endl;
 	cout << "CTextDeviceIdMap " << sizeof(class CTextDeviceIdMap) << endl;
 	cout << "CTextInstanceIdMap " << sizeof(class CTextInstanceIdMap) << endl;
@@ -922,7 +949,6 @@ void CCvcDb::PrintClassSizes() {
 //	cout << "CVirtualLeakNet " << sizeof(class CVirtualLeakNet) << endl;
 //	cout << "CVirtualLeakNetVector " << sizeof(class CVirtualLeakNetVector) << endl;
 	cout << "CVirtualNet " << sizeof(class CVirtualNet) << endl;
-	cout << "CVirtualNetMappedVector " << sizeof(class CVirtualNetMappedVector) << endl;
 	cout << "CVirtualNetVector " << sizeof(class CVirtualNetVector) << endl;
 }
 
@@ -934,21 +960,24 @@ void CCvcDb::PrintNetWithModelCounts(netId_t theNetId, int theTerminals) {
 		}
 	}
 	if ( theTerminals & GATE ) {
-		for ( deviceId_t device_it = firstGate_v[theNetId]; device_it != UNKNOWN_NET; device_it = nextGate_v[device_it]) {
+		for ( auto device_pit = gateAdjacency.begin(theNetId); device_pit != gateAdjacency.end(theNetId); device_pit++ ) {
+			deviceId_t device_it = *device_pit;
 			CInstance * myInstance_p = instancePtr_v[deviceParent_v[device_it]];
 			deviceId_t myDeviceOffset = device_it - myInstance_p->firstDeviceId;
 			myDeviceCount[myInstance_p->master_p->devicePtr_v[myDeviceOffset]->model_p->name]++;
 		}
 	}
 	if ( theTerminals & SOURCE ) {
-		for ( deviceId_t device_it = firstSource_v[theNetId]; device_it != UNKNOWN_NET; device_it = nextSource_v[device_it]) {
+		for ( auto device_pit = sourceAdjacency.begin(theNetId); device_pit != sourceAdjacency.end(theNetId); device_pit++ ) {
+			deviceId_t device_it = *device_pit;
 			CInstance * myInstance_p = instancePtr_v[deviceParent_v[device_it]];
 			deviceId_t myDeviceOffset = device_it - myInstance_p->firstDeviceId;
 			myDeviceCount[myInstance_p->master_p->devicePtr_v[myDeviceOffset]->model_p->name]++;
 		}
 	}
 	if ( theTerminals & DRAIN ) {
-		for ( deviceId_t device_it = firstDrain_v[theNetId]; device_it != UNKNOWN_NET; device_it = nextDrain_v[device_it]) {
+		for ( auto device_pit = drainAdjacency.begin(theNetId); device_pit != drainAdjacency.end(theNetId); device_pit++ ) {
+			deviceId_t device_it = *device_pit;
 			CInstance * myInstance_p = instancePtr_v[deviceParent_v[device_it]];
 			deviceId_t myDeviceOffset = device_it - myInstance_p->firstDeviceId;
 			myDeviceCount[myInstance_p->master_p->devicePtr_v[myDeviceOffset]->model_p->name]++;
@@ -968,9 +997,9 @@ void CCvcDb::PrintBackupNet(CVirtualNetVector& theVirtualNet_v, netId_t theNetId
 	theOutputFile << NetName(theNetId) << endl;
 	netId_t myNetId = GetEquivalentNet(theNetId);
 	if ( myNetId != theNetId ) cout << "=>" << NetName(myNetId) << endl;
-	while ( myNetId != theVirtualNet_v[myNetId].backupNetId ) {
-		theOutputFile << "->" << NetName(theVirtualNet_v[myNetId].backupNetId) << endl;
-		myNetId = theVirtualNet_v[myNetId].backupNetId;
+	while ( myNetId != theVirtualNet_v.BackupNetId(myNetId) ) {
+		theOutputFile << "->" << NetName(theVirtualNet_v.BackupNetId(myNetId)) << endl;
+		myNetId = theVirtualNet_v.BackupNetId(myNetId);
 	}
 	if ( leakVoltagePtr_v[myNetId].full ) leakVoltagePtr_v[myNetId].full->Print(theOutputFile);
 	theOutputFile << endl;
@@ -49,7 +49,7 @@
 
 voltage_t CCvcDb::MinVoltage(netId_t theNetId, bool theSkipHiZFlag) {
 	if ( theNetId != UNKNOWN_NET ) {
-		static CVirtualNet myVirtualNet;
+		CVirtualNet myVirtualNet;
 		assert(theNetId == GetEquivalentNet(theNetId));
 		myVirtualNet(minNet_v, theNetId);
 		if ( myVirtualNet.finalNetId != UNKNOWN_NET ) {
@@ -66,7 +66,7 @@ voltage_t CCvcDb::MinVoltage(netId_t theNetId, bool theSkipHiZFlag) {
 voltage_t CCvcDb::MinSimVoltage(netId_t theNetId) {
 	// limit min value to calculated sim value
 	if ( theNetId != UNKNOWN_NET ) {
-		static CVirtualNet myVirtualNet;
+		CVirtualNet myVirtualNet;
 		assert(theNetId == GetEquivalentNet(theNetId));
 		myVirtualNet(minNet_v, theNetId);
 		if ( myVirtualNet.finalNetId != UNKNOWN_NET ) {
@@ -88,7 +88,7 @@ voltage_t CCvcDb::MinSimVoltage(netId_t theNetId) {
 resistance_t CCvcDb::MinResistance(netId_t theNetId) {
 	// resistance to minimum master net
 	if ( theNetId != UNKNOWN_NET ) {
-		static CVirtualNet myVirtualNet;
+		CVirtualNet myVirtualNet;
 		assert(theNetId == GetEquivalentNet(theNetId));
 		myVirtualNet(minNet_v, theNetId);
 		if ( myVirtualNet.finalNetId != UNKNOWN_NET ) {
@@ -100,12 +100,12 @@ resistance_t CCvcDb::MinResistance(netId_t theNetId) {
 
 voltage_t CCvcDb::MinLeakVoltage(netId_t theNetId) {
 	if ( theNetId != UNKNOWN_NET && leakVoltageSet ) {
-		netId_t myNetId = minNet_v[theNetId].backupNetId;
+		netId_t myNetId = minNet_v.BackupNetId(theNetId);
 //		CVirtualNet myVirtualNet(minLeakNet_v, theNetId);
 		assert(theNetId == GetEquivalentNet(theNetId));
 		if ( myNetId != UNKNOWN_NET ) {
-			while ( myNetId != minNet_v[myNetId].backupNetId ) {
-				myNetId = minNet_v[myNetId].backupNetId;
+			while ( myNetId != minNet_v.BackupNetId(myNetId) ) {
+				myNetId = minNet_v.BackupNetId(myNetId);
 			}
 			if ( leakVoltagePtr_v[myNetId].full ) {
 				return leakVoltagePtr_v[myNetId].full->minVoltage;
@@ -117,7 +117,7 @@ voltage_t CCvcDb::MinLeakVoltage(netId_t theNetId) {
 
 voltage_t CCvcDb::SimVoltage(netId_t theNetId) {
 	if ( theNetId != UNKNOWN_NET ) {
-		static CVirtualNet myVirtualNet;
+		CVirtualNet myVirtualNet;
 		assert(theNetId == GetEquivalentNet(theNetId));
 		myVirtualNet(simNet_v, theNetId);
 		if ( myVirtualNet.finalNetId != UNKNOWN_NET ) {
@@ -132,10 +132,10 @@ voltage_t CCvcDb::SimVoltage(netId_t theNetId) {
 
 bool CCvcDb::IsAlwaysOnCandidate(deviceId_t theDeviceId, shortDirection_t theDirection) {
 	if ( theDeviceId == UNKNOWN_DEVICE ) return false;
-	static CVirtualNet myMinVirtualSourceNet;
-	static CVirtualNet myMinVirtualDrainNet;
-	static CVirtualNet myMaxVirtualSourceNet;
-	static CVirtualNet myMaxVirtualDrainNet;
+	CVirtualNet myMinVirtualSourceNet;
+	CVirtualNet myMinVirtualDrainNet;
+	CVirtualNet myMaxVirtualSourceNet;
+	CVirtualNet myMaxVirtualDrainNet;
 	netId_t mySourceNetId = GetEquivalentNet(sourceNet_v[theDeviceId]);
 	netId_t myDrainNetId = GetEquivalentNet(drainNet_v[theDeviceId]);
 	if ( theDirection == DRAIN_TO_MASTER_SOURCE && connectionCount_v[myDrainNetId].sourceDrainType != NMOS_PMOS ) return true;  // non-output devices are always true
@@ -195,7 +195,7 @@ bool CCvcDb::IsAlwaysOnCandidate(deviceId_t theDeviceId, shortDirection_t theDir
 resistance_t CCvcDb::SimResistance(netId_t theNetId) {
 //	resistance_t myResistance;
 	if ( theNetId != UNKNOWN_NET ) {
-		static CVirtualNet myVirtualNet;
+		CVirtualNet myVirtualNet;
 		assert(theNetId == GetEquivalentNet(theNetId));
 		myVirtualNet(simNet_v, theNetId);
 		return myVirtualNet.finalResistance;
@@ -205,7 +205,7 @@ resistance_t CCvcDb::SimResistance(netId_t theNetId) {
 
 voltage_t CCvcDb::MaxVoltage(netId_t theNetId, bool theSkipHiZFlag) {
 	if ( theNetId != UNKNOWN_NET ) {
-		static CVirtualNet myVirtualNet;
+		CVirtualNet myVirtualNet;
 		assert(theNetId == GetEquivalentNet(theNetId));
 		myVirtualNet(maxNet_v, theNetId);
 		if ( myVirtualNet.finalNetId != UNKNOWN_NET ) {
@@ -222,7 +222,7 @@ voltage_t CCvcDb::MaxVoltage(netId_t theNetId, bool theSkipHiZFlag) {
 voltage_t CCvcDb::MaxSimVoltage(netId_t theNetId) {
 	// limit max value to calculated sim value
 	if ( theNetId != UNKNOWN_NET ) {
-		static CVirtualNet myVirtualNet;
+		CVirtualNet myVirtualNet;
 		assert(theNetId == GetEquivalentNet(theNetId));
 		myVirtualNet(maxNet_v, theNetId);
 		if ( myVirtualNet.finalNetId != UNKNOWN_NET ) {
@@ -244,7 +244,7 @@ voltage_t CCvcDb::MaxSimVoltage(netId_t theNetId) {
 resistance_t CCvcDb::MaxResistance(netId_t theNetId) {
 	// resistance to maximum master net
 	if ( theNetId != UNKNOWN_NET ) {
-		static CVirtualNet myVirtualNet;
+		CVirtualNet myVirtualNet;
 		assert(theNetId == GetEquivalentNet(theNetId));
 		myVirtualNet(maxNet_v, theNetId);
 		if ( myVirtualNet.finalNetId != UNKNOWN_NET ) {
@@ -257,10 +257,10 @@ resistance_t CCvcDb::MaxResistance(netId_t theNetId) {
 voltage_t CCvcDb::MaxLeakVoltage(netId_t theNetId) {
 	if ( theNetId != UNKNOWN_NET && leakVoltageSet ) {
 		assert(theNetId == GetEquivalentNet(theNetId));
-		netId_t myNetId = maxNet_v[theNetId].backupNetId;
+		netId_t myNetId = maxNet_v.BackupNetId(theNetId);
 		if ( myNetId != UNKNOWN_NET ) {
-			while ( myNetId != maxNet_v[myNetId].backupNetId ) {
-				myNetId = maxNet_v[myNetId].backupNetId;
+			while ( myNetId != maxNet_v.BackupNetId(myNetId) ) {
+				myNetId = maxNet_v.BackupNetId(myNetId);
 			}
 			if ( leakVoltagePtr_v[myNetId].full ) {
 				return leakVoltagePtr_v[myNetId].full->maxVoltage;
@@ -270,22 +270,19 @@ voltage_t CCvcDb::MaxLeakVoltage(netId_t theNetId) {
 	return UNKNOWN_VOLTAGE;
 }
 
-// equivalency list is descending order loop; return node is greatest
-netId_t CCvcDb::GetGreatestEquivalentNet(netId_t theNetId) {
-	if ( theNetId == UNKNOWN_NET ) return UNKNOWN_NET;
-	while ( equivalentNet_v[theNetId] < theNetId ) {
+// union-find root with path halving. only valid before equivalent nets are fixed.
+netId_t CCvcDb::FindEquivalentRoot(netId_t theNetId) {
+	while ( equivalentNet_v[theNetId] != theNetId ) {
+		equivalentNet_v[theNetId] = equivalentNet_v[equivalentNet_v[theNetId]];
 		theNetId = equivalentNet_v[theNetId];
 	}
-	return equivalentNet_v[theNetId];
+	return theNetId;
 }
 
-// equivalency list is descending order loop; return node is least
 netId_t CCvcDb::GetLeastEquivalentNet(netId_t theNetId) {
 	if ( theNetId == UNKNOWN_NET ) return UNKNOWN_NET;
-	while ( equivalentNet_v[theNetId] < theNetId ) {
-		theNetId = equivalentNet_v[theNetId];
-	}
-	return theNetId;
+	if ( isFixedEquivalentNet ) return equivalentNet_v[theNetId];
+	return leastEquivalentNet_v[FindEquivalentRoot(theNetId)];
 }
 
 netId_t CCvcDb::GetEquivalentNet(netId_t theNetId) {
@@ -293,7 +290,13 @@ netId_t CCvcDb::GetEquivalentNet(netId_t theNetId) {
 	if ( isFixedEquivalentNet ) {
 		theNetId = equivalentNet_v[theNetId];
 	} else {
-		theNetId = GetLeastEquivalentNet(theNetId);
+		// power is only kept at the root while shorting
+		netId_t myRootNetId = FindEquivalentRoot(theNetId);
+		CPower * myPower_p = netVoltagePtr_v[myRootNetId].full;
+		if ( myPower_p && myPower_p->netId != UNKNOWN_NET ) {
+			return(myPower_p->netId);
+		}
+		return leastEquivalentNet_v[myRootNetId];
 	}
 	CPower * myPower_p = netVoltagePtr_v[theNetId].full;
 	if ( myPower_p && myPower_p->netId != UNKNOWN_NET ) {
@@ -457,7 +460,15 @@ void CCvcDb::MapDeviceSourceDrainNets(deviceId_t theDeviceId, CFullConnection& t
 	theConnections.resistance = parameterResistanceMap[theConnections.device_p->parameters];
 }
 
-void CCvcDb::MapDeviceNets(CInstance * theInstance_p, CDevice * theDevice_p, CFullConnection& theConnections) {
+void CCvcDb::MapDeviceNets(CInstance * theInstance_p, CDevice * theDevice_p, CFullConnection& theConnections, long * theAccessCount_p) {
+	// with theAccessCount_p, virtual nets must not have pending updates and the lookups are safe on multiple threads
+	auto myMapNet = [&] (CVirtualNet & theNet, CVirtualNetVector & theVirtualNet_v, netId_t theNetId) {
+		if ( theAccessCount_p ) {
+			theNet(theVirtualNet_v, theNetId, *theAccessCount_p);
+		} else {
+			theNet(theVirtualNet_v, theNetId);
+		}
+	};
 	theConnections.device_p = theDevice_p;
 	theConnections.deviceId = theInstance_p->firstDeviceId + theDevice_p->offset;
 	SetConnections_(theConnections, theConnections.deviceId);
@@ -493,10 +504,10 @@ void CCvcDb::MapDeviceNets(CInstance * theInstance_p, CDevice * theDevice_p, CFu
 			throw EUnknownModel();
 		}
 	}
-	theConnections.masterMaxSourceNet(maxNet_v, theConnections.sourceId);
-	theConnections.masterMaxGateNet(maxNet_v, theConnections.gateId);
-	theConnections.masterMaxDrainNet(maxNet_v, theConnections.drainId);
-	theConnections.masterMaxBulkNet(maxNet_v, theConnections.bulkId);
+	myMapNet(theConnections.masterMaxSourceNet, maxNet_v, theConnections.sourceId);
+	myMapNet(theConnections.masterMaxGateNet, maxNet_v, theConnections.gateId);
+	myMapNet(theConnections.masterMaxDrainNet, maxNet_v, theConnections.drainId);
+	myMapNet(theConnections.masterMaxBulkNet, maxNet_v, theConnections.bulkId);
 	theConnections.maxSourceVoltage = netVoltagePtr_v.MaxVoltage(theConnections.masterMaxSourceNet.finalNetId);
 	theConnections.maxGateVoltage = netVoltagePtr_v.MaxVoltage(theConnections.masterMaxGateNet.finalNetId);
 	theConnections.maxDrainVoltage = netVoltagePtr_v.MaxVoltage(theConnections.masterMaxDrainNet.finalNetId);
@@ -514,10 +525,10 @@ void CCvcDb::MapDeviceNets(CInstance * theInstance_p, CDevice * theDevice_p, CFu
 		theConnections.maxBulkPower_p = netVoltagePtr_v[theConnections.masterMaxBulkNet.finalNetId].full;
 	}
 
-	theConnections.masterMinSourceNet(minNet_v, theConnections.sourceId);
-	theConnections.masterMinGateNet(minNet_v, theConnections.gateId);
-	theConnections.masterMinDrainNet(minNet_v, theConnections.drainId);
-	theConnections.masterMinBulkNet(minNet_v, theConnections.bulkId);
+	myMapNet(theConnections.masterMinSourceNet, minNet_v, theConnections.sourceId);
+	myMapNet(theConnections.masterMinGateNet, minNet_v, theConnections.gateId);
+	myMapNet(theConnections.masterMinDrainNet, minNet_v, theConnections.drainId);
+	myMapNet(theConnections.masterMinBulkNet, minNet_v, theConnections.bulkId);
 	theConnections.minSourceVoltage = netVoltagePtr_v.MinVoltage(theConnections.masterMinSourceNet.finalNetId);
 	theConnections.minGateVoltage = netVoltagePtr_v.MinVoltage(theConnections.masterMinGateNet.finalNetId);
 	theConnections.minDrainVoltage = netVoltagePtr_v.MinVoltage(theConnections.masterMinDrainNet.finalNetId);
@@ -535,10 +546,10 @@ void CCvcDb::MapDeviceNets(CInstance * theInstance_p, CDevice * theDevice_p, CFu
 		theConnections.minBulkPower_p = netVoltagePtr_v[theConnections.masterMinBulkNet.finalNetId].full;
 	}
 
-	theConnections.masterSimSourceNet(simNet_v, theConnections.sourceId);
-	theConnections.masterSimGateNet(simNet_v, theConnections.gateId);
-	theConnections.masterSimDrainNet(simNet_v, theConnections.drainId);
-	theConnections.masterSimBulkNet(simNet_v, theConnections.bulkId);
+	myMapNet(theConnections.masterSimSourceNet, simNet_v, theConnections.sourceId);
+	myMapNet(theConnections.masterSimGateNet, simNet_v, theConnections.gateId);
+	myMapNet(theConnections.masterSimDrainNet, simNet_v, theConnections.drainId);
+	myMapNet(theConnections.masterSimBulkNet, simNet_v, theConnections.bulkId);
 	theConnections.simSourceVoltage = netVoltagePtr_v.SimVoltage(theConnections.masterSimSourceNet.finalNetId);
 	theConnections.simGateVoltage = netVoltagePtr_v.SimVoltage(theConnections.masterSimGateNet.finalNetId);
 	theConnections.simDrainVoltage = netVoltagePtr_v.SimVoltage(theConnections.masterSimDrainNet.finalNetId);
@@ -555,19 +566,19 @@ void CCvcDb::MapDeviceNets(CInstance * theInstance_p, CDevice * theDevice_p, CFu
 	} else {
 		theConnections.simBulkPower_p = netVoltagePtr_v[theConnections.masterSimBulkNet.finalNetId].full;
 	}
-	theConnections.resistance = parameterResistanceMap[theConnections.device_p->parameters];
+	if ( theAccessCount_p ) {  // find does not insert
+		auto myResistance_pit = parameterResistanceMap.find(theConnections.device_p->parameters);
+		theConnections.resistance = ( myResistance_pit == parameterResistanceMap.end() ) ? 0 : myResistance_pit->second;
+	} else {
+		theConnections.resistance = parameterResistanceMap[theConnections.device_p->parameters];
+	}
 }
 
 void CCvcDb::IgnoreDevice(deviceId_t theDeviceId) {
-	static CStatus myIgnoredDevice = 0;
-	if ( myIgnoredDevice == 0 ) {
-		myIgnoredDevice[MAX_INACTIVE] = true;
-		myIgnoredDevice[MAX_PENDING] = false;
-		myIgnoredDevice[MIN_INACTIVE] = true;
-		myIgnoredDevice[MIN_PENDING] = false;
-		myIgnoredDevice[SIM_INACTIVE] = true;
-		myIgnoredDevice[SIM_PENDING] = false;
-	}
+	CStatus myIgnoredDevice = 0;  // inactive and not pending in all queues
+	myIgnoredDevice[MAX_INACTIVE] = true;
+	myIgnoredDevice[MIN_INACTIVE] = true;
+	myIgnoredDevice[SIM_INACTIVE] = true;
 	deviceStatus_v[theDeviceId] = myIgnoredDevice;
 }
 
@@ -622,10 +633,12 @@ bool CCvcDb::PathCrosses(CVirtualNetVector& theSearchVector, netId_t theSearchNe
 }
 
 bool CCvcDb::HasActiveConnection(netId_t theNetId) {
-	for ( deviceId_t device_it = firstSource_v[theNetId]; device_it != UNKNOWN_DEVICE; device_it = nextSource_v[device_it] ) {
+	for ( auto device_pit = sourceAdjacency.begin(theNetId); device_pit != sourceAdjacency.end(theNetId); device_pit++ ) {
+		deviceId_t device_it = *device_pit;
 		if ( deviceStatus_v[device_it][SIM_INACTIVE] == false ) return true;
 	}
-	for ( deviceId_t device_it = firstDrain_v[theNetId]; device_it != UNKNOWN_DEVICE; device_it = nextDrain_v[device_it] ) {
+	for ( auto device_pit = drainAdjacency.begin(theNetId); device_pit != drainAdjacency.end(theNetId); device_pit++ ) {
+		deviceId_t device_it = *device_pit;
 		if ( deviceStatus_v[device_it][SIM_INACTIVE] == false ) return true;
 	}
 	return false;
@@ -635,7 +648,7 @@ voltage_t CCvcDb::DefaultMinVoltage(CPower * thePower_p) {
 	if ( thePower_p->defaultMinNet == UNKNOWN_NET ) {
 		return(UNKNOWN_VOLTAGE);
 	} else {
-		netId_t myMinNet = minNet_v[thePower_p->defaultMinNet].finalNetId;
+		netId_t myMinNet = minNet_v.FinalNetId(thePower_p->defaultMinNet);
 		CPower * myMinPower_p = netVoltagePtr_v[myMinNet].full;
 		if ( myMinPower_p && myMinPower_p->minVoltage != UNKNOWN_VOLTAGE ) {
 			return(myMinPower_p->minVoltage);
@@ -650,7 +663,7 @@ voltage_t CCvcDb::DefaultMaxVoltage(CPower * thePower_p) {
 	if ( thePower_p->defaultMaxNet == UNKNOWN_NET ) {
 		return(UNKNOWN_VOLTAGE);
 	} else {
-		netId_t myMaxNet = maxNet_v[thePower_p->defaultMaxNet].finalNetId;
+		netId_t myMaxNet = maxNet_v.FinalNetId(thePower_p->defaultMaxNet);
 		CPower * myMaxPower_p = netVoltagePtr_v[myMaxNet].full;
 		if ( myMaxPower_p && myMaxPower_p->maxVoltage != UNKNOWN_VOLTAGE ) {
 			return(myMaxPower_p->maxVoltage);
@@ -740,31 +753,28 @@ bool CCvcDb::HasLeakPath(CFullConnection & theConnections) {
 }
 
 size_t CCvcDb::IncrementDeviceError(deviceId_t theDeviceId, int theErrorIndex) {
-	CInstance * myInstance_p = instancePtr_v[deviceParent_v[theDeviceId]];
+	instanceId_t myParentId = deviceParent_v[theDeviceId];
+	CInstance * myInstance_p = instancePtr_v[myParentId];
 	CCircuit * myParent_p = myInstance_p->master_p;
+	deviceId_t myLocalDeviceId = theDeviceId - myInstance_p->firstDeviceId;
 	int myErrorSubIndex = 0;
 	if ( theErrorIndex >= OVERVOLTAGE_VBG && theErrorIndex <= MODEL_CHECK ) {
 		myErrorSubIndex = theErrorIndex - OVERVOLTAGE_VBG;
 	}
-	int myMFactor = CalculateMFactor(deviceParent_v[theDeviceId]);
-	size_t myReturnCount = myParent_p->devicePrintCount_v[theDeviceId - myInstance_p->firstDeviceId][myErrorSubIndex] + 1;
-	string myKey = "";
+	size_t myReturnCount = myParent_p->devicePrintCount_v[myLocalDeviceId][myErrorSubIndex] + 1;
 	deviceId_t myLimit = UNKNOWN_DEVICE;
-	if ( ! IsEmpty(cvcParameters.cvcCellErrorLimitFile) ) {
-		instanceId_t myAncestor = deviceParent_v[theDeviceId];
-		while ( myAncestor > 0 && instancePtr_v[myAncestor]->master_p->errorLimit == UNKNOWN_DEVICE ) {
-			myAncestor = instancePtr_v[myAncestor]->parentId;
-		}
+	if ( ! errorLimitAncestor_v.empty() ) {
+		instanceId_t myAncestor = errorLimitAncestor_v[myParentId];
 		if (myAncestor > 0) {
-			myLimit = instancePtr_v[myAncestor]->master_p->errorLimit;
+			CCircuit * myLimitCircuit_p = instancePtr_v[myAncestor]->master_p;
+			myLimit = myLimitCircuit_p->errorLimit;
 			if ( myLimit > 0 ) {
-				myKey = string(instancePtr_v[myAncestor]->master_p->name) + " " + string(myParent_p->name) + " "
-						+ to_string<deviceId_t>(theDeviceId - myInstance_p->firstDeviceId) + " " + to_string<int>(myErrorSubIndex);
-				cellErrorCountMap[myKey]++;
-				if ( cellErrorCountMap[myKey] > myLimit ) {
+				deviceId_t myCellErrorCount = ++cellErrorCountMap[
+					CellErrorKey_(myLimitCircuit_p->circuitId, myParent_p->firstCircuitDeviceId + myLocalDeviceId, myErrorSubIndex)];
+				if ( myCellErrorCount > myLimit ) {
 					myReturnCount = UNKNOWN_DEVICE;
 				} else {
-					myReturnCount = cellErrorCountMap[myKey];  // if limit is set, always print up to error limit
+					myReturnCount = myCellErrorCount;  // if limit is set, always print up to error limit
 				}
 			} else {  // no map entries needed if limit is 0
 				myReturnCount = UNKNOWN_DEVICE;
@@ -772,11 +782,12 @@ size_t CCvcDb::IncrementDeviceError(deviceId_t theDeviceId, int theErrorIndex) {
 		}
 	}
 	if ( myLimit > 0 ) {
-		myParent_p->deviceErrorCount_v[theDeviceId - myInstance_p->firstDeviceId][myErrorSubIndex] += myMFactor;
+		int myMFactor = CalculateMFactor(myParentId);
+		myParent_p->deviceErrorCount_v[myLocalDeviceId][myErrorSubIndex] += myMFactor;
 		errorCount[theErrorIndex] += myMFactor;
 	}
 	if ( myReturnCount < UNKNOWN_DEVICE ) {
-		myParent_p->devicePrintCount_v[theDeviceId - myInstance_p->firstDeviceId][myErrorSubIndex]++;
+		myParent_p->devicePrintCount_v[myLocalDeviceId][myErrorSubIndex]++;
 	}
 	return(myReturnCount);
 }
@@ -870,17 +881,19 @@ eventKey_t CCvcDb::SimKey(eventKey_t theCurrentKey, resistance_t theIncrement) {
 }
 
 bool CCvcDb::IsDerivedFromFloating(CVirtualNetVector& theVirtualNet_v, netId_t theNetId) {
-	static CVirtualNet	myVirtualNet;
+	CVirtualNet	myVirtualNet;
 	assert(theNetId == GetEquivalentNet(theNetId));
 	myVirtualNet(theVirtualNet_v, theNetId);
 	return( netVoltagePtr_v[myVirtualNet.finalNetId].full && netVoltagePtr_v[myVirtualNet.finalNetId].full->type[HIZ_BIT] );
 }
 
 bool CCvcDb::HasActiveConnections(netId_t theNetId) {
-	for ( deviceId_t device_it = firstSource_v[theNetId]; device_it != UNKNOWN_DEVICE; device_it = nextSource_v[device_it] ) {
+	for ( auto device_pit = sourceAdjacency.begin(theNetId); device_pit != sourceAdjacency.end(theNetId); device_pit++ ) {
+		deviceId_t device_it = *device_pit;
 		if ( ! deviceStatus_v[device_it][SIM_INACTIVE] ) return true;
 	}
-	for ( deviceId_t device_it = firstDrain_v[theNetId]; device_it != UNKNOWN_DEVICE; device_it = nextDrain_v[device_it] ) {
+	for ( auto device_pit = drainAdjacency.begin(theNetId); device_pit != drainAdjacency.end(theNetId); device_pit++ ) {
+		deviceId_t device_it = *device_pit;
 		if ( ! deviceStatus_v[device_it][SIM_INACTIVE] ) return true;
 	}
 	return false;
@@ -912,11 +925,11 @@ bool CCvcDb::IsSubcircuitOf(instanceId_t theInstanceId, instanceId_t theParentId
 
 void CCvcDb::RemoveInvalidPower(netId_t theNetId, size_t & theRemovedCount) {
 	if ( theNetId == UNKNOWN_NET || ! netVoltagePtr_v[theNetId].full ) return;
-	if ( minNet_v[theNetId].finalNetId > theNetId ) {
-		RemoveInvalidPower(minNet_v[theNetId].finalNetId, theRemovedCount);
+	if ( minNet_v.FinalNetId(theNetId) > theNetId ) {
+		RemoveInvalidPower(minNet_v.FinalNetId(theNetId), theRemovedCount);
 	}
-	if ( maxNet_v[theNetId].finalNetId > theNetId ) {
-		RemoveInvalidPower(maxNet_v[theNetId].finalNetId, theRemovedCount);
+	if ( maxNet_v.FinalNetId(theNetId) > theNetId ) {
+		RemoveInvalidPower(maxNet_v.FinalNetId(theNetId), theRemovedCount);
 	}
 	voltage_t myMaxVoltage = MaxVoltage(theNetId, true);
 	voltage_t myMinVoltage = MinVoltage(theNetId, true);
@@ -994,14 +1007,14 @@ void CCvcDb::RemoveInvalidPower(netId_t theNetId, size_t & theRemovedCount) {
 			if ( myPower_p->defaultMinNet != UNKNOWN_NET ) {
 				// do not increment lastUpdate
 				minNet_v.Set(theNetId, myPower_p->defaultMinNet, DEFAULT_UNKNOWN_RESISTANCE, minNet_v.lastUpdate);
-				CheckResistorOverflow_(minNet_v[theNetId].finalResistance, theNetId, logFile);
+				CheckResistorOverflow_(minNet_v.FinalResistance(theNetId), theNetId, logFile);
 			}
 		}
 		if ( myMaxVoltage == UNKNOWN_VOLTAGE ) {
 			if ( myPower_p->defaultMaxNet != UNKNOWN_NET ) {
 				// do not increment lastUpdate
 				maxNet_v.Set(theNetId, myPower_p->defaultMaxNet, DEFAULT_UNKNOWN_RESISTANCE, maxNet_v.lastUpdate);
-				CheckResistorOverflow_(maxNet_v[theNetId].finalResistance, theNetId, logFile);
+				CheckResistorOverflow_(maxNet_v.FinalResistance(theNetId), theNetId, logFile);
 			}
 		}
 		if ( ! leakVoltageSet || leakVoltagePtr_v[theNetId].full != myPower_p ) {  // delete unless leak voltage
@@ -1022,7 +1035,8 @@ calculationType_t CCvcDb::GetCalculationType(CPower * thePower_p, eventQueue_t t
 deviceId_t CCvcDb::GetSeriesConnectedDevice(deviceId_t theDeviceId, netId_t theNetId) {
 	modelType_t myDeviceType = deviceType_v[theDeviceId];
 	deviceId_t myReturnDevice = UNKNOWN_DEVICE;
-	for ( deviceId_t device_it = firstDrain_v[theNetId]; device_it != UNKNOWN_DEVICE; device_it = nextDrain_v[device_it] ) {
+	for ( auto device_pit = drainAdjacency.begin(theNetId); device_pit != drainAdjacency.end(theNetId); device_pit++ ) {
+		deviceId_t device_it = *device_pit;
 		switch ( deviceType_v[device_it] ) {
 		case SWITCH_OFF: case FUSE_OFF: case CAPACITOR: case DIODE: case BIPOLAR: {
 			break;
@@ -1035,7 +1049,8 @@ deviceId_t CCvcDb::GetSeriesConnectedDevice(deviceId_t theDeviceId, netId_t theN
 		}
 		}
 	}
-	for ( deviceId_t device_it = firstSource_v[theNetId]; device_it != UNKNOWN_DEVICE; device_it = nextSource_v[device_it] ) {
+	for ( auto device_pit = sourceAdjacency.begin(theNetId); device_pit != sourceAdjacency.end(theNetId); device_pit++ ) {
+		deviceId_t device_it = *device_pit;
 		switch ( deviceType_v[device_it] ) {
 		case SWITCH_OFF: case FUSE_OFF: case CAPACITOR: case DIODE: case BIPOLAR: {
 			break;
@@ -1055,6 +1070,7 @@ void CCvcDb::Cleanup() {
 	if ( logFile.is_open() ) logFile.close();
 	if ( errorFile.is_open() ) errorFile.close();
 	if ( debugFile.is_open() ) debugFile.close();
+	errorDatabase.Close();
 	RemoveLock();
 #ifdef CVC_MEMORY_DEBUG
 	try {
@@ -1113,8 +1129,8 @@ bool CCvcDb::IsAnalogNet(netId_t theNetId) {
 	CPower * myMinNet_p = netVoltagePtr_v[myMinNet.finalNetId].full;
 	CPower * myMaxNet_p = netVoltagePtr_v[myMaxNet.finalNetId].full;
 	bool myIsAnalogNet = ( myMinNet_p && myMinNet_p->type[ANALOG_BIT] ) || ( myMaxNet_p && myMaxNet_p->type[ANALOG_BIT] );
-	deviceId_t device_it = firstSource_v[theNetId];
-	while ( ! myIsAnalogNet && device_it != UNKNOWN_DEVICE ) {
+	for ( auto device_pit = sourceAdjacency.begin(theNetId); ! myIsAnalogNet && device_pit != sourceAdjacency.end(theNetId); device_pit++ ) {
+		deviceId_t device_it = *device_pit;
 		if ( GetEquivalentNet(drainNet_v[device_it]) != theNetId ) {
 			switch( deviceType_v[device_it] ) {
 			case NMOS: case LDDN: case PMOS: case LDDP: {
@@ -1125,10 +1141,9 @@ bool CCvcDb::IsAnalogNet(netId_t theNetId) {
 			default: break;
 			}
 		}
-		device_it = nextSource_v[device_it];
 	}
-	device_it = firstDrain_v[theNetId];
-	while ( ! myIsAnalogNet && device_it != UNKNOWN_DEVICE ) {
+	for ( auto device_pit = drainAdjacency.begin(theNetId); ! myIsAnalogNet && device_pit != drainAdjacency.end(theNetId); device_pit++ ) {
+		deviceId_t device_it = *device_pit;
 		if ( GetEquivalentNet(sourceNet_v[device_it]) != theNetId ) {
 			switch( deviceType_v[device_it] ) {
 			case NMOS: case LDDN: case PMOS: case LDDP: {
@@ -1139,7 +1154,6 @@ bool CCvcDb::IsAnalogNet(netId_t theNetId) {
 			default: break;
 			}
 		}
-		device_it = nextDrain_v[device_it];
 	}
 	return (myIsAnalogNet);
 }
@@ -1195,23 +1209,23 @@ bool CCvcDb::IsOneConnectionNet(netId_t theNetId) {
 	// WARNING: Doesn't count bulk connections.
 	netId_t myNetId = GetEquivalentNet(theNetId);
 	deviceId_t myDevice;
-	if ( firstGate_v[myNetId] != UNKNOWN_DEVICE ) {
-		myDevice = firstGate_v[myNetId];
-	} else if ( firstSource_v[myNetId] != UNKNOWN_DEVICE ) {
-		myDevice = firstSource_v[myNetId];
-	} else if ( firstDrain_v[myNetId] != UNKNOWN_DEVICE ) {
-		myDevice = firstDrain_v[myNetId];
+	if ( gateAdjacency.Count(myNetId) > 0 ) {
+		myDevice = gateAdjacency.First(myNetId);
+	} else if ( sourceAdjacency.Count(myNetId) > 0 ) {
+		myDevice = sourceAdjacency.First(myNetId);
+	} else if ( drainAdjacency.Count(myNetId) > 0 ) {
+		myDevice = drainAdjacency.First(myNetId);
 	} else {
 		return true;  // nets not connected to any devices are also 'one connection', i.e. no leak.
 	}
-	if ( firstGate_v[myNetId] != UNKNOWN_DEVICE ) {
-		if ( firstGate_v[myNetId] != myDevice || nextGate_v[myDevice] != UNKNOWN_DEVICE ) return false;
+	if ( gateAdjacency.Count(myNetId) > 0 ) {
+		if ( gateAdjacency.First(myNetId) != myDevice || gateAdjacency.Count(myNetId) > 1 ) return false;
 	}
-	if ( firstSource_v[myNetId] != UNKNOWN_DEVICE ) {
-		if ( firstSource_v[myNetId] != myDevice || nextSource_v[myDevice] != UNKNOWN_DEVICE ) return false;
+	if ( sourceAdjacency.Count(myNetId) > 0 ) {
+		if ( sourceAdjacency.First(myNetId) != myDevice || sourceAdjacency.Count(myNetId) > 1 ) return false;
 	}
-	if ( firstDrain_v[myNetId] != UNKNOWN_DEVICE ) {
-		if ( firstDrain_v[myNetId] != myDevice || nextDrain_v[myDevice] != UNKNOWN_DEVICE ) return false;
+	if ( drainAdjacency.Count(myNetId) > 0 ) {
+		if ( drainAdjacency.First(myNetId) != myDevice || drainAdjacency.Count(myNetId) > 1 ) return false;
 	}
 	return true;
 }
@@ -1481,10 +1495,9 @@ deviceId_t CCvcDb::GetAttachedDevice(netId_t theNetId, modelType_t theType, term
 	/// Return the first non-shorted device of type theType with terminal theTerminal connected to theNetId
 	assert(GetEquivalentNet(theNetId) == theNetId);
 
-	deviceId_t device_it;
 	if ( theTerminal & GATE ) {
-		device_it = firstGate_v[theNetId];
-		while ( device_it != UNKNOWN_DEVICE ) {
+		for ( auto device_pit = gateAdjacency.begin(theNetId); device_pit != gateAdjacency.end(theNetId); device_pit++ ) {
+			deviceId_t device_it = *device_pit;
 			if ( sourceNet_v[device_it] != drainNet_v[device_it] ) {
 				if ( theType == NMOS && IsNmos_(deviceType_v[device_it]) ) return device_it;
 
@@ -1493,12 +1506,11 @@ deviceId_t CCvcDb::GetAttachedDevice(netId_t theNetId, modelType_t theType, term
 				if ( theType == deviceType_v[device_it] ) return device_it;
 
 			}
-			device_it = nextGate_v[device_it];
 		}
 	}
 	if ( theTerminal & SOURCE ) {
-		device_it = firstSource_v[theNetId];
-		while ( device_it != UNKNOWN_DEVICE ) {
+		for ( auto device_pit = sourceAdjacency.begin(theNetId); device_pit != sourceAdjacency.end(theNetId); device_pit++ ) {
+			deviceId_t device_it = *device_pit;
 			if ( sourceNet_v[device_it] != drainNet_v[device_it] ) {
 				if ( theType == NMOS && IsNmos_(deviceType_v[device_it]) ) return device_it;
 
@@ -1507,12 +1519,11 @@ deviceId_t CCvcDb::GetAttachedDevice(netId_t theNetId, modelType_t theType, term
 				if ( theType == deviceType_v[device_it] ) return device_it;
 
 			}
-			device_it = nextSource_v[device_it];
 		}
 	}
 	if ( theTerminal & DRAIN ) {
-		device_it = firstDrain_v[theNetId];
-		while ( device_it != UNKNOWN_DEVICE ) {
+		for ( auto device_pit = drainAdjacency.begin(theNetId); device_pit != drainAdjacency.end(theNetId); device_pit++ ) {
+			deviceId_t device_it = *device_pit;
 			if ( sourceNet_v[device_it] != drainNet_v[device_it] ) {
 				if ( theType == NMOS && IsNmos_(deviceType_v[device_it]) ) return device_it;
 
@@ -1521,7 +1532,6 @@ deviceId_t CCvcDb::GetAttachedDevice(netId_t theNetId, modelType_t theType, term
 				if ( theType == deviceType_v[device_it] ) return device_it;
 
 			}
-			device_it = nextDrain_v[device_it];
 		}
 	}
 	return (UNKNOWN_DEVICE);
@@ -1532,8 +1542,8 @@ deviceId_t CCvcDb::FindInverterDevice(netId_t theInputNet, netId_t theOutputNet,
 	///
 	/// Note: Will not find any device if inverter contains both nmos/pmos clamps
 	unordered_set<deviceId_t> myDeviceList;
-	deviceId_t device_it = firstSource_v[theOutputNet];
-	while ( device_it != UNKNOWN_DEVICE ) {
+	for ( auto device_pit = sourceAdjacency.begin(theOutputNet); device_pit != sourceAdjacency.end(theOutputNet); device_pit++ ) {
+		deviceId_t device_it = *device_pit;
 		if ( sourceNet_v[device_it] != drainNet_v[device_it] ) {
 			if ( theType == NMOS && IsNmos_(deviceType_v[device_it] ) ) {
 				myDeviceList.insert(device_it);
@@ -1541,10 +1551,9 @@ deviceId_t CCvcDb::FindInverterDevice(netId_t theInputNet, netId_t theOutputNet,
 				myDeviceList.insert(device_it);
 			}
 		}
-		device_it = nextSource_v[device_it];
 	}
-	device_it = firstDrain_v[theOutputNet];
-	while ( device_it != UNKNOWN_DEVICE ) {
+	for ( auto device_pit = drainAdjacency.begin(theOutputNet); device_pit != drainAdjacency.end(theOutputNet); device_pit++ ) {
+		deviceId_t device_it = *device_pit;
 		if ( sourceNet_v[device_it] != drainNet_v[device_it] ) {
 			if ( theType == NMOS && IsNmos_(deviceType_v[device_it] ) ) {
 				myDeviceList.insert(device_it);
@@ -1552,26 +1561,24 @@ deviceId_t CCvcDb::FindInverterDevice(netId_t theInputNet, netId_t theOutputNet,
 				myDeviceList.insert(device_it);
 			}
 		}
-		device_it = nextDrain_v[device_it];
 	}
-	device_it = firstGate_v[theInputNet];
-	while ( device_it != UNKNOWN_DEVICE ) {
+	for ( auto device_pit = gateAdjacency.begin(theInputNet); device_pit != gateAdjacency.end(theInputNet); device_pit++ ) {
+		deviceId_t device_it = *device_pit;
 		if ( myDeviceList.count(device_it) > 0 ) return device_it;
-
-		device_it = nextGate_v[device_it];
 	}
 	return(UNKNOWN_DEVICE);
 }
 
 returnCode_t CCvcDb::FindUniqueMosInputs(netId_t theOutputNet, netId_t theGroundNet, netId_t thePowerNet,
-		CDeviceIdVector &theFirst_v, CDeviceIdVector &theNext_v, CNetIdVector &theSourceNet_v, CNetIdVector &theDrainNet_v,
+		CDeviceIdAdjacency &theAdjacency, CNetIdVector &theSourceNet_v, CNetIdVector &theDrainNet_v,
 		netId_t &theNmosInput, netId_t &thePmosInput) {
 	/// Return the mos gates for devices with source connected to theOutputNet
 	///
 	/// Modifies theNmosInput, thePmosInput
 	CPower * myGround_p = netVoltagePtr_v[theGroundNet].full;
 	CPower * myPower_p = netVoltagePtr_v[thePowerNet].full;
-	for ( deviceId_t device_it = theFirst_v[theOutputNet]; device_it != UNKNOWN_DEVICE; device_it = theNext_v[device_it] ) {
+	for ( auto device_pit = theAdjacency.begin(theOutputNet); device_pit != theAdjacency.end(theOutputNet); device_pit++ ) {
+		deviceId_t device_it = *device_pit;
 		if ( theSourceNet_v[device_it] == theDrainNet_v[device_it] ) continue;  // ignore inactive devices
 
 		if ( IsNmos_(deviceType_v[device_it]) ) {
@@ -1635,9 +1642,9 @@ netId_t CCvcDb::FindInverterInput(netId_t theOutputNet) {
 		return(UNKNOWN_NET);
 
 	}
-	returnCode_t mySourceCheck = FindUniqueMosInputs(theOutputNet, myGroundNet, myPowerNet, firstSource_v, nextSource_v, sourceNet_v, drainNet_v,
+	returnCode_t mySourceCheck = FindUniqueMosInputs(theOutputNet, myGroundNet, myPowerNet, sourceAdjacency, sourceNet_v, drainNet_v,
 			myNmosInput, myPmosInput);
-	returnCode_t myDrainCheck = FindUniqueMosInputs(theOutputNet, myGroundNet, myPowerNet, firstDrain_v, nextDrain_v, drainNet_v, sourceNet_v,
+	returnCode_t myDrainCheck = FindUniqueMosInputs(theOutputNet, myGroundNet, myPowerNet, drainAdjacency, drainNet_v, sourceNet_v,
 			myNmosInput, myPmosInput);
 	return( ( mySourceCheck == OK && myDrainCheck == OK
 			&& myNmosInput != UNKNOWN_NET && myNmosInput == myPmosInput ) ? myNmosInput : UNKNOWN_NET);
@@ -1665,7 +1672,8 @@ netId_t CCvcDb::OppositeNet(deviceId_t theDevice, netId_t theNet) {
 deviceId_t CCvcDb::GetNextInSeries(deviceId_t theDevice, netId_t theNet) {
 	// Return the next device in series
 	deviceId_t myNextDevice = UNKNOWN_DEVICE;
-	for ( deviceId_t device_it = firstSource_v[theNet]; device_it != UNKNOWN_DEVICE; device_it = nextSource_v[device_it] ) {
+	for ( auto device_pit = sourceAdjacency.begin(theNet); device_pit != sourceAdjacency.end(theNet); device_pit++ ) {
+		deviceId_t device_it = *device_pit;
 		if ( sourceNet_v[device_it] != drainNet_v[device_it] ) continue;  // ignore inactive devices
 
 		if ( device_it == theDevice ) continue;  // looking for device connected to this one
@@ -1674,7 +1682,8 @@ deviceId_t CCvcDb::GetNextInSeries(deviceId_t theDevice, netId_t theNet) {
 
 		myNextDevice = device_it;
 	}
-	for ( deviceId_t device_it = firstDrain_v[theNet]; device_it != UNKNOWN_DEVICE; device_it = nextDrain_v[device_it] ) {
+	for ( auto device_pit = drainAdjacency.begin(theNet); device_pit != drainAdjacency.end(theNet); device_pit++ ) {
+		deviceId_t device_it = *device_pit;
 		if ( sourceNet_v[device_it] != drainNet_v[device_it] ) continue;  // ignore inactive devices
 
 		if ( device_it == theDevice ) continue;  // looking for device connected to this one
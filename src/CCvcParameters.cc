@@ -109,6 +109,18 @@ void CCvcParameters::ResetEnvironment() {
 	//! Name of file containing list of net checks
 	cvcModelCheckFile = defaultModelCheckFile;
 	//! Name of file containing list of model checks
+	cvcNetlistCacheFile = defaultNetlistCacheFile;
+	//! Name of binary netlist cache. If the cache matches the netlist, CDL parsing is skipped. Default is no cache.
+	cvcNetlistParseJobs = defaultNetlistParseJobs;
+	//! Number of processes used to parse uncompressed netlists. Default is 1 (serial parse).
+	cvcThreadCount = defaultThreadCount;
+	//! Number of threads used for database expansion and checks. Default is 1 (single thread).
+	cvcScratchDirectory = defaultScratchDirectory;
+	//! Directory for file backed copies of large net and device arrays. Default is no scratch files (all in memory).
+	cvcPowerStateFile = defaultPowerStateFile;
+	//! File of power definitions from the last run. Power changes since that run are reported. Default is no state file.
+	cvcErrorDatabase = defaultErrorDatabase;
+	//! Also write device errors to an indexed binary file, <report>.error.db. Default is text only.
 }
 
 void CCvcParameters::PrintEnvironment(ostream & theOutputFile) {
@@ -149,6 +161,12 @@ void CCvcParameters::PrintEnvironment(ostream & theOutputFile) {
 	theOutputFile << "CVC_LARGE_CIRCUIT_SIZE = '" << cvcLargeCircuitSize << "'" << endl;
 	theOutputFile << "CVC_NET_CHECK_FILE = '" << cvcNetCheckFile << "'" << endl;
 	theOutputFile << "CVC_MODEL_CHECK_FILE = '" << cvcModelCheckFile << "'" << endl;
+	theOutputFile << "CVC_NETLIST_CACHE_FILE = '" << cvcNetlistCacheFile << "'" << endl;
+	theOutputFile << "CVC_NETLIST_PARSE_JOBS = '" << cvcNetlistParseJobs << "'" << endl;
+	theOutputFile << "CVC_THREAD_COUNT = '" << cvcThreadCount << "'" << endl;
+	theOutputFile << "CVC_SCRATCH_DIRECTORY = '" << cvcScratchDirectory << "'" << endl;
+	theOutputFile << "CVC_POWER_STATE_FILE = '" << cvcPowerStateFile << "'" << endl;
+	theOutputFile << "CVC_ERROR_DATABASE = '" << (( cvcErrorDatabase ) ? "true" : "false") << "'" << endl;
 	theOutputFile << "End of parameters" << endl << endl;
 }
 
@@ -196,6 +214,12 @@ void CCvcParameters::PrintDefaultEnvironment() {
 	myDefaultCvcrc << "CVC_LARGE_CIRCUIT_SIZE = '" << cvcLargeCircuitSize << "'" << endl;
 	myDefaultCvcrc << "CVC_NET_CHECK_FILE = '" << cvcNetCheckFile << "'" << endl;
 	myDefaultCvcrc << "CVC_MODEL_CHECK_FILE = '" << cvcModelCheckFile << "'" << endl;
+	myDefaultCvcrc << "CVC_NETLIST_CACHE_FILE = '" << cvcNetlistCacheFile << "'" << endl;
+	myDefaultCvcrc << "CVC_NETLIST_PARSE_JOBS = '" << cvcNetlistParseJobs << "'" << endl;
+	myDefaultCvcrc << "CVC_THREAD_COUNT = '" << cvcThreadCount << "'" << endl;
+	myDefaultCvcrc << "CVC_SCRATCH_DIRECTORY = '" << cvcScratchDirectory << "'" << endl;
+	myDefaultCvcrc << "CVC_POWER_STATE_FILE = '" << cvcPowerStateFile << "'" << endl;
+	myDefaultCvcrc << "CVC_ERROR_DATABASE = '" << (( cvcErrorDatabase ) ? "true" : "false") << "'" << endl;
 	myDefaultCvcrc.close();
 }
 
@@ -311,6 +335,18 @@ void CCvcParameters::LoadEnvironment(const string theEnvironmentFilename, const
 			cvcNetCheckFile = myBuffer;
 		} else if ( myVariable == "CVC_MODEL_CHECK_FILE" ) {
 			cvcModelCheckFile = myBuffer;
+		} else if ( myVariable == "CVC_NETLIST_CACHE_FILE" ) {
+			cvcNetlistCacheFile = myBuffer;
+		} else if ( myVariable == "CVC_NETLIST_PARSE_JOBS" ) {
+			cvcNetlistParseJobs = max(from_string<size_t>(myBuffer), size_t(1));
+		} else if ( myVariable == "CVC_THREAD_COUNT" ) {
+			cvcThreadCount = max(from_string<size_t>(myBuffer), size_t(1));
+		} else if ( myVariable == "CVC_SCRATCH_DIRECTORY" ) {
+			cvcScratchDirectory = myBuffer;
+		} else if ( myVariable == "CVC_POWER_STATE_FILE" ) {
+			cvcPowerStateFile = myBuffer;
+		} else if ( myVariable == "CVC_ERROR_DATABASE" ) {
+			cvcErrorDatabase = strcasecmp(myBuffer, "true") == 0;
 		}
 	}
 	if ( ! IsEmpty(theReportPrefix) ) {
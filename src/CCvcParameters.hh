@@ -58,6 +58,12 @@ public:
 	const size_t defaultLargeCircuitSize = 10e6;
 	const string defaultNetCheckFile = "";
 	const string defaultModelCheckFile = "";
+	const string defaultNetlistCacheFile = "";
+	const size_t defaultNetlistParseJobs = 1;
+	const size_t defaultThreadCount = 1;
+	const string defaultScratchDirectory = "";
+	const string defaultPowerStateFile = "";
+	const bool defaultErrorDatabase = false;
 
 	string	cvcReportTitle;
 
@@ -109,6 +115,12 @@ public:
 	size_t	cvcLargeCircuitSize = defaultLargeCircuitSize;
 	string  cvcNetCheckFile = defaultNetCheckFile;
 	string  cvcModelCheckFile = defaultModelCheckFile;
+	string  cvcNetlistCacheFile = defaultNetlistCacheFile;
+	size_t	cvcNetlistParseJobs = defaultNetlistParseJobs;
+	size_t	cvcThreadCount = defaultThreadCount;
+	string	cvcScratchDirectory = defaultScratchDirectory;
+	string	cvcPowerStateFile = defaultPowerStateFile;
+	bool	cvcErrorDatabase = defaultErrorDatabase;
 
 	string	cvcLastTopBlock;
 	string	cvcLastNetlistFilename;
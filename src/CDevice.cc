@@ -107,49 +107,66 @@ void CDevicePtrVector::Print(CTextVector& theSignalName_v, CCircuit * theParent_
 	}
 }
 
-#define A_PRIME 0xcc9e2d51
-
-instanceId_t CDevice::MakePortHash(CNetIdVector & theLocalToGlobalNetId_v) {
-	instanceId_t myHash = 0;
-	for ( netId_t port_it = 0; port_it < master_p->portCount; port_it++ ) {
-		myHash = myHash << 16 ^ theLocalToGlobalNetId_v[signalId_v[port_it]] ^ myHash;
-		myHash *= A_PRIME;
+uint64_t CDevice::MakePortHash(const netId_t * thePortNetId_p, netId_t thePortCount) {
+	// 64 bit port signature. Each net is mixed with its position, so permuted ports give different signatures.
+	uint64_t myHash = 0x9e3779b97f4a7c15ULL ^ thePortCount;
+	for ( netId_t port_it = 0; port_it < thePortCount; port_it++ ) {
+		myHash = (myHash ^ thePortNetId_p[port_it]) * 0xff51afd7ed558ccdULL;
+		myHash ^= myHash >> 32;
 	}
-	return ( myHash % master_p->instanceCount );
+	myHash ^= myHash >> 33;
+	myHash *= 0xc4ceb9fe1a85ec53ULL;
+	myHash ^= myHash >> 33;
+	return ( myHash );
 }
 
 extern int gHashCollisionCount;
 extern int gMaxHashLength;
 
-instanceId_t CDevice::FindParallelInstance(CCvcDb * theCvcDb_p, instanceId_t theInstanceId, CNetIdVector & theLocalToGlobalNetId_v) {
-	// Executed once and only once for each instance
-	instanceId_t myKey = MakePortHash(theLocalToGlobalNetId_v);
-	assert(myKey != UNKNOWN_DEVICE && myKey < master_p->instanceCount );
-	if ( master_p->instanceHashId_v[myKey] == UNKNOWN_DEVICE ) {
-		master_p->instanceHashId_v[myKey] = theInstanceId;
-	} else {
-		instanceId_t myCheckInstanceId = master_p->instanceHashId_v[myKey];
-		CInstance * myInstance_p;
-		int myHashLength = 0;
-		do {
-			myInstance_p = theCvcDb_p->instancePtr_v[myCheckInstanceId];
-			if ( master_p != myInstance_p->master_p ) {
-				cout << "DEBUG: master mismatch at instance " << theInstanceId << " and " << myCheckInstanceId << endl;
-				cout << "  " << master_p->name << " != " << myInstance_p->master_p->name << endl;
-			}
-			for ( netId_t port_it = 0; port_it <= master_p->portCount; port_it++ ) {
-				if ( port_it == master_p->portCount ) {  // all ports match
-					return (myCheckInstanceId);
-				} else {
-					if (theLocalToGlobalNetId_v[signalId_v[port_it]] != myInstance_p->localToGlobalNetId_v[port_it]) break;
-				}
+instanceId_t CDevice::FindParallelInstance(CCvcDb * theCvcDb_p, instanceId_t theInstanceId, CNetIdVector & thePortNetId_v) {
+	// Executed once and only once for each instance. thePortNetId_v contains the global net ids of this instance's ports.
+	// Returns the first instance with the same port nets, or theInstanceId if there is none.
+	CParallelInstanceTable & myTable = master_p->parallelInstanceTable;
+	if ( (myTable.entries + 1) * 2 > myTable.slot_v.size() ) GrowParallelInstanceTable(theCvcDb_p);  // keep load below 50%
+	uint64_t myHash = MakePortHash(thePortNetId_v.data(), master_p->portCount);
+	uint32_t myTag = myHash >> 32;
+	size_t myMask = myTable.slot_v.size() - 1;
+	size_t mySlot = myHash & myMask;
+	int myHashLength = 0;
+	while ( myTable.slot_v[mySlot].instanceId != UNKNOWN_INSTANCE ) {
+		CParallelInstanceSlot & myCheckSlot = myTable.slot_v[mySlot];
+		if ( myCheckSlot.tag == myTag ) {
+			CInstance * myInstance_p = theCvcDb_p->instancePtr_v[myCheckSlot.instanceId];
+			if ( equal(thePortNetId_v.begin(), thePortNetId_v.end(), myInstance_p->localToGlobalNetId_v.begin()) ) {  // all ports match
+				if ( gMaxHashLength < myHashLength ) gMaxHashLength = myHashLength;
+				return (myCheckSlot.instanceId);
 			}
-			myHashLength++;
-			gHashCollisionCount++;
-			myCheckInstanceId = myInstance_p->nextHashedInstanceId;
-		} while ( myCheckInstanceId != UNKNOWN_DEVICE );
-		if ( gMaxHashLength < myHashLength ) gMaxHashLength = myHashLength;
-		myInstance_p->nextHashedInstanceId = theInstanceId;
+		}
+		myHashLength++;
+		gHashCollisionCount++;
+		mySlot = (mySlot + 1) & myMask;
 	}
+	if ( gMaxHashLength < myHashLength ) gMaxHashLength = myHashLength;
+	myTable.slot_v[mySlot].tag = myTag;
+	myTable.slot_v[mySlot].instanceId = theInstanceId;
+	myTable.entries++;
 	return (theInstanceId);
 }
+
+void CDevice::GrowParallelInstanceTable(CCvcDb * theCvcDb_p) {
+	// Signatures are recalculated from the ports of the kept instances.
+	CParallelInstanceTable & myTable = master_p->parallelInstanceTable;
+	vector<CParallelInstanceSlot> myOldSlot_v;
+	myOldSlot_v.swap(myTable.slot_v);
+	myTable.slot_v.resize(max(size_t(16), myOldSlot_v.size() * 2));
+	size_t myMask = myTable.slot_v.size() - 1;
+	for ( auto slot_pit = myOldSlot_v.begin(); slot_pit != myOldSlot_v.end(); slot_pit++ ) {
+		if ( slot_pit->instanceId == UNKNOWN_INSTANCE ) continue;
+		uint64_t myHash = MakePortHash(theCvcDb_p->instancePtr_v[slot_pit->instanceId]->localToGlobalNetId_v.begin(), master_p->portCount);
+		size_t mySlot = myHash & myMask;
+		while ( myTable.slot_v[mySlot].instanceId != UNKNOWN_INSTANCE ) {
+			mySlot = (mySlot + 1) & myMask;
+		}
+		myTable.slot_v[mySlot] = *slot_pit;
+	}
+}
@@ -69,8 +69,9 @@ public:
 	void Print(CTextVector& theSignalName_v, deviceId_t theDeviceId,
 			const string theIndentation = "");
  
-	instanceId_t MakePortHash(CNetIdVector & theLocalToGlobalNetId_v);
-	instanceId_t FindParallelInstance(CCvcDb * theCCvcDb_p, instanceId_t theInstanceId, CNetIdVector & theLocalToGlobalNetId_v);
+	static uint64_t MakePortHash(const netId_t * thePortNetId_p, netId_t thePortCount);
+	instanceId_t FindParallelInstance(CCvcDb * theCCvcDb_p, instanceId_t theInstanceId, CNetIdVector & thePortNetId_v);
+	void GrowParallelInstanceTable(CCvcDb * theCvcDb_p);
 };
 
 class CDevicePtrList : public list<CDevice *> {
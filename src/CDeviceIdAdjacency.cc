@@ -0,0 +1,82 @@
+/*
+ * CDeviceIdAdjacency.cc
+ *
+ * Copyright 2014-2026 D. Mitch Bailey  cvc at shuharisystem dot com
+ *
+ * This file is part of cvc.
+ *
+ * cvc is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cvc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with cvc.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * You can download cvc from https://github.com/d-m-bailey/cvc.git
+ */
+
+#include "CDeviceIdAdjacency.hh"
+
+#include <atomic>
+#include <functional>
+#include <thread>
+
+#define NET_BLOCK_SIZE 4096
+
+static void RunNetBlocks(netId_t theNetCount, size_t theThreadCount, function<void(netId_t, netId_t)> theFunction) {
+	// Each thread takes the next block of nets until all nets are processed.
+	atomic<size_t> myNextNet(0);
+	auto myRunBlocks = [&] () {
+		size_t myFirstNet;
+		while ( (myFirstNet = myNextNet.fetch_add(NET_BLOCK_SIZE)) < theNetCount ) {
+			theFunction(myFirstNet, min(myFirstNet + NET_BLOCK_SIZE, size_t(theNetCount)));
+		}
+	};
+	size_t myThreadCount = min(theThreadCount, theNetCount / NET_BLOCK_SIZE + 1);
+	vector<thread> myThread_v;
+	for ( size_t thread_it = 1; thread_it < myThreadCount; thread_it++ ) {
+		myThread_v.push_back(thread(myRunBlocks));
+	}
+	myRunBlocks();
+	for ( auto thread_pit = myThread_v.begin(); thread_pit != myThread_v.end(); thread_pit++ ) {
+		thread_pit->join();
+	}
+}
+
+void CDeviceIdAdjacency::Build(CDeviceIdVector & theFirstDevice_v, CDeviceIdVector & theNextDevice_v, size_t theThreadCount) {
+	netId_t myNetCount = theFirstDevice_v.size();
+	ResetVector<CDeviceIdVector>(offset_v, myNetCount + 1, 0);
+	// count, offset, then fill. Nets are independent, so count and fill run in parallel.
+	RunNetBlocks(myNetCount, theThreadCount, [&] (netId_t theFirstNet, netId_t theLastNet) {
+		for ( netId_t net_it = theFirstNet; net_it < theLastNet; net_it++ ) {
+			deviceId_t myCount = 0;
+			for ( deviceId_t device_it = theFirstDevice_v[net_it]; device_it != UNKNOWN_DEVICE; device_it = theNextDevice_v[device_it] ) {
+				myCount++;
+			}
+			offset_v[net_it + 1] = myCount;
+		}
+	});
+	for ( netId_t net_it = 0; net_it < myNetCount; net_it++ ) {
+		offset_v[net_it + 1] += offset_v[net_it];
+	}
+	ResetVector<CDeviceIdVector>(device_v, offset_v[myNetCount]);
+	RunNetBlocks(myNetCount, theThreadCount, [&] (netId_t theFirstNet, netId_t theLastNet) {
+		for ( netId_t net_it = theFirstNet; net_it < theLastNet; net_it++ ) {
+			deviceId_t myIndex = offset_v[net_it];
+			for ( deviceId_t device_it = theFirstDevice_v[net_it]; device_it != UNKNOWN_DEVICE; device_it = theNextDevice_v[device_it] ) {
+				device_v[myIndex++] = device_it;
+			}
+		}
+	});
+}
+
+void CDeviceIdAdjacency::Clear() {
+	CDeviceIdVector().swap(offset_v);
+	CDeviceIdVector().swap(device_v);
+}
@@ -0,0 +1,45 @@
+/*
+ * CDeviceIdAdjacency.hh
+ *
+ * Copyright 2014-2026 D. Mitch Bailey  cvc at shuharisystem dot com
+ *
+ * This file is part of cvc.
+ *
+ * cvc is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cvc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with cvc.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * You can download cvc from https://github.com/d-m-bailey/cvc.git
+ */
+
+#ifndef CDEVICEIDADJACENCY_HH_
+#define CDEVICEIDADJACENCY_HH_
+
+#include "Cvc.hh"
+
+class CDeviceIdAdjacency {
+	// Compressed net to device table. Devices for net n are device_v[offset_v[n]] .. device_v[offset_v[n+1]-1],
+	// in the same order as the first/next linked lists they are built from.
+public:
+	CDeviceIdVector	offset_v;
+	CDeviceIdVector	device_v;
+
+	deviceId_t * begin(netId_t theNetId) { return device_v.data() + offset_v[theNetId]; };
+	deviceId_t * end(netId_t theNetId) { return device_v.data() + offset_v[theNetId + 1]; };
+	deviceId_t Count(netId_t theNetId) { return offset_v[theNetId + 1] - offset_v[theNetId]; };
+	deviceId_t First(netId_t theNetId) { return ( Count(theNetId) == 0 ) ? UNKNOWN_DEVICE : device_v[offset_v[theNetId]]; };
+	netId_t size() { return ( offset_v.empty() ) ? 0 : offset_v.size() - 1; };
+	void Build(CDeviceIdVector & theFirstDevice_v, CDeviceIdVector & theNextDevice_v, size_t theThreadCount);
+	void Clear();
+};
+
+#endif /* CDEVICEIDADJACENCY_HH_ */
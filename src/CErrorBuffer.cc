@@ -0,0 +1,70 @@
+/*
+ * CErrorBuffer.cc
+ *
+ * Copyright 2014-2026 D. Mitch Bailey  cvc at shuharisystem dot com
+ *
+ * This file is part of cvc.
+ *
+ * cvc is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cvc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with cvc.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * You can download cvc from https://github.com/d-m-bailey/cvc.git
+ */
+
+#include "CErrorBuffer.hh"
+
+#include "CSpillAllocator.hh"
+
+CErrorBuffer::~CErrorBuffer() {
+	if ( spillFile_p ) fclose(spillFile_p);
+}
+
+int CErrorBuffer::overflow(int theChar) {
+	if ( theChar == EOF ) return 0;
+	text += char(theChar);
+	if ( text.size() >= ERROR_BUFFER_SPILL_BYTES ) Spill();
+	return theChar;
+}
+
+streamsize CErrorBuffer::xsputn(const char * theText_p, streamsize theCount) {
+	text.append(theText_p, theCount);
+	if ( text.size() >= ERROR_BUFFER_SPILL_BYTES ) Spill();
+	return theCount;
+}
+
+void CErrorBuffer::Spill() {
+	// Uncompressed, so the text is only compressed once when copied to the error file.
+	if ( ! spillFile_p ) {
+		spillFile_p = OpenSpillFile();
+		if ( ! spillFile_p ) throw EFatalError("Could not create error buffer file");
+	}
+	if ( fwrite(text.data(), 1, text.size(), spillFile_p) != text.size() ) throw EFatalError("Could not write error buffer file");
+	text.clear();
+}
+
+void CErrorBuffer::CopyTo(ostream & theOutput) {
+	// Spilled text first, then the text still in memory. The buffer is empty afterwards.
+	if ( spillFile_p ) {
+		char myBuffer[65536];
+		size_t myCount;
+		rewind(spillFile_p);
+		while ( (myCount = fread(myBuffer, 1, sizeof(myBuffer), spillFile_p)) > 0 ) {
+			theOutput.write(myBuffer, myCount);
+		}
+		fclose(spillFile_p);
+		spillFile_p = NULL;
+	}
+	theOutput.write(text.data(), text.size());
+	text.clear();
+	text.shrink_to_fit();
+}
@@ -0,0 +1,62 @@
+/*
+ * CErrorBuffer.hh
+ *
+ * Copyright 2014-2026 D. Mitch Bailey  cvc at shuharisystem dot com
+ *
+ * This file is part of cvc.
+ *
+ * cvc is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cvc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with cvc.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * You can download cvc from https://github.com/d-m-bailey/cvc.git
+ */
+
+#ifndef CERRORBUFFER_HH_
+#define CERRORBUFFER_HH_
+
+#include "Cvc.hh"
+
+#include <cstdio>
+#include <streambuf>
+
+// Error text is kept in memory until it exceeds ERROR_BUFFER_SPILL_BYTES, then moved to an unlinked scratch file.
+#define ERROR_BUFFER_SPILL_BYTES	(size_t(16) << 20)
+
+class CErrorBuffer : public streambuf {
+	// Uncompressed error text for one check category
+public:
+	string	text;
+	FILE *	spillFile_p = NULL;
+
+	~CErrorBuffer();
+	void CopyTo(ostream & theOutput);
+
+protected:
+	virtual int overflow(int theChar);
+	virtual streamsize xsputn(const char * theText_p, streamsize theCount);
+
+private:
+	void Spill();
+};
+
+class CErrorStream : public ostream {
+	// Collects the errors for one check category so they can be appended to the error file in order
+public:
+	CErrorStream() : ostream(&buffer) {};
+	void CopyTo(ostream & theOutput) { flush(); buffer.CopyTo(theOutput); };
+
+private:
+	CErrorBuffer buffer;
+};
+
+#endif /* CERRORBUFFER_HH_ */
@@ -0,0 +1,140 @@
+/*
+ * CErrorDatabase.cc
+ *
+ * Copyright 2014-2026 D. Mitch Bailey  cvc at shuharisystem dot com
+ *
+ * This file is part of cvc.
+ *
+ * cvc is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cvc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with cvc.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * You can download cvc from https://github.com/d-m-bailey/cvc.git
+ */
+
+#include "CErrorDatabase.hh"
+
+#define ERROR_DATABASE_HEADER_SIZE	24
+#define ERROR_DATABASE_TRAILER_SIZE	32
+
+template <typename T>
+static void WriteValue(ofstream & theFile, const T & theValue) {
+	theFile.write(reinterpret_cast<const char *>(&theValue), sizeof(T));
+}
+
+template <typename T>
+static void ReadValue(ifstream & theFile, T & theValue) {
+	if ( ! theFile.read(reinterpret_cast<char *>(&theValue), sizeof(T)) ) throw EFatalError("error database is truncated");
+}
+
+void CErrorDatabase::Open(string theFileName) {
+	file.open(theFileName, ios::binary | ios::trunc);
+	if ( ! file.good() ) throw EFatalError("Could not open " + theFileName);
+	recordCount = 0;
+	text_v.clear();
+	textIndexMap.clear();
+	for ( int type_it = 0; type_it < ERROR_TYPE_COUNT; type_it++ ) {
+		typeIndex_v[type_it].clear();
+	}
+	file.write(ERROR_DATABASE_MAGIC, 8);
+	WriteValue(file, uint32_t(ERROR_DATABASE_VERSION));
+	WriteValue(file, uint32_t(sizeof(CErrorRecord)));
+	WriteValue(file, uint32_t(ERROR_TYPE_COUNT));
+	WriteValue(file, uint32_t(0));
+}
+
+uint32_t CErrorDatabase::TextIndex(const string & theText) {
+	auto myText_pit = textIndexMap.find(theText);
+	if ( myText_pit != textIndexMap.end() ) return myText_pit->second;
+	uint32_t myIndex = text_v.size();
+	text_v.push_back(theText);
+	textIndexMap[theText] = myIndex;
+	return myIndex;
+}
+
+void CErrorDatabase::AddRecord(CErrorRecord & theRecord) {
+	assert(theRecord.errorIndex < ERROR_TYPE_COUNT);
+	typeIndex_v[theRecord.errorIndex].push_back(recordCount);
+	file.write(reinterpret_cast<const char *>(&theRecord), sizeof(CErrorRecord));
+	recordCount++;
+}
+
+void CErrorDatabase::Close() {
+	if ( ! file.is_open() ) return;
+	uint64_t myTextOffset = file.tellp();
+	WriteValue(file, uint64_t(text_v.size()));
+	for ( auto text_pit = text_v.begin(); text_pit != text_v.end(); text_pit++ ) {
+		WriteValue(file, uint32_t(text_pit->size()));
+		file.write(text_pit->data(), text_pit->size());
+	}
+	uint64_t myIndexOffset = file.tellp();
+	for ( int type_it = 0; type_it < ERROR_TYPE_COUNT; type_it++ ) {
+		WriteValue(file, uint64_t(typeIndex_v[type_it].size()));
+		file.write(reinterpret_cast<const char *>(typeIndex_v[type_it].data()), typeIndex_v[type_it].size() * sizeof(uint64_t));
+	}
+	WriteValue(file, recordCount);
+	WriteValue(file, myTextOffset);
+	WriteValue(file, myIndexOffset);
+	file.write(ERROR_DATABASE_MAGIC, 8);
+	file.close();
+	text_v.clear();
+	textIndexMap.clear();
+	for ( int type_it = 0; type_it < ERROR_TYPE_COUNT; type_it++ ) {
+		vector<uint64_t>().swap(typeIndex_v[type_it]);
+	}
+}
+
+void CErrorDatabaseReader::Open(string theFileName) {
+	file.open(theFileName, ios::binary);
+	if ( ! file.good() ) throw EFatalError("Could not open " + theFileName);
+	char myMagic[8];
+	uint32_t myVersion, myRecordSize, myTypeCount, myReserved;
+	if ( ! file.read(myMagic, 8) || string(myMagic, 8) != ERROR_DATABASE_MAGIC ) throw EFatalError(theFileName + " is not an error database");
+	ReadValue(file, myVersion);
+	ReadValue(file, myRecordSize);
+	ReadValue(file, myTypeCount);
+	ReadValue(file, myReserved);
+	if ( myVersion != ERROR_DATABASE_VERSION || myRecordSize != sizeof(CErrorRecord) || myTypeCount != ERROR_TYPE_COUNT ) {
+		throw EFatalError(theFileName + " was written by an incompatible version");
+	}
+	uint64_t myTextOffset, myIndexOffset;
+	file.seekg(-ERROR_DATABASE_TRAILER_SIZE, ios::end);
+	ReadValue(file, recordCount);
+	ReadValue(file, myTextOffset);
+	ReadValue(file, myIndexOffset);
+	if ( ! file.read(myMagic, 8) || string(myMagic, 8) != ERROR_DATABASE_MAGIC ) throw EFatalError(theFileName + " is incomplete");
+	file.seekg(myTextOffset);
+	uint64_t myTextCount;
+	uint32_t myTextLength;
+	ReadValue(file, myTextCount);
+	text_v.resize(myTextCount);
+	for ( auto text_pit = text_v.begin(); text_pit != text_v.end(); text_pit++ ) {
+		ReadValue(file, myTextLength);
+		text_pit->resize(myTextLength);
+		if ( myTextLength > 0 && ! file.read(&(*text_pit)[0], myTextLength) ) throw EFatalError("error database is truncated");
+	}
+	file.seekg(myIndexOffset);
+	for ( int type_it = 0; type_it < ERROR_TYPE_COUNT; type_it++ ) {
+		uint64_t myCount;
+		ReadValue(file, myCount);
+		typeIndex_v[type_it].resize(myCount);
+		if ( myCount > 0 && ! file.read(reinterpret_cast<char *>(typeIndex_v[type_it].data()), myCount * sizeof(uint64_t)) ) {
+			throw EFatalError("error database is truncated");
+		}
+	}
+}
+
+void CErrorDatabaseReader::ReadRecord(uint64_t theRecordNumber, CErrorRecord & theRecord) {
+	if ( theRecordNumber >= recordCount ) throw EFatalError("error record " + to_string(theRecordNumber) + " out of range");
+	file.seekg(ERROR_DATABASE_HEADER_SIZE + theRecordNumber * sizeof(CErrorRecord));
+	ReadValue(file, theRecord);
+}
@@ -0,0 +1,90 @@
+/*
+ * CErrorDatabase.hh
+ *
+ * Copyright 2014-2026 D. Mitch Bailey  cvc at shuharisystem dot com
+ *
+ * This file is part of cvc.
+ *
+ * cvc is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cvc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with cvc.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * You can download cvc from https://github.com/d-m-bailey/cvc.git
+ */
+
+#ifndef CERRORDATABASE_HH_
+#define CERRORDATABASE_HH_
+
+#include "Cvc.hh"
+
+// Binary copy of the device errors in the error report (CVC_ERROR_DATABASE).
+// Layout: header, fixed size records in the order the errors are found, string table, record index by error type, trailer.
+// Overvoltage records precede their buffered report text, so record order can differ from the report.
+#define ERROR_DATABASE_MAGIC "CVCERRDB"
+#define ERROR_DATABASE_VERSION 2
+#define ERROR_TERMINAL_COUNT 4
+
+enum errorTerminal_t { ERROR_GATE = 0, ERROR_SOURCE, ERROR_DRAIN, ERROR_BULK };
+
+class CErrorRecord {
+	// One printed device error. Unused terminals and missing values are UNKNOWN_NET or UNKNOWN_VOLTAGE.
+public:
+	uint32_t	errorIndex;  // cvcError_t
+	deviceId_t	deviceId;
+	instanceId_t	parentId;
+	uint32_t	mFactor;
+	uint32_t	instanceText;  // string table index of the parent hierarchy
+	uint32_t	circuitText;  // subcircuit containing the device
+	uint32_t	deviceText;
+	uint32_t	parameterText;  // model and size
+	netId_t	net[ERROR_TERMINAL_COUNT];
+	netId_t	minNet[ERROR_TERMINAL_COUNT];
+	netId_t	simNet[ERROR_TERMINAL_COUNT];
+	netId_t	maxNet[ERROR_TERMINAL_COUNT];
+	netId_t	minPower[ERROR_TERMINAL_COUNT];  // CPower::powerId
+	netId_t	simPower[ERROR_TERMINAL_COUNT];
+	netId_t	maxPower[ERROR_TERMINAL_COUNT];
+	voltage_t	minVoltage[ERROR_TERMINAL_COUNT];
+	voltage_t	simVoltage[ERROR_TERMINAL_COUNT];
+	voltage_t	maxVoltage[ERROR_TERMINAL_COUNT];
+};
+
+class CErrorDatabase {
+	// Records are written as errors are printed. The string table and index are added by Close.
+public:
+	ofstream	file;
+	uint64_t	recordCount = 0;
+	vector<string>	text_v;
+	unordered_map<string, uint32_t>	textIndexMap;
+	vector<uint64_t>	typeIndex_v[ERROR_TYPE_COUNT];  // record numbers for each error type
+
+	void Open(string theFileName);
+	void Close();
+	bool IsOpen() { return file.is_open(); };
+	uint32_t TextIndex(const string & theText);
+	void AddRecord(CErrorRecord & theRecord);
+};
+
+class CErrorDatabaseReader {
+	// Random access to an error database. Records are read on demand, text and index are loaded by Open.
+public:
+	ifstream	file;
+	uint64_t	recordCount = 0;
+	vector<string>	text_v;
+	vector<uint64_t>	typeIndex_v[ERROR_TYPE_COUNT];
+
+	void Open(string theFileName);
+	void ReadRecord(uint64_t theRecordNumber, CErrorRecord & theRecord);
+	const string & Text(uint32_t theTextIndex) { return text_v.at(theTextIndex); };
+};
+
+#endif /* CERRORDATABASE_HH_ */
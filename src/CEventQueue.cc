@@ -35,7 +35,7 @@ bool CEventQueue::IsNextMainQueue() {
 	if ( mainQueue.empty() ) return false;
 	if ( delayQueue.empty() ) return true;
 	// for SIM_QUEUE, mainQueue has priority always. for MIN/MAX_QUEUE, mainQueue has priority if not later key
-	return ( queueType == SIM_QUEUE || ( mainQueue.begin()->first <= delayQueue.begin()->first ) );
+	return ( queueType == SIM_QUEUE || ( mainQueue.FrontKey() <= delayQueue.FrontKey() ) );
 }
 
 void CEventQueue::AddEvent(eventKey_t theEventKey, deviceId_t theDeviceIndex, queuePosition_t theQueuePosition) {
@@ -60,20 +60,14 @@ void CEventQueue::AddEvent(eventKey_t theEventKey, deviceId_t theDeviceIndex, qu
   }
 
 deviceId_t CEventQueue::GetMainEvent() {
-	deviceId_t myDeviceIndex = mainQueue.begin()->second.pop_front(); //mainQueue.begin()->second.front();
-	if ( mainQueue.begin()->second.empty() ) {
-		mainQueue.erase(mainQueue.begin());
-	}
+	deviceId_t myDeviceIndex = mainQueue.PopFront();
 	dequeueCount++;
 	if ( --printCounter <= 0 ) PrintStatus();
 	return myDeviceIndex;
 }
 
 deviceId_t CEventQueue::GetDelayEvent() {
-	deviceId_t myDeviceIndex = delayQueue.begin()->second.pop_front(); //delayQueue.begin()->second.front();
-	if ( delayQueue.begin()->second.empty() ) {
-		delayQueue.erase(delayQueue.begin());
-	}
+	deviceId_t myDeviceIndex = delayQueue.PopFront();
 	dequeueCount++;
 	if ( --printCounter <= 0 ) PrintStatus();
 	return myDeviceIndex;
@@ -103,43 +97,117 @@ void CEventQueue::Print(string theIndentation) {
 	cout << theIndentation << "EventQueue(" << gEventQueueTypeMap[queueType] << ")> start" << endl;
 	cout << myIndentation << "Counts (enqueue/dequeue/requeue) " << enqueueCount << "/" << dequeueCount << "/" << requeueCount << endl;
 	cout << myIndentation << "Main Queue>" << endl;
-	for (CEventSubQueue::iterator eventPair_pit = mainQueue.begin(); eventPair_pit != mainQueue.end(); eventPair_pit++) {
-		cout << myIndentation << "Time: " << eventPair_pit->first << " (" << eventPair_pit->second.size() << "):";
-		for (deviceId_t device_it = eventPair_pit->second.first, myLastDevice = UNKNOWN_DEVICE;
-				device_it != UNKNOWN_DEVICE && device_it != myLastDevice;
-				myLastDevice = device_it, device_it = queueArray[device_it]) {
-			cout  << " " << device_it;
-		}
-		cout << endl;
-	}
+	mainQueue.Print(myIndentation);
 	cout << myIndentation << "Delay Queue>" << endl;
-	for (CEventSubQueue::iterator eventPair_pit = delayQueue.begin(); eventPair_pit != delayQueue.end(); eventPair_pit++) {
-		cout << myIndentation << "Time: " << eventPair_pit->first << " (" << eventPair_pit->second.size() << "):";
-		for (deviceId_t device_it = eventPair_pit->second.first, myLastDevice = UNKNOWN_DEVICE;
-				device_it != UNKNOWN_DEVICE && device_it != myLastDevice;
-				myLastDevice = device_it, device_it = queueArray[device_it]) {
-			cout  << " " << device_it;
-		}
-		cout << endl;
-	}
+	delayQueue.Print(myIndentation);
 	leakMap.Print(myIndentation);
 	cout << theIndentation << "EventQueue> end" << endl;
 }
 
 CEventList& CEventSubQueue::operator[] (eventKey_t theEventKey) {
-	CEventSubQueue::iterator myItem_it = find(theEventKey);
-	if ( myItem_it == end() ) {
-		pair<CEventSubQueue::iterator, bool> myResult;
-		myResult = insert(make_pair(theEventKey, CEventList(queueArray)));
-		return (myResult.first->second);
+	// Returns the list for theEventKey. The caller adds an event, so the bucket is marked as occupied.
+	if ( empty() ) PlaceWindow(theEventKey);
+	long myOffset = long(theEventKey) - long(baseKey);
+	if ( myOffset < 0 || myOffset >= EVENT_WINDOW_SIZE ) {
+		auto myItem_pit = overflowMap.find(theEventKey);
+		if ( myItem_pit == overflowMap.end() ) {
+			myItem_pit = overflowMap.insert(make_pair(theEventKey, CEventList(queueArray))).first;
+		}
+		return (myItem_pit->second);
+	}
+	size_t myIndex = myOffset;
+	if ( bucket_v[myIndex].empty() ) {
+		occupied_v[myIndex >> 6] |= uint64_t(1) << (myIndex & 63);
+		bucketCount++;
+		if ( myIndex < frontIndex ) frontIndex = myIndex;
+	}
+	return (bucket_v[myIndex]);
+}
+
+void CEventSubQueue::PlaceWindow(eventKey_t theEventKey) {
+	// Move the empty window so that it contains theEventKey and load any overflow keys that now fit.
+	assert(bucketCount == 0);
+	if ( bucket_v.empty() ) {
+		bucket_v.resize(EVENT_WINDOW_SIZE, CEventList(queueArray));
+		occupied_v.resize(EVENT_WINDOW_SIZE >> 6, 0);
+	}
+	baseKey = eventKey_t(max(long(theEventKey) - EVENT_WINDOW_MARGIN, long(INT32_MIN)));
+	frontIndex = EVENT_WINDOW_SIZE;
+	auto myItem_pit = overflowMap.lower_bound(baseKey);
+	while ( myItem_pit != overflowMap.end() && long(myItem_pit->first) - long(baseKey) < EVENT_WINDOW_SIZE ) {
+		size_t myIndex = myItem_pit->first - baseKey;
+		bucket_v[myIndex] = myItem_pit->second;
+		occupied_v[myIndex >> 6] |= uint64_t(1) << (myIndex & 63);
+		bucketCount++;
+		if ( myIndex < frontIndex ) frontIndex = myIndex;
+		myItem_pit = overflowMap.erase(myItem_pit);
+	}
+}
+
+size_t CEventSubQueue::NextOccupied(size_t theIndex) {
+	// Index of the first non-empty bucket at or after theIndex. EVENT_WINDOW_SIZE if none.
+	size_t myWord = theIndex >> 6;
+	if ( myWord >= occupied_v.size() ) return EVENT_WINDOW_SIZE;
+	uint64_t myBits = occupied_v[myWord] & (~uint64_t(0) << (theIndex & 63));
+	while ( myBits == 0 ) {
+		if ( ++myWord >= occupied_v.size() ) return EVENT_WINDOW_SIZE;
+		myBits = occupied_v[myWord];
+	}
+	return ( (myWord << 6) + __builtin_ctzll(myBits) );
+}
+
+eventKey_t CEventSubQueue::FrontKey() {
+	return ( IsOverflowFront() ) ? overflowMap.begin()->first : baseKey + eventKey_t(frontIndex);
+}
+
+CEventList& CEventSubQueue::Front() {
+	return ( IsOverflowFront() ) ? overflowMap.begin()->second : bucket_v[frontIndex];
+}
+
+deviceId_t CEventSubQueue::PopFront() {
+	deviceId_t myDeviceId;
+	if ( IsOverflowFront() ) {
+		auto myFront_pit = overflowMap.begin();
+		myDeviceId = myFront_pit->second.pop_front();
+		if ( myFront_pit->second.empty() ) {
+			overflowMap.erase(myFront_pit);
+		}
 	} else {
-		return (myItem_it->second);
+		myDeviceId = bucket_v[frontIndex].pop_front();
+		if ( bucket_v[frontIndex].empty() ) {
+			occupied_v[frontIndex >> 6] &= ~(uint64_t(1) << (frontIndex & 63));
+			bucketCount--;
+			frontIndex = NextOccupied(frontIndex);
+		}
+	}
+	if ( bucketCount == 0 && ! overflowMap.empty() ) {
+		PlaceWindow(overflowMap.begin()->first);
 	}
+	return myDeviceId;
 }
 
 eventKey_t CEventSubQueue::QueueTime(eventQueue_t theQueueType) {
-	if ( size() == 0 ) return MAX_EVENT_TIME;
-	return ( begin()->first );
+	if ( empty() ) return MAX_EVENT_TIME;
+	return ( FrontKey() );
+}
+
+void CEventSubQueue::Print(string theIndentation) {
+	map<eventKey_t, CEventList *> myEventListMap;
+	for ( size_t bucket_it = NextOccupied(0); bucket_it < EVENT_WINDOW_SIZE; bucket_it = NextOccupied(bucket_it + 1) ) {
+		myEventListMap[baseKey + eventKey_t(bucket_it)] = &bucket_v[bucket_it];
+	}
+	for ( auto eventPair_pit = overflowMap.begin(); eventPair_pit != overflowMap.end(); eventPair_pit++ ) {
+		myEventListMap[eventPair_pit->first] = &eventPair_pit->second;
+	}
+	for ( auto eventPair_pit = myEventListMap.begin(); eventPair_pit != myEventListMap.end(); eventPair_pit++ ) {
+		cout << theIndentation << "Time: " << eventPair_pit->first << " (" << eventPair_pit->second->size() << "):";
+		for (deviceId_t device_it = eventPair_pit->second->first, myLastDevice = UNKNOWN_DEVICE;
+				device_it != UNKNOWN_DEVICE && device_it != myLastDevice;
+				myLastDevice = device_it, device_it = queueArray[device_it]) {
+			cout  << " " << device_it;
+		}
+		cout << endl;
+	}
 }
 
 eventKey_t CEventQueue::QueueTime() {
@@ -202,6 +270,7 @@ void CEventQueue::PrintStatus(int theNextPrintCount) {
 }
 
 void CEventList::push_back(deviceId_t theDevice) {
+	vector<deviceId_t>& queueArray = *queueArray_p;
 	if (queueArray[theDevice] != UNKNOWN_DEVICE) throw EQueueError(to_string<deviceId_t> (theDevice));
 	queueArray[theDevice] = theDevice;
 	if ( first == UNKNOWN_DEVICE ) {
@@ -216,6 +285,7 @@ void CEventList::push_back(deviceId_t theDevice) {
 }
 
 void CEventList::push_front(deviceId_t theDevice) {
+	vector<deviceId_t>& queueArray = *queueArray_p;
 	if (queueArray[theDevice] != UNKNOWN_DEVICE) throw EQueueError(to_string<deviceId_t> (theDevice));
 	if ( first == UNKNOWN_DEVICE ) {
 		assert(second == UNKNOWN_DEVICE);
@@ -230,6 +300,7 @@ void CEventList::push_front(deviceId_t theDevice) {
 }
 
 deviceId_t CEventList::pop_front() {
+	vector<deviceId_t>& queueArray = *queueArray_p;
 	if (first == UNKNOWN_DEVICE) throw EQueueError("empty queue");
 	deviceId_t myDevice;
 	myDevice = first;
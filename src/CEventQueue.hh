@@ -34,12 +34,15 @@ enum queuePosition_t {QUEUE_HIZ = -3, SKIP_QUEUE, MOS_DIODE, MAIN_BACK, DELAY_FR
 
 #define DefaultQueuePosition_(flag, queue) (((flag) || queue.queueType == SIM_QUEUE) ? MAIN_BACK : DELAY_FRONT)
 
+#define EVENT_WINDOW_SIZE	(1 << 16)  // keys stored directly in the bucket window
+#define EVENT_WINDOW_MARGIN	(EVENT_WINDOW_SIZE >> 3)  // keys below the first key that still fit when the window is placed
+
 class CEventList : public pair<deviceId_t, deviceId_t> {
 public:
-	vector<deviceId_t>& queueArray;
+	vector<deviceId_t> * queueArray_p;
 	size_t eventListSize = 0;
 
-	CEventList(vector<deviceId_t>& theQueueArray) : queueArray(theQueueArray) { first = second = UNKNOWN_DEVICE; }
+	CEventList(vector<deviceId_t>& theQueueArray) : queueArray_p(&theQueueArray) { first = second = UNKNOWN_DEVICE; }
 	void push_back(deviceId_t theDevice);
 	void push_front(deviceId_t theDevice);
 	deviceId_t pop_front();
@@ -66,13 +69,34 @@ public:
 	void Print(string theIndentation = "");
 };
 
-class CEventSubQueue : public map<eventKey_t, CEventList> {
+class CEventSubQueue {
+	// Bucket queue. Keys in [baseKey, baseKey + EVENT_WINDOW_SIZE) index bucket_v directly and occupied_v marks non-empty buckets.
+	// Keys outside the window are kept in overflowMap. When the window empties, it is moved to the lowest overflow key.
 public:
 	vector<deviceId_t>& queueArray;
+	vector<CEventList> bucket_v;
+	vector<uint64_t> occupied_v;
+	map<eventKey_t, CEventList> overflowMap;
+	eventKey_t baseKey = 0;
+	size_t frontIndex = EVENT_WINDOW_SIZE;  // lowest non-empty bucket
+	size_t bucketCount = 0;  // non-empty buckets
 
 	CEventSubQueue(vector<deviceId_t>& theQueueArray) : queueArray(theQueueArray) {}
 	CEventList& operator[] (eventKey_t theEventKey);
+	inline bool empty() { return ( bucketCount == 0 && overflowMap.empty() ); };
+	inline size_t size() { return ( bucketCount + overflowMap.size() ); };
+	eventKey_t FrontKey();
+	CEventList& Front();
+	deviceId_t PopFront();
 	eventKey_t QueueTime(eventQueue_t theQueueType);
+	void Print(string theIndentation = "");
+
+private:
+	inline bool IsOverflowFront() {
+		return ( bucketCount == 0 || ( ! overflowMap.empty() && overflowMap.begin()->first < baseKey + eventKey_t(frontIndex) ) );
+	};
+	void PlaceWindow(eventKey_t theEventKey);
+	size_t NextOccupied(size_t theIndex);
 };
 
 class CEventQueue {
@@ -42,61 +42,125 @@ CFixedText::~CFixedText() {
 void CFixedText::Clear() {
 	const char myDummy[] = "";
 	obstack_free(&fixedTextObstack, firstAddress);
-	fixedTextToAddressMap.clear();
+	textIndex_v.clear();
+	entries = 0;
 	obstack_copy0(&(fixedTextObstack), (void *) myDummy, 0);  // first string is null string
 	size = 1;
 }
 
-text_t CFixedText::SetTextAddress(const text_t theNewText){
-	text_t myTextAddress;
-	//static string myKeyText;
-	string myKeyText;
+uint32_t CFixedText::Hash(const char * theText, size_t theLength) {
+	// FNV-1a with a final avalanche so that the low bits used for the slot are well mixed
+	uint32_t myHash = 2166136261u;
+	for ( size_t char_it = 0; char_it < theLength; char_it++ ) {
+		myHash = (myHash ^ (unsigned char) theText[char_it]) * 16777619u;
+	}
+	myHash ^= myHash >> 16;
+	myHash *= 0x85ebca6b;
+	myHash ^= myHash >> 13;
+	return(myHash);
+}
 
-	// TODO: try with count for speed (2 hash lookups vs throwing error)
-	try {
-		myKeyText = theNewText;
-		myTextAddress = fixedTextToAddressMap.at(myKeyText);
+size_t CFixedText::FindSlot(const char * theText, size_t theLength, uint32_t theHash) {
+	// Returns the slot containing the text, or the empty slot where it should be inserted.
+	size_t myMask = textIndex_v.size() - 1;
+	size_t mySlot = theHash & myMask;
+	while ( textIndex_v[mySlot].text ) {
+		CTextIndexEntry & myEntry = textIndex_v[mySlot];
+		if ( myEntry.hash == theHash && myEntry.length == theLength && memcmp(myEntry.text, theText, theLength) == 0 ) break;
+		mySlot = (mySlot + 1) & myMask;
 	}
-	catch (const out_of_range& oor_exception) {
-		int myNewSize = int(myKeyText.length());
-		myTextAddress = (text_t) obstack_copy0(&(fixedTextObstack), (void *) myKeyText.c_str(), myNewSize);
-		size += myNewSize + 1;
-		fixedTextToAddressMap[myKeyText] = myTextAddress;
+	return(mySlot);
+}
+
+void CFixedText::GrowIndex() {
+	CTextIndexVector myOldIndex_v;
+	myOldIndex_v.swap(textIndex_v);
+	textIndex_v.resize(max(size_t(1024), myOldIndex_v.size() * 2));
+	size_t myMask = textIndex_v.size() - 1;
+	for ( auto entry_pit = myOldIndex_v.begin(); entry_pit != myOldIndex_v.end(); entry_pit++ ) {
+		if ( ! entry_pit->text ) continue;
+		size_t mySlot = entry_pit->hash & myMask;
+		while ( textIndex_v[mySlot].text ) {
+			mySlot = (mySlot + 1) & myMask;
+		}
+		textIndex_v[mySlot] = *entry_pit;
 	}
-	return(myTextAddress);
+}
+
+text_t CFixedText::SetTextAddress(const text_t theNewText){
+	return(SetTextAddress(theNewText, strlen(theNewText)));
+}
+
+text_t CFixedText::SetTextAddress(const char * theText, size_t theLength) {
+	// text may not be null terminated (scanner tokens, cache entries). Only new text is copied.
+	if ( (entries + 1) * 10 > textIndex_v.size() * 7 ) GrowIndex();  // keep load below 70%
+	uint32_t myHash = Hash(theText, theLength);
+	size_t mySlot = FindSlot(theText, theLength, myHash);
+	CTextIndexEntry & myEntry = textIndex_v[mySlot];
+	if ( ! myEntry.text ) {
+		myEntry.text = (text_t) obstack_copy0(&fixedTextObstack, (void *) theText, theLength);
+		myEntry.hash = myHash;
+		myEntry.length = theLength;
+		size += theLength + 1;
+		entries++;
+	}
+	return(myEntry.text);
 }
 
 text_t CFixedText::SetTextAddress(const string theType,	CTextList* theNewTextList) {
-	text_t myTextAddress;
 	string myKeyText;
 	myKeyText = theType;
 	for (CTextList::iterator text_pit = theNewTextList->begin(); text_pit != theNewTextList->end(); text_pit++) {
 		myKeyText += " ";
 		myKeyText += *text_pit;
 	}
-	try {
-		myTextAddress = fixedTextToAddressMap.at(myKeyText);
-	}
-	catch (const out_of_range& oor_exception) {
-		int myNewSize = int(myKeyText.length());
-		myTextAddress = (text_t) obstack_copy0(&fixedTextObstack, (void *) myKeyText.c_str(), myNewSize);
-		size += myNewSize + 1;
-		fixedTextToAddressMap[myKeyText] = myTextAddress;
-	}
-	return (myTextAddress);
+	return (SetTextAddress(myKeyText.c_str(), myKeyText.length()));
 }
 
-text_t CFixedText::GetTextAddress(const text_t theNewText) {
-	static string myKeyText;
+text_t CFixedText::FindTextAddress(const char * theText, size_t theLength) {
+	// Returns NULL if not found.
+	if ( textIndex_v.empty() ) return(NULL);
+	return(textIndex_v[FindSlot(theText, theLength, Hash(theText, theLength))].text);
+}
 
-//	send all exceptions to caller
-	myKeyText = theNewText;
-	return(fixedTextToAddressMap.at(myKeyText));
+text_t CFixedText::GetTextAddress(const text_t theNewText) {
+	//	send all exceptions to caller
+	text_t myTextAddress = FindTextAddress(theNewText, strlen(theNewText));
+	if ( ! myTextAddress ) throw out_of_range("text not found: " + string(theNewText));
+	return(myTextAddress);
 }
 
 text_t CFixedText::GetTextAddress(const string theKeyText){
 	//	send all exceptions to caller
-	return(fixedTextToAddressMap.at(theKeyText));
+	text_t myTextAddress = FindTextAddress(theKeyText.c_str(), theKeyText.length());
+	if ( ! myTextAddress ) throw out_of_range("text not found: " + theKeyText);
+	return(myTextAddress);
+}
+
+void CFixedText::DumpStatistics(string theTitle, ostream& theOutputFile) {
+	// Probe length distribution, analogous to the bucket sizes of unordered_map DumpStatistics
+	theOutputFile << "Hash dump:" << theTitle << endl;
+	theOutputFile << "Contains " << textIndex_v.size() << " slots, " << entries << " elements" << endl;
+	if ( entries == 0 ) return;
+	size_t myMask = textIndex_v.size() - 1;
+	vector<int> myProbe_v;
+	myProbe_v.resize(50, 0);
+	size_t myMaxProbe = 0;
+	size_t myTotalProbe = 0;
+	for ( size_t slot_it = 0; slot_it < textIndex_v.size(); slot_it++ ) {
+		if ( ! textIndex_v[slot_it].text ) continue;
+		size_t myProbe = ((slot_it - textIndex_v[slot_it].hash) & myMask) + 1;
+		myTotalProbe += myProbe;
+		if ( myProbe > myMaxProbe ) myMaxProbe = myProbe;
+		myProbe_v[min(myProbe, size_t(49))] += 1;
+	}
+	for ( size_t probe_it = 1; probe_it <= min(myMaxProbe, size_t(49)); probe_it++ ) {
+		theOutputFile << "Probe length " << probe_it << ", " << myProbe_v[probe_it] << endl;
+	}
+	int myLastPrecision = theOutputFile.precision();
+	theOutputFile.precision(2);
+	theOutputFile << fixed << "Load: " << ((float) entries / textIndex_v.size()) << ", average probe " << ((float) myTotalProbe / entries) << endl;
+	theOutputFile.precision(myLastPrecision);
 }
 
 text_t CTextList::BiasNet(CFixedText & theCdlText) {
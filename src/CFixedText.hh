@@ -31,25 +31,46 @@
 #define obstack_chunk_alloc xmalloc
 #define obstack_chunk_free free
 
+// Text pool index entry: hash and length are cached so lookups only compare bytes on a hash match.
+class CTextIndexEntry {
+public:
+	text_t text = NULL;
+	uint32_t hash = 0;
+	uint32_t length = 0;
+};
+
+class CTextIndexVector : public vector<CTextIndexEntry> {
+public:
+};
+
 class CFixedText {
 private:
 	struct obstack fixedTextObstack;
 	int size = 0;
 	text_t firstAddress;
+	// open addressing (linear probe) index into the obstack. size is a power of 2.
+	CTextIndexVector textIndex_v;
+	size_t entries = 0;
+
+	static uint32_t Hash(const char * theText, size_t theLength);
+	size_t FindSlot(const char * theText, size_t theLength, uint32_t theHash);
+	void GrowIndex();
 public:
-	CStringTextMap fixedTextToAddressMap;
 	CFixedText();
 	~CFixedText();
 	inline int Size() {return size;};
-	inline int	Entries() {return fixedTextToAddressMap.size();};
+	inline int	Entries() {return entries;};
 	void Clear();
 	text_t BlankTextAddress() {return firstAddress;};
 	text_t SetTextAddress(const text_t theText);
+	text_t SetTextAddress(const char * theText, size_t theLength);
 	text_t SetTextAddress(const string theType, CTextList* theNewTextList);
+	text_t FindTextAddress(const char * theText, size_t theLength);
 	text_t GetTextAddress(const text_t theText);
 	text_t GetTextAddress(string theText);
+	const CTextIndexVector & TextIndex() {return textIndex_v;};
 	void Print();
-	friend void DumpStatistics(unordered_map<string, text_t> & theMap, string theTitle);
+	void DumpStatistics(string theTitle, ostream& theOutputFile);
 };
 
 class CCdlText : public CFixedText {
@@ -26,8 +26,11 @@
 #include "CCvcDb.hh"
 #include "CCircuit.hh"
 #include "obstack.h"
+#include <atomic>
+#include <thread>
 
 #define NOT_PARALLEL false
+#define INSTANCE_BLOCK_SIZE 256
 
 int gHashCollisionCount;
 int gMaxHashLength;
@@ -40,8 +43,7 @@ void CInstance::AssignTopGlobalIDs(CCvcDb * theCvcDb_p, CCircuit * theMaster_p)
 	parentId = 0;
 	master_p = theMaster_p;
 	netId_t myLastNet = theMaster_p->localSignalIdMap.size();
-	localToGlobalNetId_v.reserve(myLastNet);
-	localToGlobalNetId_v.resize(myLastNet);
+	localToGlobalNetId_v = theCvcDb_p->instancePtr_v.AllocateNetIds(myLastNet);
 	theMaster_p->internalSignal_v.clear();
 	theMaster_p->internalSignal_v.reserve(theMaster_p->localSignalIdMap.size());
 	theMaster_p->internalSignal_v.resize(theMaster_p->localSignalIdMap.size());
@@ -54,30 +56,67 @@ void CInstance::AssignTopGlobalIDs(CCvcDb * theCvcDb_p, CCircuit * theMaster_p)
 	theCvcDb_p->netCount = myLastNet;
 	theCvcDb_p->subcircuitCount += theMaster_p->subcircuitPtr_v.size();
 	theCvcDb_p->deviceCount = theMaster_p->devicePtr_v.size();
-	theCvcDb_p->netParent_v.resize(theCvcDb_p->netCount, 0);
-	theCvcDb_p->deviceParent_v.resize(theCvcDb_p->deviceCount, 0);
 
-	instanceId_t myLastSubcircuitId = theMaster_p->subcircuitPtr_v.size();
-	instanceId_t myNewInstanceId;
-	for (instanceId_t subcircuit_it = 0; subcircuit_it < myLastSubcircuitId; subcircuit_it++) {
-		//if (theMaster_p->subcircuitPtr_v[subcircuit_it]->master_p->deviceCount > 0) {
-			myNewInstanceId = firstSubcircuitId + subcircuit_it;
-			CDevice * mySubcircuit_p = theMaster_p->subcircuitPtr_v[subcircuit_it];
-			if ( mySubcircuit_p->master_p->instanceId_v.size() == 0 ) mySubcircuit_p->master_p->AllocateInstances(theCvcDb_p, myNewInstanceId);
-			theCvcDb_p->instancePtr_v[myNewInstanceId] = new CInstance;
-			theCvcDb_p->instancePtr_v[myNewInstanceId]->AssignGlobalIDs(theCvcDb_p, myNewInstanceId, mySubcircuit_p, 0, this, NOT_PARALLEL);
-		//}
+	// First pass: depth first, assign id ranges, port nets and parallel instances. Order must match the recursive expansion.
+	CPendingInstanceVector myPendingInstance_v;
+	vector<instanceId_t> myExpandedInstance_v;
+	CNetIdVector myPortNetId_v;
+	PushSubcircuits(myPendingInstance_v, 0, NOT_PARALLEL);
+	while ( ! myPendingInstance_v.empty() ) {
+		CPendingInstance myPending = myPendingInstance_v.back();
+		myPendingInstance_v.pop_back();
+		CInstance * myParent_p = theCvcDb_p->instancePtr_v[myPending.parentId];
+		CDevice * mySubcircuit_p = myParent_p->master_p->subcircuitPtr_v[myPending.instanceId - myParent_p->firstSubcircuitId];
+		if ( mySubcircuit_p->master_p->instanceId_v.size() == 0 ) mySubcircuit_p->master_p->AllocateInstances(theCvcDb_p, myPending.instanceId);
+		CInstance * myInstance_p = theCvcDb_p->instancePtr_v[myPending.instanceId];
+		bool myIsParallel = myInstance_p->AssignGlobalIDs(theCvcDb_p, myPending.instanceId, mySubcircuit_p, myPending.parentId, myParent_p,
+			myPending.isParallel, myPortNetId_v);
+		if ( ! myIsParallel ) myExpandedInstance_v.push_back(myPending.instanceId);
+		myInstance_p->PushSubcircuits(myPendingInstance_v, myPending.instanceId, myIsParallel);
 	}
+
+	theCvcDb_p->instancePtr_v.ShrinkNetIds();
+
+	// Second pass: internal nets and net/device parents. Ranges are disjoint, so instances are filled in parallel.
+	theCvcDb_p->netParent_v.resize(theCvcDb_p->netCount, 0);
+	theCvcDb_p->deviceParent_v.resize(theCvcDb_p->deviceCount, 0);
 	theCvcDb_p->netParent_v.shrink_to_fit();
 	theCvcDb_p->deviceParent_v.shrink_to_fit();
+	atomic<size_t> myNextInstance(0);
+	auto myAssignLocalIds = [&] () {
+		size_t myFirstInstance;
+		while ( (myFirstInstance = myNextInstance.fetch_add(INSTANCE_BLOCK_SIZE)) < myExpandedInstance_v.size() ) {
+			size_t myLastInstance = min(myFirstInstance + INSTANCE_BLOCK_SIZE, myExpandedInstance_v.size());
+			for ( size_t instance_it = myFirstInstance; instance_it < myLastInstance; instance_it++ ) {
+				instanceId_t myInstanceId = myExpandedInstance_v[instance_it];
+				theCvcDb_p->instancePtr_v[myInstanceId]->AssignLocalIDs(theCvcDb_p, myInstanceId);
+			}
+		}
+	};
+	size_t myThreadCount = min(theCvcDb_p->cvcParameters.cvcThreadCount, myExpandedInstance_v.size() / INSTANCE_BLOCK_SIZE + 1);
+	vector<thread> myThread_v;
+	for ( size_t thread_it = 1; thread_it < myThreadCount; thread_it++ ) {
+		myThread_v.push_back(thread(myAssignLocalIds));
+	}
+	myAssignLocalIds();
+	for ( auto thread_pit = myThread_v.begin(); thread_pit != myThread_v.end(); thread_pit++ ) {
+		thread_pit->join();
+	}
 	theCvcDb_p->debugFile << "DEBUG: netParent size " << theCvcDb_p->netParent_v.size() << "; deviceParent size " << theCvcDb_p->deviceParent_v.size() << endl;
 	theCvcDb_p->debugFile << "DEBUG: parallel collisions " << gHashCollisionCount << " max length " << gMaxHashLength << endl;
 }
 
-void CInstance::AssignGlobalIDs(CCvcDb * theCvcDb_p, const instanceId_t theInstanceId, CDevice * theSubcircuit_p, const instanceId_t theParentId,
-		CInstance * theParent_p, bool isParallel) {
+void CInstance::PushSubcircuits(CPendingInstanceVector & thePendingInstance_v, const instanceId_t theInstanceId, bool isParallel) {
+	// reverse order so that subcircuits are popped in netlist order
+	for ( instanceId_t subcircuit_it = master_p->subcircuitPtr_v.size(); subcircuit_it > 0; subcircuit_it-- ) {
+		thePendingInstance_v.push_back(CPendingInstance{firstSubcircuitId + subcircuit_it - 1, theInstanceId, isParallel});
+	}
+}
+
+bool CInstance::AssignGlobalIDs(CCvcDb * theCvcDb_p, const instanceId_t theInstanceId, CDevice * theSubcircuit_p, const instanceId_t theParentId,
+		CInstance * theParent_p, bool isParallel, CNetIdVector & thePortNetId_v) {
+	// Returns true for parallel instances. Only port nets are set here. Internal nets are set later by AssignLocalIDs.
 	master_p = theSubcircuit_p->master_p;
-	instanceId_t myLastSubcircuitId = master_p->subcircuitPtr_v.size();
 	firstSubcircuitId = theCvcDb_p->subcircuitCount;
 	master_p->instanceId_v.push_back(theInstanceId);
 
@@ -96,8 +135,17 @@ void CInstance::AssignGlobalIDs(CCvcDb * theCvcDb_p, const instanceId_t theInsta
 		}
 		theCvcDb_p->debugFile << "DEBUG: found parallel instance in parallel instance at " << theCvcDb_p->HierarchyName(theInstanceId) << endl;
 	} else {
+		// parent internal nets are not set yet, so calculate them from the parent's first net
+		thePortNetId_v.resize(master_p->portCount);
+		netId_t myParentPortCount = theParent_p->master_p->portCount;
+		for (netId_t net_it = 0; net_it < master_p->portCount; net_it++) {
+			netId_t myParentNetId = theSubcircuit_p->signalId_v[net_it];
+			thePortNetId_v[net_it] = ( theParentId == 0 || myParentNetId < myParentPortCount )
+				? theParent_p->localToGlobalNetId_v[myParentNetId]
+				: theParent_p->firstNetId + myParentNetId - myParentPortCount;
+		}
 		if ( theSubcircuit_p->signalId_v.size() <= theCvcDb_p->cvcParameters.cvcParallelCircuitPortLimit ) {
-			myParallelInstance = theSubcircuit_p->FindParallelInstance(theCvcDb_p, theInstanceId, theParent_p->localToGlobalNetId_v);
+			myParallelInstance = theSubcircuit_p->FindParallelInstance(theCvcDb_p, theInstanceId, thePortNetId_v);
 			if ( myParallelInstance == theInstanceId ) {
 				theCvcDb_p->instancePtr_v[theInstanceId]->parallelInstanceCount = 1;
 			} else {  // skip parallel circuits
@@ -112,33 +160,24 @@ void CInstance::AssignGlobalIDs(CCvcDb * theCvcDb_p, const instanceId_t theInsta
 		firstNetId = theCvcDb_p->netCount;
 		firstDeviceId = theCvcDb_p->deviceCount;
 
-		netId_t myLastNet = master_p->localSignalIdMap.size();
-		localToGlobalNetId_v.reserve(myLastNet);
-		localToGlobalNetId_v.resize(myLastNet);
-		for (netId_t net_it = 0; net_it < master_p->portCount; net_it++) {
-			localToGlobalNetId_v[net_it] = theParent_p->localToGlobalNetId_v[theSubcircuit_p->signalId_v[net_it]];
-		}
-		for (netId_t net_it = master_p->portCount; net_it < myLastNet; net_it++) {
-			localToGlobalNetId_v[net_it] = firstNetId + net_it - master_p->portCount;
-		}
+		localToGlobalNetId_v = theCvcDb_p->instancePtr_v.AllocateNetIds(master_p->localSignalIdMap.size());
+		copy(thePortNetId_v.begin(), thePortNetId_v.end(), localToGlobalNetId_v.begin());
 		theCvcDb_p->netCount += master_p->LocalNetCount();
 		theCvcDb_p->deviceCount += master_p->devicePtr_v.size();
-		theCvcDb_p->netParent_v.resize(theCvcDb_p->netCount, theInstanceId);
-		theCvcDb_p->deviceParent_v.resize(theCvcDb_p->deviceCount, theInstanceId);
 	}
 
 	theCvcDb_p->subcircuitCount += master_p->subcircuitPtr_v.size();
+	return(isParallel);
+}
 
-	instanceId_t myNewInstanceId;
-	for (instanceId_t subcircuit_it = 0; subcircuit_it < myLastSubcircuitId; subcircuit_it++) {
-		myNewInstanceId = firstSubcircuitId + subcircuit_it;
-		CDevice * mySubcircuit_p = master_p->subcircuitPtr_v[subcircuit_it];
-		//if (mySubcircuit_p->master_p->deviceCount > 0) {
-			if ( mySubcircuit_p->master_p->instanceId_v.size() == 0 ) mySubcircuit_p->master_p->AllocateInstances(theCvcDb_p, myNewInstanceId);
-			theCvcDb_p->instancePtr_v[myNewInstanceId] = new CInstance;
-			theCvcDb_p->instancePtr_v[myNewInstanceId]->AssignGlobalIDs(theCvcDb_p, myNewInstanceId, mySubcircuit_p, theInstanceId, this, isParallel);
-		//}
+void CInstance::AssignLocalIDs(CCvcDb * theCvcDb_p, const instanceId_t theInstanceId) {
+	// Sets internal nets and net/device parents for an expanded instance. Only touches this instance's ranges.
+	netId_t myLastNet = localToGlobalNetId_v.size();
+	for (netId_t net_it = master_p->portCount; net_it < myLastNet; net_it++) {
+		localToGlobalNetId_v[net_it] = firstNetId + net_it - master_p->portCount;
 	}
+	fill_n(theCvcDb_p->netParent_v.begin() + firstNetId, master_p->LocalNetCount(), theInstanceId);
+	fill_n(theCvcDb_p->deviceParent_v.begin() + firstDeviceId, master_p->devicePtr_v.size(), theInstanceId);
 }
 
 void CInstance::Print (const instanceId_t theInstanceId, const string theIndentation) {
@@ -155,14 +194,37 @@ void CInstance::Print (const instanceId_t theInstanceId, const string theIndenta
 	cout << endl;
 }
 
-void CInstancePtrVector::Clear() {
-	for ( auto instance_ppit = begin(); instance_ppit != end(); instance_ppit++ ) {
-		delete (*instance_ppit);
-	}
-	resize(0);
+void CInstanceVector::Clear() {
+	instance_v.clear();
+	instance_v.shrink_to_fit();
+	netIdPool_v.clear();
+	netIdPool_v.shrink_to_fit();
 }
 
-CInstancePtrVector::~CInstancePtrVector() {
+void CInstanceVector::Reset(instanceId_t theInstanceCount, size_t theNetIdCount) {
+	// theNetIdCount is an upper limit. The pool must not reallocate while spans are being allocated.
 	Clear();
+	instance_v.resize(theInstanceCount);
+	netIdPool_v.reserve(theNetIdCount);
+}
+
+CNetIdSpan CInstanceVector::AllocateNetIds(netId_t theCount) {
+	assert(netIdPool_v.size() + theCount <= netIdPool_v.capacity());
+	CNetIdSpan myNetIds;
+	myNetIds.count = theCount;
+	netIdPool_v.resize(netIdPool_v.size() + theCount);
+	myNetIds.netId_p = netIdPool_v.data() + netIdPool_v.size() - theCount;
+	return(myNetIds);
+}
+
+void CInstanceVector::ShrinkNetIds() {
+	// Release the space reserved for parallel instances and move the spans to the new pool.
+	netId_t * myOldPool_p = netIdPool_v.data();
+	netIdPool_v.shrink_to_fit();
+	for ( auto instance_pit = instance_v.begin(); instance_pit != instance_v.end(); instance_pit++ ) {
+		if ( instance_pit->localToGlobalNetId_v.netId_p ) {
+			instance_pit->localToGlobalNetId_v.netId_p = netIdPool_v.data() + (instance_pit->localToGlobalNetId_v.netId_p - myOldPool_p);
+		}
+	}
 }
 
@@ -31,6 +31,28 @@
 
 class CCvcDb;
 
+class CPendingInstance {
+public:
+	instanceId_t	instanceId;
+	instanceId_t	parentId;
+	bool	isParallel;
+};
+
+class CPendingInstanceVector : public vector<CPendingInstance> {
+};
+
+class CNetIdSpan {
+	// Slice of the flat net id pool in CInstanceVector
+public:
+	netId_t *	netId_p = NULL;
+	netId_t	count = 0;
+
+	netId_t & operator[](netId_t theIndex) { return netId_p[theIndex]; };
+	netId_t size() { return count; };
+	netId_t * begin() { return netId_p; };
+	netId_t * end() { return netId_p + count; };
+};
+
 class CInstance {
 public:
 	deviceId_t	firstDeviceId = 0;
@@ -41,29 +63,35 @@ public:
 		instanceId_t  parallelInstanceId;  // for parallel instances deleted
 	};
 
-	CNetIdVector	localToGlobalNetId_v;
+	CNetIdSpan	localToGlobalNetId_v;
 
-	/* The CInstance structure also doubles as a hash.
-	   Each master has a vector of instances.
-	*/
-	instanceId_t	nextHashedInstanceId = UNKNOWN_DEVICE;
- 
 	instanceId_t	parentId = 0;
 	CCircuit * master_p = NULL;
 	bool	isMasked = false;
 
 	void AssignTopGlobalIDs(CCvcDb * theCvcDb_p, CCircuit * theMaster_p);
-	void AssignGlobalIDs(CCvcDb * theCvcDb_p, const instanceId_t theInstanceId, CDevice * theSubcircuit_p, const instanceId_t theParentId,
-		CInstance * theParent_p, bool isParallel);
+	void PushSubcircuits(CPendingInstanceVector & thePendingInstance_v, const instanceId_t theInstanceId, bool isParallel);
+	bool AssignGlobalIDs(CCvcDb * theCvcDb_p, const instanceId_t theInstanceId, CDevice * theSubcircuit_p, const instanceId_t theParentId,
+		CInstance * theParent_p, bool isParallel, CNetIdVector & thePortNetId_v);
+	void AssignLocalIDs(CCvcDb * theCvcDb_p, const instanceId_t theInstanceId);
 	bool IsParallelInstance() { return (localToGlobalNetId_v.size() == 0); };
 
 	void Print(const instanceId_t theInstanceId, const string theIndentation = "");
 };
 
-class CInstancePtrVector : public vector<CInstance *> {
+class CInstanceVector {
+	// Instances are stored contiguously and their net maps share one pool.
+	// Indexing returns a pointer, so callers use the same CInstance * interface as a pointer vector.
 public:
-	~CInstancePtrVector();
+	vector<CInstance>	instance_v;
+	CNetIdVector	netIdPool_v;
+
+	CInstance * operator[](instanceId_t theInstanceId) { return &instance_v[theInstanceId]; };
+	size_t size() { return instance_v.size(); };
 	void Clear();
+	void Reset(instanceId_t theInstanceCount, size_t theNetIdCount);
+	CNetIdSpan AllocateNetIds(netId_t theCount);
+	void ShrinkNetIds();
 };
 
 #endif /* CINSTANCE_HH_ */
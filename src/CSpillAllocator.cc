@@ -0,0 +1,124 @@
+/*
+ * CSpillAllocator.cc
+ *
+ * Copyright 2014-2026 D. Mitch Bailey  cvc at shuharisystem dot com
+ *
+ * This file is part of cvc.
+ *
+ * cvc is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cvc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with cvc.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * You can download cvc from https://github.com/d-m-bailey/cvc.git
+ */
+
+#include "CSpillAllocator.hh"
+
+#include "Cvc.hh"
+
+#include <mutex>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static string gSpillDirectory = "";
+static spillAdvice_t gSpillAdvice = SPILL_NORMAL;
+static unordered_map<void *, size_t> gSpillRegionMap;  // file backed address -> size
+static size_t gSpillSize = 0;
+static size_t gSpillPeakSize = 0;
+static mutex gSpillMutex;
+
+static int SpillAdviceFlag(spillAdvice_t theAdvice) {
+	switch ( theAdvice ) {
+		case SPILL_SEQUENTIAL: return MADV_SEQUENTIAL;
+		case SPILL_RANDOM: return MADV_RANDOM;
+		default: return MADV_NORMAL;
+	}
+}
+
+void SetSpillDirectory(const string & theDirectory) {
+	// Empty directory disables spilling. Regions already mapped stay mapped until freed.
+	if ( ! theDirectory.empty() ) {
+		struct stat myStat;
+		if ( stat(theDirectory.c_str(), &myStat) != 0 || ! S_ISDIR(myStat.st_mode) || access(theDirectory.c_str(), W_OK) != 0 ) {
+			throw EFatalError("Invalid scratch directory " + theDirectory);
+		}
+	}
+	lock_guard<mutex> myLock(gSpillMutex);
+	gSpillDirectory = theDirectory;
+	gSpillPeakSize = gSpillSize;
+}
+
+static int CreateScratchFile() {
+	// Caller holds gSpillMutex. The file is unlinked, so space is released when the descriptor and any mappings are closed.
+	string myFileName = gSpillDirectory + "/cvcspillXXXXXX";
+	int myFd = mkstemp(&myFileName[0]);
+	if ( myFd < 0 ) throw EFatalError("Could not create scratch file in " + gSpillDirectory);
+	unlink(myFileName.c_str());
+	return myFd;
+}
+
+void * SpillAllocate(size_t theSize) {
+	if ( theSize < SPILL_MINIMUM_BYTES ) return ::operator new(theSize);
+	lock_guard<mutex> myLock(gSpillMutex);
+	if ( gSpillDirectory.empty() ) return ::operator new(theSize);
+	int myFd = CreateScratchFile();
+	void * myAddress_p = MAP_FAILED;
+	if ( ftruncate(myFd, theSize) == 0 ) {
+		myAddress_p = mmap(NULL, theSize, PROT_READ | PROT_WRITE, MAP_SHARED, myFd, 0);
+	}
+	close(myFd);
+	if ( myAddress_p == MAP_FAILED ) throw EFatalError("Could not map " + to_string(theSize) + " bytes in " + gSpillDirectory);
+	madvise(myAddress_p, theSize, SpillAdviceFlag(gSpillAdvice));
+	gSpillRegionMap[myAddress_p] = theSize;
+	gSpillSize += theSize;
+	gSpillPeakSize = max(gSpillPeakSize, gSpillSize);
+	return myAddress_p;
+}
+
+void SpillDeallocate(void * theAddress_p, size_t theSize) {
+	if ( theSize >= SPILL_MINIMUM_BYTES ) {
+		lock_guard<mutex> myLock(gSpillMutex);
+		auto myRegion_pit = gSpillRegionMap.find(theAddress_p);
+		if ( myRegion_pit != gSpillRegionMap.end() ) {
+			munmap(theAddress_p, myRegion_pit->second);
+			gSpillSize -= myRegion_pit->second;
+			gSpillRegionMap.erase(myRegion_pit);
+			return;
+		}
+	}
+	::operator delete(theAddress_p);
+}
+
+void AdviseSpill(spillAdvice_t theAdvice) {
+	// Access pattern hint for the current stage. Applies to existing regions and to regions mapped later.
+	lock_guard<mutex> myLock(gSpillMutex);
+	gSpillAdvice = theAdvice;
+	for ( auto region_pit = gSpillRegionMap.begin(); region_pit != gSpillRegionMap.end(); region_pit++ ) {
+		madvise(region_pit->first, region_pit->second, SpillAdviceFlag(theAdvice));
+	}
+}
+
+FILE * OpenSpillFile() {
+	// Anonymous read/write file in the scratch directory, or the system temporary directory if there is none.
+	lock_guard<mutex> myLock(gSpillMutex);
+	if ( gSpillDirectory.empty() ) return tmpfile();
+	int myFd = CreateScratchFile();
+	FILE * myFile_p = fdopen(myFd, "w+");
+	if ( ! myFile_p ) close(myFd);
+	return myFile_p;
+}
+
+size_t SpillPeakSize() {
+	lock_guard<mutex> myLock(gSpillMutex);
+	return gSpillPeakSize;
+}
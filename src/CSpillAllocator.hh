@@ -0,0 +1,63 @@
+/*
+ * CSpillAllocator.hh
+ *
+ * Copyright 2014-2026 D. Mitch Bailey  cvc at shuharisystem dot com
+ *
+ * This file is part of cvc.
+ *
+ * cvc is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cvc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with cvc.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * You can download cvc from https://github.com/d-m-bailey/cvc.git
+ */
+
+#ifndef CSPILLALLOCATOR_HH_
+#define CSPILLALLOCATOR_HH_
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+
+// When a scratch directory is set, allocations of at least SPILL_MINIMUM_BYTES are mapped from unlinked files
+// in that directory so the kernel can page them out. Other allocations use the heap.
+#define SPILL_MINIMUM_BYTES	(size_t(64) << 20)
+
+enum spillAdvice_t {SPILL_NORMAL = 0, SPILL_SEQUENTIAL, SPILL_RANDOM};
+
+void SetSpillDirectory(const std::string & theDirectory);
+void * SpillAllocate(size_t theSize);
+void SpillDeallocate(void * theAddress_p, size_t theSize);
+void AdviseSpill(spillAdvice_t theAdvice);
+FILE * OpenSpillFile();
+size_t SpillPeakSize();
+
+template <class T>
+class CSpillAllocator {
+	// Stateless allocator for large per-net and per-device vectors
+public:
+	typedef T value_type;
+	template <class U> struct rebind { typedef CSpillAllocator<U> other; };
+
+	CSpillAllocator() {};
+	template <class U> CSpillAllocator(const CSpillAllocator<U> &) {};
+
+	T * allocate(size_t theCount) { return static_cast<T *>(SpillAllocate(theCount * sizeof(T))); };
+	void deallocate(T * theAddress_p, size_t theCount) { SpillDeallocate(theAddress_p, theCount * sizeof(T)); };
+};
+
+template <class T, class U>
+bool operator== (const CSpillAllocator<T> &, const CSpillAllocator<U> &) { return true; }
+template <class T, class U>
+bool operator!= (const CSpillAllocator<T> &, const CSpillAllocator<U> &) { return false; }
+
+#endif /* CSPILLALLOCATOR_HH_ */
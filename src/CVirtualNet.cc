@@ -22,9 +22,6 @@
  */
 
 #include "CVirtualNet.hh"
-#include "mmappable_vector.h"
-
-using namespace mmap_allocator_namespace;
 
 extern long gVirtualNetUpdateCount;
 extern long gVirtualNetAccessCount;
@@ -35,7 +32,11 @@ void CVirtualNet::operator= (CVirtualNet& theEqualNet) {
 	resistance = theEqualNet.resistance;
 	finalNetId = theEqualNet.finalNetId;
 	finalResistance = theEqualNet.finalResistance;
-	backupNetId = theEqualNet.backupNetId;
+}
+
+void CVirtualNet::operator= (CBaseVirtualNet& theLink) {
+	nextNetId = theLink.nextNetId;
+	resistance = theLink.resistance;
 }
 
 CVirtualNet& CVirtualNet::operator() (CVirtualNetVector& theVirtualNet_v, netId_t theNetId) {
@@ -49,82 +50,130 @@ CVirtualNet& CVirtualNet::operator() (CVirtualNetVector& theVirtualNet_v, netId_
 		if ( theVirtualNet_v.lastUpdate_v.size() > 0
 				&& theVirtualNet_v.lastUpdate_v[theNetId] < theVirtualNet_v.lastUpdate ) {
 			gVirtualNetUpdateCount++;
-			int myLinkCount = 0;
-			finalNetId = theNetId;
-			finalResistance = 0;
-			while ( finalNetId != theVirtualNet_v[finalNetId].nextNetId ) {
-				AddResistance(finalResistance, theVirtualNet_v[finalNetId].resistance);
-				finalNetId = theVirtualNet_v[finalNetId].nextNetId;
-				myLinkCount++;
-				if ( myLinkCount > 5000 ) {
-					cout << "looping at net " << finalNetId << endl;
-					assert ( myLinkCount < 5021 );
-				}
-			}
-			AddResistance(finalResistance, theVirtualNet_v[finalNetId].resistance);
-			theVirtualNet_v[theNetId].finalNetId = finalNetId;
-			theVirtualNet_v[theNetId].finalResistance = finalResistance;
+			theVirtualNet_v.FindRoute(theNetId, finalNetId, finalResistance);
+			theVirtualNet_v.SetFinal(theNetId, finalNetId, finalResistance);
 			theVirtualNet_v.lastUpdate_v[theNetId] = theVirtualNet_v.lastUpdate;
 		} else {
-			finalNetId = theVirtualNet_v[theNetId].finalNetId;
-			finalResistance = theVirtualNet_v[theNetId].finalResistance;
+			finalNetId = theVirtualNet_v.FinalNetId(theNetId);
+			finalResistance = theVirtualNet_v.FinalResistance(theNetId);
 		}
 		assert(finalResistance < MAX_RESISTANCE);
 	}
 	return (*this);
 }
 
-CVirtualNetMappedVector::CVirtualNetMappedVector(mmap_allocator<CVirtualNet> theAllocator) :
-	mmappable_vector(theAllocator) {
+CVirtualNet& CVirtualNet::operator() (CVirtualNetVector& theVirtualNet_v, netId_t theNetId, long & theAccessCount) {
+	// Same as above for vectors without pending updates, using the caller's count. Safe on multiple threads.
+	assert(theVirtualNet_v.lastUpdate_v.empty());
+	if ( theNetId == UNKNOWN_NET ) {
+		nextNetId = finalNetId = UNKNOWN_NET;
+		resistance = finalResistance = INFINITE_RESISTANCE;
+	} else {
+		theAccessCount++;
+		nextNetId = theVirtualNet_v[theNetId].nextNetId;
+		resistance = theVirtualNet_v[theNetId].resistance;
+		finalNetId = theVirtualNet_v.FinalNetId(theNetId);
+		finalResistance = theVirtualNet_v.FinalResistance(theNetId);
+	}
+	return (*this);
 }
 
-void CVirtualNetMappedVector::operator= (CVirtualNetVector& theSourceVector) {
-	mmap_file(theSourceVector.size());
-	assign(theSourceVector.begin(), theSourceVector.end());
-	remmap_file_for_read();
+void CVirtualNetVector::FindRoute(netId_t theNetId, netId_t & theFinalNetId, resistance_t & theFinalResistance) {
+	// Walk to the terminal net or the first net with a current route, then memoize the route for every net on the path.
+	// Resistances saturate at MAX_RESISTANCE, so summing from the end gives the same result as summing from the start.
+	// A memoized route stays valid until a link on it changes. Set bumps the epoch of the old final net,
+	// which is the final net of every route through the changed link, so other routes are kept.
+	routePath_v.clear();
+	netId_t myNetId = theNetId;
+	if ( myNetId != (*this)[myNetId].nextNetId && routeEpoch_v.empty() ) {
+		assert( ! finalNetId_v.empty() );
+		routeEpoch_v.resize(size(), 0);
+	}
+	while ( myNetId != (*this)[myNetId].nextNetId && ! IsRouteValid(myNetId) ) {
+		assert ((*this)[myNetId].resistance >= 0);
+		routePath_v.push_back(myNetId);
+		myNetId = (*this)[myNetId].nextNetId;
+		if ( routePath_v.size() > 5000 ) {
+			cout << "looping at net " << myNetId << endl;
+			assert ( routePath_v.size() < 5021 );
+		}
+	}
+	if ( myNetId == (*this)[myNetId].nextNetId ) { // terminal. routeEpoch_v holds the root epoch, so it is not memoized.
+		assert ((*this)[myNetId].resistance >= 0);
+		theFinalNetId = myNetId;
+		theFinalResistance = 0;
+		AddResistance(theFinalResistance, (*this)[myNetId].resistance);
+	} else {
+		theFinalNetId = finalNetId_v[myNetId];
+		theFinalResistance = finalResistance_v[myNetId];
+	}
+	for ( auto net_pit = routePath_v.rbegin(); net_pit != routePath_v.rend(); net_pit++ ) {
+		AddResistance(theFinalResistance, (*this)[*net_pit].resistance);
+		SetFinal(*net_pit, theFinalNetId, theFinalResistance);
+		routeEpoch_v[*net_pit] = routeEpoch;
+	}
 }
 
 void CVirtualNetVector::Set(netId_t theNetId, netId_t theNextNet, resistance_t theResistance, eventKey_t theTime) {
+	if ( (*this)[theNetId].nextNetId != UNKNOWN_NET
+			&& ! ( (*this)[theNextNet].nextNetId == theNetId && theNextNet != theNetId ) ) {  // routes through this net end at its current final net
+		netId_t myFinalNetId;
+		resistance_t myFinalResistance;
+		FindRoute(theNetId, myFinalNetId, myFinalResistance);
+		InvalidateRoutesTo(myFinalNetId);
+	}
+	Relink(theNetId, theNextNet, theResistance, theTime);
+}
+
+void CVirtualNetVector::Relink(netId_t theNetId, netId_t theNextNet, resistance_t theResistance, eventKey_t theTime) {
+	// Same as Set without invalidating the routes through theNetId.
+	// Only for loops that rewrite many links and call InvalidateRoutes before and after, so that no walk follows half rewritten links.
 	if ( (*this)[theNextNet].nextNetId == theNetId && theNextNet != theNetId ) {
 		cout << "DEBUG: The next net of " << theNetId << " is already set to " << theNextNet << endl;
 		return;
 	}
-	(*this)[theNetId].nextNetId = theNextNet;
-	(*this)[theNetId].resistance = theResistance;
 	netId_t myFinalNetId;
 	resistance_t myFinalResistance;
+	if ( theNextNet != theNetId && theNextNet != UNKNOWN_NET ) {
+		AllocateFinalNets();
+	}
+	(*this)[theNetId].nextNetId = theNextNet;
+	(*this)[theNetId].resistance = theResistance;
 	if ( (*this)[theNetId].nextNetId == UNKNOWN_NET ) {
 		myFinalNetId = UNKNOWN_NET;
 		myFinalResistance = INFINITE_RESISTANCE;
 	} else {
-		int myLinkCount = 0;
-		myFinalNetId = theNetId;
-		myFinalResistance = 0;
-		while ( myFinalNetId != (*this)[myFinalNetId].nextNetId ) {
-			assert ((*this)[myFinalNetId].resistance >= 0);
-			AddResistance(myFinalResistance, (*this)[myFinalNetId].resistance);
-			myFinalNetId = (*this)[myFinalNetId].nextNetId;
-			myLinkCount++;
-			if ( myLinkCount > 5000 ) {
-				cout << "looping at net " << myFinalNetId << endl;
-				cout << "DEBUG: linking " << theNetId << " to " << theNextNet << endl;
-				assert ( myLinkCount < 5021 );
-			}
-		}
-		assert ((*this)[myFinalNetId].resistance >= 0);
-		AddResistance(myFinalResistance, (*this)[myFinalNetId].resistance);
+		FindRoute(theNetId, myFinalNetId, myFinalResistance);
+	}
+	if ( ! finalNetId_v.empty() ) {
+		SetFinal(theNetId, myFinalNetId, myFinalResistance);
 	}
-	(*this)[theNetId].finalNetId = myFinalNetId;
-	(*this)[theNetId].finalResistance = myFinalResistance;
 	lastUpdate = theTime;
-	(*this).lastUpdate_v[theNetId] = theTime;
+	if ( ! lastUpdate_v.empty() ) {
+		lastUpdate_v[theNetId] = theTime;
+	}
+}
+
+void CVirtualNetVector::Copy(netId_t theNetId, CVirtualNetVector& theSource_v) {
+	if ( ! theSource_v.finalNetId_v.empty() ) {
+		AllocateFinalNets();
+	}
+	(*this)[theNetId] = theSource_v[theNetId];
+	if ( ! finalNetId_v.empty() ) {
+		SetFinal(theNetId, theSource_v.FinalNetId(theNetId), theSource_v.FinalResistance(theNetId));
+	}
 }
 
-void CVirtualNet::Copy(const CVirtualNet& theBase) {
-	nextNetId = theBase.nextNetId;
-	resistance = theBase.resistance;
-	finalNetId = theBase.finalNetId;
-	finalResistance = theBase.finalResistance;
+void CVirtualNetVector::AllocateFinalNets() {
+	// Before the first link to another net, every final net is the net's own link.
+	if ( ! finalNetId_v.empty() || empty() ) return;
+	finalNetId_v.resize(size());
+	finalResistance_v.resize(size());
+	for ( netId_t net_it = 0; net_it < size(); net_it++ ) {
+		assert( (*this)[net_it].nextNetId == net_it || (*this)[net_it].nextNetId == UNKNOWN_NET );
+		finalNetId_v[net_it] = (*this)[net_it].nextNetId;
+		finalResistance_v[net_it] = LinkResistance(net_it);
+	}
 }
 
 void CVirtualNet::Print(ostream& theOutputFile) {
@@ -154,7 +203,8 @@ void CVirtualNetVector::DebugVirtualNet(netId_t theNetId, string theTitle, ostre
 }
 
 void CVirtualNetVector::BackupVirtualNets() {
-	for ( auto net_pit = begin(); net_pit != end(); net_pit++ ) {
-		net_pit->backupNetId = net_pit->nextNetId;
+	backupNetId_v.resize(size());
+	for ( netId_t net_it = 0; net_it < size(); net_it++ ) {
+		backupNetId_v[net_it] = (*this)[net_it].nextNetId;
 	}
 }
@@ -27,14 +27,12 @@
 #include "Cvc.hh"
 
 #include "CPower.hh"
-#include "mmappable_vector.h"
-
-using namespace mmap_allocator_namespace;
 
 class CVirtualNet;
 class CVirtualNetVector;
 
 class CBaseVirtualNet {
+	// 8 byte link stored per net. Final and backup values are kept in separate arrays in CVirtualNetVector.
 public:
 	netId_t	nextNetId = UNKNOWN_NET;
 	resistance_t resistance = 0;
@@ -42,46 +40,128 @@ public:
 	void operator= (CVirtualNet& theEqualNet);
 };
 
-class CVirtualNetMappedVector : public mmappable_vector<CVirtualNet> {
-public:
-	CVirtualNetMappedVector(mmap_allocator<CVirtualNet> theAllocator);
-	void operator= (CVirtualNetVector& theNetVector);
-};
+// file backed in scratch directory when large (see CSpillAllocator)
+typedef vector<CBaseVirtualNet, CSpillAllocator<CBaseVirtualNet>> CBaseVirtualNetVector;
 
 class CVirtualNet {
+	// resolved copy of one net
 public:
 	netId_t	nextNetId = UNKNOWN_NET;
 	resistance_t resistance = 0;
 	netId_t	finalNetId = UNKNOWN_NET;
 	resistance_t finalResistance = 0;
-	netId_t	backupNetId = UNKNOWN_NET;
 
 	void operator= (CVirtualNet& theEqualNet);
+	void operator= (CBaseVirtualNet& theLink);
 	inline bool operator== (CVirtualNet& theTestNet) { return (nextNetId == theTestNet.nextNetId && resistance == theTestNet.resistance); };
 	CVirtualNet& operator() (CVirtualNetVector& theVirtualNet_v, netId_t theNetId);
-	void Copy(const CVirtualNet& theBase);
+	CVirtualNet& operator() (CVirtualNetVector& theVirtualNet_v, netId_t theNetId, long & theAccessCount);
 	void Print(ostream& theOutputFile);
 };
 
-class CVirtualNetVector : public vector<CVirtualNet> {
+class CVirtualNetVector : public CBaseVirtualNetVector {
 public:
 	eventKey_t lastUpdate;
-	vector<eventKey_t> lastUpdate_v;
+	vector<eventKey_t, CSpillAllocator<eventKey_t>> lastUpdate_v;
 	powerType_t calculatedBit;
+	// final net and resistance as of lastUpdate_v, or as memoized by FindRoute.
+	// empty until the first link to another net. until then, the final net of each net is its own link.
+	CNetIdVector finalNetId_v;
+	vector<resistance_t, CSpillAllocator<resistance_t>> finalResistance_v;
+	// non-terminal nets: epoch when FindRoute memoized the final net and resistance.
+	// terminal nets: epoch of the last link change on any route ending at this net.
+	// only allocated while routes are walked. released with the update array.
+	vector<uint32_t, CSpillAllocator<uint32_t>> routeEpoch_v;
+	uint32_t routeEpoch = 1;  // latest epoch
+	uint32_t validEpoch = 1;  // routes memoized before this epoch are stale
+	CNetIdVector routePath_v;
+	CNetIdVector backupNetId_v;  // only allocated by BackupVirtualNets
 
 	CVirtualNetVector(powerType_t theCalculatedBit) : calculatedBit(theCalculatedBit) {};
 
-	inline void resize (size_type n) { vector<CVirtualNet>::resize(n); lastUpdate_v.resize(n, 0); };
-	inline void reserve (size_type n) { vector<CVirtualNet>::reserve(n); lastUpdate_v.reserve(n); };
-	inline void shrink_to_fit() { vector<CVirtualNet>::shrink_to_fit(); lastUpdate_v.shrink_to_fit(); };
+	inline void resize (size_type n) {
+		// only the links are always allocated
+		CBaseVirtualNetVector::resize(n);
+		if ( ! finalNetId_v.empty() ) {
+			finalNetId_v.resize(n, UNKNOWN_NET);
+			finalResistance_v.resize(n, INFINITE_RESISTANCE);
+		}
+		if ( ! lastUpdate_v.empty() ) lastUpdate_v.resize(n, 0);
+		if ( ! routeEpoch_v.empty() ) routeEpoch_v.resize(n, 0);
+		InvalidateRoutes();
+	};
+	inline void reserve (size_type n) { CBaseVirtualNetVector::reserve(n); };
+	inline void shrink_to_fit() {
+		CBaseVirtualNetVector::shrink_to_fit();
+		finalNetId_v.shrink_to_fit();
+		finalResistance_v.shrink_to_fit();
+		lastUpdate_v.shrink_to_fit();
+		routeEpoch_v.shrink_to_fit();
+	};
+	inline void clear() {
+		CBaseVirtualNetVector::clear();
+		CNetIdVector().swap(finalNetId_v);
+		vector<resistance_t, CSpillAllocator<resistance_t>>().swap(finalResistance_v);
+		CNetIdVector().swap(backupNetId_v);
+		vector<eventKey_t, CSpillAllocator<eventKey_t>>().swap(lastUpdate_v);
+		vector<uint32_t, CSpillAllocator<uint32_t>>().swap(routeEpoch_v);
+	};
+	inline netId_t FinalNetId(netId_t theNetId) {
+		return ( finalNetId_v.empty() ) ? (*this)[theNetId].nextNetId : finalNetId_v[theNetId];
+	};
+	inline resistance_t FinalResistance(netId_t theNetId) {
+		return ( finalNetId_v.empty() ) ? LinkResistance(theNetId) : finalResistance_v[theNetId];
+	};
+	inline void SetFinalNetId(netId_t theNetId, netId_t theFinalNetId) { AllocateFinalNets(); finalNetId_v[theNetId] = theFinalNetId; };
+	inline void SetFinal(netId_t theNetId, netId_t theFinalNetId, resistance_t theFinalResistance) {
+		finalNetId_v[theNetId] = theFinalNetId;
+		finalResistance_v[theNetId] = theFinalResistance;
+	};
+	void AllocateFinalNets();
+	inline netId_t BackupNetId(netId_t theNetId) { return ( backupNetId_v.empty() ) ? UNKNOWN_NET : backupNetId_v[theNetId]; };
+	void Copy(netId_t theNetId, CVirtualNetVector& theSource_v);
+	inline uint32_t NextRouteEpoch() {
+		if ( ++routeEpoch == 0 ) {
+			routeEpoch_v.assign(routeEpoch_v.size(), 0);
+			routeEpoch = validEpoch = 1;
+		}
+		return routeEpoch;
+	};
+	// must be called after any change to nextNetId or resistance that does not use Set,
+	// and after direct changes to FinalNetId, FinalResistance or Copy
+	inline void InvalidateRoutes() { validEpoch = NextRouteEpoch(); };
+	// invalidates only the routes that end at theFinalNetId
+	inline void InvalidateRoutesTo(netId_t theFinalNetId) {
+		if ( routeEpoch_v.empty() ) return;  // nothing memoized
+		routeEpoch_v[theFinalNetId] = NextRouteEpoch();
+	};
+	// only for non-terminal nets. a final net equal to the net itself is left over from when the net was terminal.
+	inline bool IsRouteValid(netId_t theNetId) {
+		return ( routeEpoch_v[theNetId] >= validEpoch && finalNetId_v[theNetId] != theNetId
+				&& routeEpoch_v[theNetId] >= routeEpoch_v[finalNetId_v[theNetId]] );
+	};
+	void FindRoute(netId_t theNetId, netId_t & theFinalNetId, resistance_t & theFinalResistance);
 	inline bool IsTerminal(netId_t theNetId) {	return ( theNetId == (*this)[theNetId].nextNetId ); }
 	void Print(string theTitle = "", string theIndentation = "");
 	void Print(CNetIdVector& theEquivalentNet_v, string theTitle = "", string theIndentation = "");
 	void Set(netId_t theNetId, netId_t theNextNet, resistance_t theResistance, eventKey_t theTime);
+	void Relink(netId_t theNetId, netId_t theNextNet, resistance_t theResistance, eventKey_t theTime);
 	void DebugVirtualNet(netId_t theNetId, string theTitle = "", ostream& theOutputFile = cout);
 	void BackupVirtualNets();
-	inline void InitializeUpdateArray() { lastUpdate_v.resize(size(), 0); };
-	inline void ClearUpdateArray() { lastUpdate_v.clear(); };
+	inline void InitializeUpdateArray() { AllocateFinalNets(); lastUpdate_v.resize(size(), 0); };
+	// after propagation, only the links and final nets are used
+	inline void ClearUpdateArray() {
+		vector<eventKey_t, CSpillAllocator<eventKey_t>>().swap(lastUpdate_v);
+		vector<uint32_t, CSpillAllocator<uint32_t>>().swap(routeEpoch_v);
+	};
+private:
+	// final resistance of a net that links to itself or to UNKNOWN_NET
+	inline resistance_t LinkResistance(netId_t theNetId) {
+		if ( (*this)[theNetId].nextNetId == UNKNOWN_NET ) return INFINITE_RESISTANCE;
+		resistance_t myResistance = 0;
+		AddResistance(myResistance, (*this)[theNetId].resistance);
+		return myResistance;
+	};
 
 };
 
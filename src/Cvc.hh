@@ -73,6 +73,7 @@ typedef char * text_t;
 
 #include "utility.h"
 #include "CvcMaps.hh"
+#include "CSpillAllocator.hh"
 #include "CCvcExceptions.hh"
 // #include "SFHash.hh"
 
@@ -167,20 +168,15 @@ public:
 	CTextInstanceIdMap(float theLoadFactor = DEFAULT_LOAD_FACTOR) {max_load_factor(theLoadFactor);}
 };
 
-class CStringTextMap : public unordered_map<string, text_t> {
+class CNetIdVector : public vector<netId_t, CSpillAllocator<netId_t>> {
 public:
-	CStringTextMap(float theLoadFactor = DEFAULT_LOAD_FACTOR) {max_load_factor(theLoadFactor);}
 };
 
-class CNetIdVector : public vector<netId_t> {
+class CDeviceIdVector : public vector<deviceId_t, CSpillAllocator<deviceId_t>> {
 public:
 };
 
-class CDeviceIdVector : public vector<deviceId_t> {
-public:
-};
-
-class CInstanceIdVector : public vector<instanceId_t> {
+class CInstanceIdVector : public vector<instanceId_t, CSpillAllocator<instanceId_t>> {
 public:
 };
 
@@ -191,7 +187,7 @@ public:
 typedef bitset<8> CStatus;
 extern CStatus PMOS_ONLY, NMOS_ONLY, NMOS_PMOS, NO_TYPE; //, MIN_CHECK_BITS, MAX_CHECK_BITS;
 
-class CStatusVector : public vector<CStatus> {
+class CStatusVector : public vector<CStatus, CSpillAllocator<CStatus>> {
 public:
 };
 
@@ -143,6 +143,9 @@ enum propagation_t { POWER_NETS_ONLY = 1, ALL_NETS_NO_FUSE, ALL_NETS_AND_FUSE };
 enum cvcError_t { LEAK = 0, HIZ_INPUT, FORWARD_DIODE, NMOS_SOURCE_BULK, NMOS_GATE_SOURCE, NMOS_POSSIBLE_LEAK,
 	PMOS_SOURCE_BULK, PMOS_GATE_SOURCE, PMOS_POSSIBLE_LEAK, OVERVOLTAGE_VBG, OVERVOLTAGE_VBS, OVERVOLTAGE_VDS,
 	OVERVOLTAGE_VGS, MODEL_CHECK, EXPECTED_VOLTAGE, LDD_SOURCE, MIN_VOLTAGE_CONFLICT, MAX_VOLTAGE_CONFLICT, FUSE_ERROR, ERROR_TYPE_COUNT };
+
+// device check results from ScanDeviceErrors
+enum deviceCheck_t { CHECK_ERROR = 1, CHECK_UNRELATED = 2, CHECK_VTH = 4, CHECK_SOURCE = 8, CHECK_DRAIN = 16, CHECK_EXPECT_LOW = 32, CHECK_LOG = 64 };
 // Flag Constants
 
 #define PRINT_CIRCUIT_ON	true
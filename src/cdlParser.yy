@@ -136,7 +136,7 @@ circuit:
 		$circuit->AddPortSignalIds($interface);
 		delete $interface;
 //		$circuit->devices = $deviceList;
-		$circuit->LoadDevices($deviceList);
+		$circuit->LoadDevices($deviceList, cdlCircuitList.loadProgress);
 //		delete $deviceList;
 //		for (CDeviceList::iterator current = $circuit->devices->begin(); current != $circuit->devices->end(); current++ ) {
 //			current->signalIndexVector = $circuit->SetSignalIndexes(current->signals);
@@ -81,7 +81,7 @@ TEXT			[[:alnum:][:punct:]]
 
 <INITIAL>^[Xx]{TEXT}* { 
 		BEGIN(READING);
-		yylval->charPtr = cdlCircuitList.cdlText.SetTextAddress(yytext);
+		yylval->charPtr = cdlCircuitList.cdlText.SetTextAddress(yytext, yyleng);
 #ifdef CDL_FLEX_DEBUG
 		cout << "FLEX DEBUG: found subcircuit " << yylval->charPtr << "\n" << endl;
 #endif
@@ -90,7 +90,7 @@ TEXT			[[:alnum:][:punct:]]
 
 <INITIAL>^[Mm]{TEXT}* { 
 		BEGIN(READING);
-		yylval->charPtr = cdlCircuitList.cdlText.SetTextAddress(yytext);
+		yylval->charPtr = cdlCircuitList.cdlText.SetTextAddress(yytext, yyleng);
 #ifdef CDL_FLEX_DEBUG
 		cout << "FLEX DEBUG: found mosfet " << *(yylval->charPtr) << "\n" << endl;
 #endif
@@ -99,7 +99,7 @@ TEXT			[[:alnum:][:punct:]]
 
 <INITIAL>^[Dd]{TEXT}* { 
 		BEGIN(READING);
-		yylval->charPtr = cdlCircuitList.cdlText.SetTextAddress(yytext);
+		yylval->charPtr = cdlCircuitList.cdlText.SetTextAddress(yytext, yyleng);
 #ifdef CDL_FLEX_DEBUG
 		cout << "FLEX DEBUG: found diode " << *(yylval->charPtr) << "\n" << endl;
 #endif
@@ -108,7 +108,7 @@ TEXT			[[:alnum:][:punct:]]
 
 <INITIAL>^[Cc]{TEXT}* { 
 		BEGIN(READING);
-		yylval->charPtr = cdlCircuitList.cdlText.SetTextAddress(yytext);
+		yylval->charPtr = cdlCircuitList.cdlText.SetTextAddress(yytext, yyleng);
 #ifdef CDL_FLEX_DEBUG
 		cout << "FLEX DEBUG: found capacitor " << *(yylval->charPtr) << "\n" << endl;
 #endif
@@ -117,7 +117,7 @@ TEXT			[[:alnum:][:punct:]]
 
 <INITIAL>^[Rr]{TEXT}* { 
 		BEGIN(READING);
-		yylval->charPtr = cdlCircuitList.cdlText.SetTextAddress(yytext);
+		yylval->charPtr = cdlCircuitList.cdlText.SetTextAddress(yytext, yyleng);
 #ifdef CDL_FLEX_DEBUG
 		cout << "FLEX DEBUG: found resistor " << *(yylval->charPtr) << "\n" << endl;
 #endif
@@ -126,7 +126,7 @@ TEXT			[[:alnum:][:punct:]]
 
 <INITIAL>^[Qq]{TEXT}* { 
 		BEGIN(READING);
-		yylval->charPtr = cdlCircuitList.cdlText.SetTextAddress(yytext);
+		yylval->charPtr = cdlCircuitList.cdlText.SetTextAddress(yytext, yyleng);
 #ifdef CDL_FLEX_DEBUG
 		cout << "FLEX DEBUG: found bipolar " << *(yylval->charPtr) << "\n" << endl;
 #endif
@@ -135,7 +135,7 @@ TEXT			[[:alnum:][:punct:]]
 
 <INITIAL>^[Ll]{TEXT}*	{ 
 		BEGIN(READING);
-		yylval->charPtr = cdlCircuitList.cdlText.SetTextAddress(yytext);
+		yylval->charPtr = cdlCircuitList.cdlText.SetTextAddress(yytext, yyleng);
 #ifdef CDL_FLEX_DEBUG
 		cout << "FLEX DEBUG: found inductor " << *(yylval->charPtr) << "\n" << endl;
 #endif
@@ -176,7 +176,7 @@ TEXT			[[:alnum:][:punct:]]
 	};
 
 <READING>{TEXT}+	{
-		yylval->charPtr = cdlCircuitList.cdlText.SetTextAddress(yytext);
+		yylval->charPtr = cdlCircuitList.cdlText.SetTextAddress(yytext, yyleng);
 #ifdef CDL_FLEX_DEBUG
 		cout << "FLEX DEBUG: found string " << yytext << "\n" << endl;
 #endif
@@ -64,10 +64,13 @@ CCvcDb	* gCvcDb; //!< CVC global database
 /**
  * usage:
  * cvc [-v|`--version`] [-i|`--interactive`] [-p|`--prefix` <I>prefix</I>]
+ * [`--checkpoint` <I>stage</I>] [`--resume-from` <I>stage</I>]
  * <I>mode1.cvcrc</I> [<I>mode2.cvcrc</I> ...]\n
  * -v : print cvc program version\n
  * -p "prefix" : add "prefix-" to all file names\n 
  * -i : interactive mode\n
+ * --checkpoint "stage" : save the database after stage 2-6 to "report".stage"stage".checkpoint\n
+ * --resume-from "stage" : restore the database saved after stage 2-6 and continue with the next stage\n
  * <mode1.cvcrc> [<mode2.cvcrc>] ... : list of verification setting files.
  */
 int main(int argc, const char * argv[]) {
@@ -89,12 +92,12 @@ try {
 }
 catch (EFatalError& e) {
 	// Handle known errors.
-	gCvcDb->RemoveLock();
+	if ( gCvcDb ) gCvcDb->RemoveLock();  // NULL if command line options fail
 	cout << e.what() << endl;
 }
 catch (exception& e) {
 	// Handle unknown errors.
-	gCvcDb->RemoveLock();
+	if ( gCvcDb ) gCvcDb->RemoveLock();
 	cout << "unexpected error: " << e.what() << endl;
 }
 	delete gCvcDb;
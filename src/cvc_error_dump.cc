@@ -0,0 +1,140 @@
+/*
+ * cvc_error_dump.cc
+ *
+ * Copyright 2014-2026 D. Mitch Bailey  cvc at shuharisystem dot com
+ *
+ * This file is part of cvc.
+ *
+ * cvc is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cvc is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with cvc.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * You can download cvc from https://github.com/d-m-bailey/cvc.git
+ */
+
+/// \file
+/// Print the records in a CVC error database (<report>.error.db)
+
+#include "Cvc.hh"
+#include "CErrorDatabase.hh"
+
+string EFatalError::displayMessage = "";
+
+// same order as cvcError_t
+static const char * gErrorTypeName[] = { "LEAK", "HIZ_INPUT", "FORWARD_DIODE", "NMOS_SOURCE_BULK", "NMOS_GATE_SOURCE", "NMOS_POSSIBLE_LEAK",
+	"PMOS_SOURCE_BULK", "PMOS_GATE_SOURCE", "PMOS_POSSIBLE_LEAK", "OVERVOLTAGE_VBG", "OVERVOLTAGE_VBS", "OVERVOLTAGE_VDS",
+	"OVERVOLTAGE_VGS", "MODEL_CHECK", "EXPECTED_VOLTAGE", "LDD_SOURCE", "MIN_VOLTAGE_CONFLICT", "MAX_VOLTAGE_CONFLICT", "FUSE_ERROR" };
+static_assert(sizeof(gErrorTypeName) / sizeof(gErrorTypeName[0]) == ERROR_TYPE_COUNT, "error type names do not match cvcError_t");
+
+static const char * gTerminalName[ERROR_TERMINAL_COUNT] = { "G", "S", "D", "B" };
+
+static string IdString(uint32_t theId) {
+	return ( theId == UINT32_MAX ) ? "-" : to_string(theId);
+}
+
+static string VoltageString(voltage_t theVoltage) {
+	return ( theVoltage == UNKNOWN_VOLTAGE ) ? "???" : to_string(theVoltage);
+}
+
+static void PrintRecord(CErrorDatabaseReader & theDatabase, uint64_t theRecordNumber, CErrorRecord & theRecord) {
+	cout << "#" << theRecordNumber << " " << gErrorTypeName[theRecord.errorIndex] << " device " << theRecord.deviceId << " "
+		<< theDatabase.Text(theRecord.instanceText) << "/" << theDatabase.Text(theRecord.deviceText)
+		<< "(" << theDatabase.Text(theRecord.circuitText) << ") " << theDatabase.Text(theRecord.parameterText);
+	if ( theRecord.mFactor > 1 ) cout << " {m=" << theRecord.mFactor << "}";
+	cout << endl;
+	for ( int terminal_it = 0; terminal_it < ERROR_TERMINAL_COUNT; terminal_it++ ) {
+		if ( theRecord.net[terminal_it] == UNKNOWN_NET ) continue;
+		cout << gTerminalName[terminal_it] << ": net " << theRecord.net[terminal_it]
+			<< " min " << IdString(theRecord.minNet[terminal_it]) << "@" << VoltageString(theRecord.minVoltage[terminal_it])
+			<< " power " << IdString(theRecord.minPower[terminal_it])
+			<< " sim " << IdString(theRecord.simNet[terminal_it]) << "@" << VoltageString(theRecord.simVoltage[terminal_it])
+			<< " power " << IdString(theRecord.simPower[terminal_it])
+			<< " max " << IdString(theRecord.maxNet[terminal_it]) << "@" << VoltageString(theRecord.maxVoltage[terminal_it])
+			<< " power " << IdString(theRecord.maxPower[terminal_it]) << endl;
+	}
+}
+
+/**
+ * usage:
+ * cvc_error_dump [-t <I>error_type</I>] [-c <I>circuit</I>] [-s] <I>report</I>.error.db\n
+ * -t "error_type" : only errors of this type (name from cvcError_t, e.g. FORWARD_DIODE)\n
+ * -c "circuit" : only errors in devices of this subcircuit\n
+ * -s : print the number of errors of each type instead of the records\n
+ */
+int main(int argc, const char * argv[]) {
+	int myErrorType = ERROR_TYPE_COUNT;  // all types
+	string myCircuit = "";
+	bool mySummary = false;
+	string myFileName = "";
+	for ( int arg_it = 1; arg_it < argc; arg_it++ ) {
+		string myArg = argv[arg_it];
+		if ( myArg == "-t" && arg_it + 1 < argc ) {
+			string myTypeName = argv[++arg_it];
+			for ( myErrorType = 0; myErrorType < ERROR_TYPE_COUNT; myErrorType++ ) {
+				if ( myTypeName == gErrorTypeName[myErrorType] ) break;
+			}
+			if ( myErrorType == ERROR_TYPE_COUNT ) {
+				cout << "unknown error type " << myTypeName << endl;
+				return 1;
+			}
+		} else if ( myArg == "-c" && arg_it + 1 < argc ) {
+			myCircuit = argv[++arg_it];
+		} else if ( myArg == "-s" ) {
+			mySummary = true;
+		} else if ( myFileName.empty() && myArg[0] != '-' ) {
+			myFileName = myArg;
+		} else {
+			myFileName = "";
+			break;
+		}
+	}
+	if ( myFileName.empty() ) {
+		cout << "usage: cvc_error_dump [-t error_type] [-c circuit] [-s] report.error.db" << endl;
+		return 1;
+	}
+try {
+	CErrorDatabaseReader myDatabase;
+	myDatabase.Open(myFileName);
+	CErrorRecord myRecord;
+	if ( mySummary ) {
+		for ( int type_it = 0; type_it < ERROR_TYPE_COUNT; type_it++ ) {
+			if ( myErrorType != ERROR_TYPE_COUNT && type_it != myErrorType ) continue;
+			size_t myCount = 0;
+			for ( auto record_pit = myDatabase.typeIndex_v[type_it].begin(); record_pit != myDatabase.typeIndex_v[type_it].end(); record_pit++ ) {
+				if ( ! myCircuit.empty() ) {
+					myDatabase.ReadRecord(*record_pit, myRecord);
+					if ( myDatabase.Text(myRecord.circuitText) != myCircuit ) continue;
+				}
+				myCount++;
+			}
+			cout << gErrorTypeName[type_it] << " " << myCount << endl;
+		}
+	} else if ( myErrorType != ERROR_TYPE_COUNT ) {  // seek to the records of one type
+		for ( auto record_pit = myDatabase.typeIndex_v[myErrorType].begin(); record_pit != myDatabase.typeIndex_v[myErrorType].end(); record_pit++ ) {
+			myDatabase.ReadRecord(*record_pit, myRecord);
+			if ( ! myCircuit.empty() && myDatabase.Text(myRecord.circuitText) != myCircuit ) continue;
+			PrintRecord(myDatabase, *record_pit, myRecord);
+		}
+	} else {
+		for ( uint64_t record_it = 0; record_it < myDatabase.recordCount; record_it++ ) {
+			myDatabase.ReadRecord(record_it, myRecord);
+			if ( ! myCircuit.empty() && myDatabase.Text(myRecord.circuitText) != myCircuit ) continue;
+			PrintRecord(myDatabase, record_it, myRecord);
+		}
+	}
+}
+catch (EFatalError& e) {
+	cout << e.what() << endl;
+	return 1;
+}
+	return 0;
+}
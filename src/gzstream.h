@@ -32,7 +32,13 @@
 // standard C++ with new header file names and std:: namespace
 #include <iostream>
 #include <fstream>
+#include <string>
+#include <vector>
+#include <cstdio>
 #include <zlib.h>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 #ifdef GZSTREAM_NAMESPACE
 namespace GZSTREAM_NAMESPACE {
@@ -47,14 +53,70 @@ private:
     static const int bufferSize = 47+256;    // size of data buff
     // totals 512 bytes under g++ for igzstream at the end.
 
-    gzFile           file;               // file handle for compressed file
+    gzFile           file;               // file handle for input without member lengths
+    FILE *           inFile;             // file handle for compressed input file
+    FILE *           outFile;            // file handle for compressed output file
     char             buffer[bufferSize]; // data buffer
     char             opened;             // open/close state of stream
     int              mode;               // I/O mode
 
-    int flush_buffer();
+    // Output is written into a ring of blocks. Each full block is deflated as an
+    // independent gzip member on one of threadCount background threads and the
+    // members are written to the file in order. Concatenated members are a valid
+    // gzip file. Memory is bounded by the ring size.
+    // Each member header has an extra subfield with the compressed member length,
+    // as in BGZF, so that readers can find the members without inflating them.
+    static const int writeBlockSize = 1024 * 1024;
+    static const int memberLengthOffset = 16; // length in the header: 10 fixed, 2 XLEN, 'C', 'V', 2 SLEN
+    static int       threadCount;        // compression and inflate threads for files opened later
+    enum { blockFree, blockFull, blockBusy, blockDone };
+
+    // Input is read ahead of the consumer on a background thread into a ring of
+    // blocks. Each block has a 4 byte putback area before the data. Members with
+    // a length subfield are read whole and inflated on threadCount threads in
+    // any order. Other input is inflated serially by gzread.
+    static const int readAheadCount = 4;  // minimum ring size
+    std::vector<char *>      readBlock;  // writeBlockSize, the largest member
+    std::vector<int>         readLength; // inflated size, -1 on error
+    std::vector<std::string> readMember; // compressed member
+    std::vector<int>         readState;
+    int              readHead;           // next block to fill
+    int              readTail;           // next block to consume
+    int              readFilled;         // blocks filled and not yet released
+    bool             readCurrent;        // consumer holds block readTail - 1
+    bool             readEnd;            // input reached end of file or error
+    bool             readStop;           // close requested
+    std::thread      reader;
+    std::vector<std::thread> inflaters;
+    std::mutex       readLock;
+    std::condition_variable readChanged;
+
+    std::vector<char *>      writeBlock;
+    std::vector<int>         writeLength;
+    std::vector<std::string> writeMember; // deflated block
+    std::vector<int>         writeState;
+    int              writeHead;          // block being filled
+    int              writeTail;          // next member to write
+    bool             writeError;         // deflate or write failed
+    bool             writeStop;          // close requested
+    std::vector<std::thread> writers;
+    std::mutex       writeLock;
+    std::condition_variable writeChanged;
+
+    void read_ahead();
+    void inflate_ahead();
+    void start_read_ahead();
+    void stop_read_ahead();
+    int read_member( std::string & member);
+    bool open_serial();
+    static int inflate_member( const std::string & member, char * data);
+    void write_behind();
+    void start_write_behind();
+    int queue_block();
+    int stop_write_behind();
+    static bool deflate_block( const char * data, int length, std::string & member);
 public:
-    gzstreambuf() : opened(0) {
+    gzstreambuf() : file(0), inFile(0), opened(0), readFilled(0), readCurrent(false), readEnd(false), readStop(false) {
         setp( buffer, buffer + (bufferSize-1));
         setg( buffer + 4,     // beginning of putback area
               buffer + 4,     // read position
@@ -64,7 +126,14 @@ public:
     int is_open() { return opened; }
     gzstreambuf* open( const char* name, int open_mode);
     gzstreambuf* close();
-    ~gzstreambuf() { close(); }
+    ~gzstreambuf() {
+        close();
+        for ( size_t i = 0; i < readBlock.size(); i++)
+            delete [] readBlock[i];
+        for ( size_t i = 0; i < writeBlock.size(); i++)
+            delete [] writeBlock[i];
+    }
+    static void set_threads( int count) { threadCount = ( count < 1) ? 1 : count; }
     
     virtual int     overflow( int c = EOF);
     virtual int     underflow();
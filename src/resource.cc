@@ -28,13 +28,13 @@ void TakeSnapshot(rusage * theSnapshot_p) {
 	getrusage(RUSAGE_SELF, theSnapshot_p);
 }
 
-char * PrintProgress(rusage * theLastSnapshot_p, string theHeading) {
+string PrintProgress(rusage * theLastSnapshot_p, string theHeading) {
 	rusage currentSnapshot;
-	static char myString[1024];
+	char myString[1024];
 
 	TakeSnapshot(&currentSnapshot);
 
-	sprintf(myString, "Usage %s: Time: %ld  Memory: %ld  I/O: %ld  Swap: %ld", theHeading.c_str(), currentSnapshot.ru_utime.tv_sec,
+	snprintf(myString, sizeof(myString), "Usage %s: Time: %ld  Memory: %ld  I/O: %ld  Swap: %ld", theHeading.c_str(), currentSnapshot.ru_utime.tv_sec,
 			currentSnapshot.ru_maxrss, currentSnapshot.ru_inblock + currentSnapshot.ru_oublock,
 			currentSnapshot.ru_nswap);
 
@@ -55,5 +55,5 @@ char * PrintProgress(rusage * theLastSnapshot_p, string theHeading) {
 	theLastSnapshot_p->ru_stime = currentSnapshot.ru_stime;
 	theLastSnapshot_p->ru_utime = currentSnapshot.ru_utime;
 
-	return(myString);
+	return(string(myString));
 }
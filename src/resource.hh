@@ -28,7 +28,7 @@
 
 void TakeSnapshot(rusage * theSnapshot_p);
 
-char * PrintProgress(rusage * theLastSnapshot_p, string theHeading = "");
+string PrintProgress(rusage * theLastSnapshot_p, string theHeading = "");
 
 
 #endif /* RESOURCE_H_ */
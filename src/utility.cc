@@ -28,6 +28,7 @@
 #include <locale.h>
 #include <stdio.h>
 #include <time.h>
+#include <sys/stat.h>
 
 void * xmalloc (size_t size) {
 	void *value = malloc (size);
@@ -246,3 +247,12 @@ bool IsAlphanumeric(std::string theString) {
 	}
 	return true;
 }
+
+/**
+ * \brief Returns file name, modified time and size, for detecting changed input files
+ */
+std::string FileIdentity(std::string theFilename) {
+	struct stat myStat;
+	if ( IsEmpty(theFilename) || stat(theFilename.c_str(), &myStat) != 0 ) return theFilename;
+	return theFilename + " " + std::to_string(int64_t(myStat.st_mtime)) + " " + std::to_string(int64_t(myStat.st_size));
+}
@@ -69,6 +69,7 @@ std::string RegexErrorString(std::regex_constants::error_type theErrorCode);
 
 std::string FuzzyFilter(std::string theFilter);
 bool IsAlphanumeric(std::string theString);
+std::string FileIdentity(std::string theFilename);
 inline bool IsEmpty(char * theText) {return (theText[0] == '\0' );};
 inline bool IsEmpty(std::string theString) {return (theString.empty());};
 